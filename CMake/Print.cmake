@@ -14,6 +14,7 @@ function(ttk_print_summary)
     message(STATUS "TTK_ENABLE_SQLITE3: ${TTK_ENABLE_SQLITE3}")
     message(STATUS "TTK_ENABLE_ZFP: ${TTK_ENABLE_ZFP}")
     message(STATUS "TTK_ENABLE_ZLIB: ${TTK_ENABLE_ZLIB}")
+    message(STATUS "TTK_ENABLE_ZSTD: ${TTK_ENABLE_ZSTD}")
     message(STATUS "ttk build -------------------------------------------------------------------")
     message(STATUS "CMAKE_BUILD_TYPE: ${CMAKE_BUILD_TYPE}")
     message(STATUS "TTK_BUILD_DOCUMENTATION: ${TTK_BUILD_DOCUMENTATION}")
@@ -122,6 +122,16 @@ else()
   option(TTK_ENABLE_ZLIB "Enable Zlib support" ON)
 endif()
 
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_LIBRARY NAMES zstd)
+mark_as_advanced(ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+if(ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+  option(TTK_ENABLE_ZSTD "Enable Zstandard support" ON)
+else()
+  option(TTK_ENABLE_ZSTD "Enable Zstandard support" OFF)
+  message(STATUS "Zstandard not found, disabling Zstandard support in TTK.")
+endif()
+
 # START_FIND_GRAPHVIZ
 find_path(GRAPHVIZ_INCLUDE_DIR
   NAMES
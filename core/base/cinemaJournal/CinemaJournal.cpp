@@ -0,0 +1,392 @@
+#include <CinemaJournal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+  // header last written in each journal, shared by all the CinemaJournal
+  // objects since the journals are per process
+  std::mutex journalHeadersMutex{};
+  std::unordered_map<std::string, std::string> journalHeaders{};
+
+  std::vector<std::string> splitLine(const std::string &line) {
+    std::vector<std::string> res{};
+    std::stringstream ss(line);
+    std::string item;
+    while(std::getline(ss, item, ',')) {
+      res.emplace_back(item);
+    }
+    // trailing empty value
+    if(!line.empty() && line.back() == ',') {
+      res.emplace_back();
+    }
+    return res;
+  }
+
+  std::string joinLine(const std::vector<std::string> &values) {
+    std::string res{};
+    for(size_t i = 0; i < values.size(); ++i) {
+      res += (i > 0 ? "," : "") + values[i];
+    }
+    return res;
+  }
+
+  // complete lines of a file (a line being appended is ignored)
+  bool readLines(const std::string &path, std::vector<std::string> &lines) {
+    std::ifstream file(path.data(), std::ios::binary);
+    if(!file.is_open()) {
+      return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const auto content = buffer.str();
+
+    size_t begin = 0;
+    size_t end = content.find('\n');
+    while(end != std::string::npos) {
+      auto line = content.substr(begin, end - begin);
+      if(!line.empty() && line.back() == '\r') {
+        line.pop_back();
+      }
+      if(!line.empty()) {
+        lines.emplace_back(line);
+      }
+      begin = end + 1;
+      end = content.find('\n', begin);
+    }
+    return true;
+  }
+
+  bool touchFile(const std::string &path) {
+    std::ofstream file(path.data(), std::ios::app);
+    return file.is_open();
+  }
+
+  /// data.csv content, rows replaced by a more recent one are invalidated
+  struct CsvTable {
+    struct Row {
+      std::vector<std::string> values{};
+      std::string file{};
+      bool valid{true};
+    };
+
+    std::vector<std::string> columns{};
+    std::unordered_map<std::string, size_t> columnIds{};
+    std::vector<Row> rows{};
+    std::unordered_map<std::string, size_t> rowIds{};
+
+    void insert(const std::vector<std::string> &header,
+                const std::vector<std::string> &line,
+                std::vector<std::string> &replacedFiles) {
+      Row row{};
+      row.values.resize(this->columns.size());
+      for(size_t i = 0; i < header.size(); ++i) {
+        if(header[i] == "FILE") {
+          row.file = line[i];
+          continue;
+        }
+        const auto it = this->columnIds.find(header[i]);
+        size_t id = this->columns.size();
+        if(it == this->columnIds.end()) {
+          this->columnIds.emplace(header[i], id);
+          this->columns.emplace_back(header[i]);
+          row.values.resize(this->columns.size());
+        } else {
+          id = it->second;
+        }
+        row.values[id] = line[i];
+      }
+
+      // key independent of the columns added afterwards
+      std::string key{};
+      for(size_t i = 0; i < row.values.size(); ++i) {
+        if(!row.values[i].empty()) {
+          key += std::to_string(i) + ":" + row.values[i] + "\n";
+        }
+      }
+
+      const auto it = this->rowIds.find(key);
+      if(it != this->rowIds.end()) {
+        auto &old = this->rows[it->second];
+        old.valid = false;
+        if(old.file != row.file) {
+          replacedFiles.emplace_back(old.file);
+        }
+        it->second = this->rows.size();
+      } else {
+        this->rowIds.emplace(key, this->rows.size());
+      }
+      this->rows.emplace_back(std::move(row));
+    }
+  };
+} // namespace
+
+ttk::CinemaJournal::CinemaJournal() {
+  this->setDebugMsgPrefix("CinemaJournal");
+}
+
+std::string ttk::CinemaJournal::getLockFile(const std::string &databasePath) {
+  return databasePath + "/data.csv.lock";
+}
+
+std::string
+  ttk::CinemaJournal::getJournalFolder(const std::string &databasePath) const {
+  return databasePath + "/journal";
+}
+
+std::string
+  ttk::CinemaJournal::getJournalFile(const std::string &databasePath) const {
+  // one journal per process (and per host for shared file systems)
+  std::string host{"localhost"};
+#ifdef _WIN32
+  const auto computerName = std::getenv("COMPUTERNAME");
+  if(computerName != nullptr) {
+    host = computerName;
+  }
+  const auto pid = _getpid();
+#else
+  char hostName[256]{};
+  if(gethostname(hostName, sizeof(hostName) - 1) == 0 && hostName[0] != 0) {
+    host = hostName;
+  }
+  const auto pid = getpid();
+#endif
+  return this->getJournalFolder(databasePath) + "/" + host + "_"
+         + std::to_string(pid) + ".csv";
+}
+
+bool ttk::CinemaJournal::hasJournals(const std::string &databasePath) const {
+  const auto folder = this->getJournalFolder(databasePath);
+  if(OsCall::getFileModificationTime(folder) < 0) {
+    return false;
+  }
+  return !OsCall::listFilesInDirectory(folder, "csv").empty();
+}
+
+int ttk::CinemaJournal::appendRow(const std::string &databasePath,
+                                  const std::vector<std::string> &fields,
+                                  const std::vector<std::string> &values,
+                                  const std::string &file) const {
+
+  const auto folder = this->getJournalFolder(databasePath);
+  if(OsCall::getFileModificationTime(folder) < 0) {
+    OsCall::mkDir(folder);
+  }
+  const auto lockFile = getLockFile(databasePath);
+  if(!touchFile(lockFile)) {
+    this->printErr("Unable to create '" + lockFile + "'.");
+    return 0;
+  }
+
+  auto header = fields;
+  header.emplace_back("FILE");
+  auto row = values;
+  row.emplace_back(file);
+  const auto headerLine = joinLine(header);
+
+  try {
+    boost::interprocess::file_lock flock(lockFile.data());
+    boost::interprocess::sharable_lock<boost::interprocess::file_lock> lock(
+      flock);
+
+    const auto journalFile = this->getJournalFile(databasePath);
+    std::lock_guard<std::mutex> guard(journalHeadersMutex);
+    auto &lastHeader = journalHeaders[journalFile];
+
+    // the header is repeated when the columns change or after a compaction
+    std::string lines{};
+    if(headerLine != lastHeader
+       || OsCall::getFileModificationTime(journalFile) < 0) {
+      lines += "#" + headerLine + "\n";
+    }
+    // rows of different journals are ordered by their insertion time
+    const auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+    lines += std::to_string(now.count()) + "," + joinLine(row) + "\n";
+
+    // a single write, in append mode
+    FILE *fp = fopen(journalFile.data(), "ab");
+    if(fp == nullptr) {
+      this->printErr("Unable to open journal '" + journalFile + "'.");
+      return 0;
+    }
+    const auto written = fwrite(lines.data(), 1, lines.size(), fp);
+    if(fclose(fp) != 0 || written != lines.size()) {
+      this->printErr("Unable to append to journal '" + journalFile + "'.");
+      return 0;
+    }
+    lastHeader = headerLine;
+  } catch(boost::interprocess::interprocess_exception &e) {
+    this->printErr("Unable to lock '" + lockFile + "'.");
+    return 0;
+  }
+
+  return 1;
+}
+
+int ttk::CinemaJournal::compactJournals(
+  const std::string &databasePath, const bool removeReplacedProducts) const {
+
+  if(!this->hasJournals(databasePath)) {
+    return 1;
+  }
+
+  Timer t;
+  this->printMsg("Compacting journals", 0, debug::LineMode::REPLACE);
+
+  const auto lockFile = getLockFile(databasePath);
+  if(!touchFile(lockFile)) {
+    this->printErr("Unable to create '" + lockFile + "'.");
+    return 0;
+  }
+
+  size_t nJournals{}, nRows{};
+
+  try {
+    boost::interprocess::file_lock flock(lockFile.data());
+    boost::interprocess::scoped_lock<boost::interprocess::file_lock> lock(
+      flock);
+
+    // journals may have been compacted while waiting for the lock
+    const auto folder = this->getJournalFolder(databasePath);
+    const auto journals = OsCall::listFilesInDirectory(folder, "csv");
+    if(journals.empty()) {
+      this->printMsg("Compacting journals", 1, t.getElapsedTime());
+      return 1;
+    }
+
+    CsvTable table{};
+    std::vector<std::string> replacedFiles{};
+
+    // current data.csv content
+    const std::string csvPath = databasePath + "/data.csv";
+    std::vector<std::string> lines{};
+    if(readLines(csvPath, lines) && !lines.empty()) {
+      const auto header = splitLine(lines[0]);
+      for(size_t i = 1; i < lines.size(); ++i) {
+        const auto row = splitLine(lines[i]);
+        if(row.size() == header.size()) {
+          table.insert(header, row, replacedFiles);
+        }
+      }
+    }
+
+    // journal rows (time, header, values)
+    std::vector<std::vector<std::string>> headers{};
+    std::vector<std::tuple<long long, size_t, std::vector<std::string>>>
+      journalRows{};
+    for(const auto &journal : journals) {
+      lines.clear();
+      if(!readLines(journal, lines)) {
+        this->printErr("Unable to read journal '" + journal + "'.");
+        return 0;
+      }
+      for(const auto &line : lines) {
+        if(line[0] == '#') {
+          headers.emplace_back(splitLine(line.substr(1)));
+          continue;
+        }
+        auto row = splitLine(line);
+        if(headers.empty() || row.size() != headers.back().size() + 1) {
+          this->printWrn("Skipping invalid row in '" + journal + "'.");
+          continue;
+        }
+        const auto time = std::atoll(row[0].data());
+        row.erase(row.begin());
+        journalRows.emplace_back(time, headers.size() - 1, std::move(row));
+      }
+      // the header of a journal does not apply to the next one
+      headers.emplace_back();
+    }
+
+    // in insertion order
+    std::stable_sort(
+      journalRows.begin(), journalRows.end(),
+      [](const std::tuple<long long, size_t, std::vector<std::string>> &a,
+         const std::tuple<long long, size_t, std::vector<std::string>> &b) {
+        return std::get<0>(a) < std::get<0>(b);
+      });
+    for(const auto &row : journalRows) {
+      table.insert(headers[std::get<1>(row)], std::get<2>(row), replacedFiles);
+    }
+    nRows = journalRows.size();
+
+    // write the new data.csv file next to the current one, then replace it
+    const std::string tmpPath = csvPath + ".tmp";
+    {
+      std::ofstream csvFile(tmpPath.data());
+      if(!csvFile.is_open()) {
+        this->printErr("Unable to create '" + tmpPath + "'.");
+        return 0;
+      }
+      auto header = table.columns;
+      header.emplace_back("FILE");
+      csvFile << joinLine(header) << "\n";
+      for(auto &row : table.rows) {
+        if(!row.valid) {
+          continue;
+        }
+        row.values.resize(table.columns.size());
+        row.values.emplace_back(row.file);
+        csvFile << joinLine(row.values) << "\n";
+      }
+      csvFile.close();
+      if(csvFile.fail()) {
+        this->printErr("Unable to write '" + tmpPath + "'.");
+        return 0;
+      }
+    }
+#ifdef _WIN32
+    std::remove(csvPath.data());
+#endif
+    if(std::rename(tmpPath.data(), csvPath.data()) != 0) {
+      this->printErr("Unable to replace '" + csvPath + "'.");
+      return 0;
+    }
+
+    for(const auto &journal : journals) {
+      std::remove(journal.data());
+    }
+    nJournals = journals.size();
+
+    if(removeReplacedProducts) {
+      std::unordered_map<std::string, bool> isReferenced{};
+      for(const auto &row : table.rows) {
+        if(row.valid) {
+          isReferenced[row.values.back()] = true;
+        }
+      }
+      for(const auto &file : replacedFiles) {
+        if(!isReferenced[file]) {
+          std::remove((databasePath + "/" + file).data());
+        }
+      }
+    }
+  } catch(boost::interprocess::interprocess_exception &e) {
+    this->printErr("Unable to lock '" + lockFile + "'.");
+    return 0;
+  }
+
+  this->printMsg("Compacted " + std::to_string(nRows) + " rows from "
+                   + std::to_string(nJournals) + " journal(s)",
+                 1, t.getElapsedTime());
+
+  return 1;
+}
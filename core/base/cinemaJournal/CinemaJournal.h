@@ -0,0 +1,76 @@
+/// \ingroup base
+/// \class ttk::CinemaJournal
+///
+/// \brief TTK %cinemaJournal processing package.
+///
+/// %CinemaJournal records the rows inserted into the data.csv file of a
+/// Cinema Spec D database in append-only journals, one per process, stored
+/// in the journal folder of the database. Concurrent writers then only
+/// append a line to their own journal instead of rewriting data.csv.
+///
+/// The journals are merged into data.csv (compacted) on demand, typically
+/// before the database is read. Rows with the same keys (all the columns
+/// but FILE) are replaced by the most recent one.
+///
+/// Appending takes a sharable lock on the data.csv.lock file of the
+/// database, compacting (or rewriting data.csv) an exclusive one.
+///
+/// \sa ttkCinemaWriter
+/// \sa ttkCinemaReader
+
+#pragma once
+
+// base code includes
+#include <Debug.h>
+
+#include <string>
+#include <vector>
+
+namespace ttk {
+
+  class CinemaJournal : virtual public Debug {
+
+  public:
+    CinemaJournal();
+
+    /**
+     * @brief Append a row to the journal of the current process
+     *
+     * @param[in] databasePath Path to the Cinema database
+     * @param[in] fields Names of the key columns of the row
+     * @param[in] values Values of the key columns of the row
+     * @param[in] file Value of the FILE column of the row
+     * @return 1 on success, 0 otherwise
+     */
+    int appendRow(const std::string &databasePath,
+                  const std::vector<std::string> &fields,
+                  const std::vector<std::string> &values,
+                  const std::string &file) const;
+
+    /**
+     * @brief Merge the journals of a database into its data.csv file
+     *
+     * @param[in] databasePath Path to the Cinema database
+     * @param[in] removeReplacedProducts Delete the product files of the
+     * rows replaced by a row with the same keys and another FILE value
+     * @return 1 on success, 0 otherwise
+     */
+    int compactJournals(const std::string &databasePath,
+                        const bool removeReplacedProducts = true) const;
+
+    /**
+     * @brief Check whether a database has journals not compacted yet
+     */
+    bool hasJournals(const std::string &databasePath) const;
+
+    /**
+     * @brief Path to the file locked to access the database
+     */
+    static std::string getLockFile(const std::string &databasePath);
+
+  protected:
+    std::string getJournalFolder(const std::string &databasePath) const;
+    std::string getJournalFile(const std::string &databasePath) const;
+  };
+
+} // namespace ttk
@@ -1,8 +1,125 @@
 #include <CinemaQuery.h>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 
 #if TTK_ENABLE_SQLITE3
 #include <sqlite3.h>
+
+namespace {
+  // runs a statement without result
+  int runStatement(sqlite3 *db, const std::string &sql) {
+    return sqlite3_exec(db, sql.data(), nullptr, nullptr, nullptr);
+  }
+
+  // creates and fills the tables in a single transaction, with one prepared
+  // statement per table
+  int fillDatabase(sqlite3 *db,
+                   const std::vector<ttk::CinemaQuery::Table> &tables) {
+    int rc = runStatement(db, "BEGIN TRANSACTION");
+
+    for(const auto &table : tables) {
+      if(rc != SQLITE_OK)
+        break;
+      rc = runStatement(db, table.definition);
+      if(rc != SQLITE_OK || table.nColumns == 0)
+        continue;
+
+      std::string sqlInsert = "INSERT INTO " + table.name + " VALUES (?";
+      for(size_t j = 1; j < table.nColumns; j++)
+        sqlInsert += ",?";
+      sqlInsert += ")";
+
+      sqlite3_stmt *sqlStatement;
+      rc = sqlite3_prepare_v2(
+        db, sqlInsert.data(), -1, &sqlStatement, nullptr);
+      if(rc != SQLITE_OK)
+        break;
+
+      const size_t nRows = table.values.size() / table.nColumns;
+      for(size_t i = 0; i < nRows && rc == SQLITE_OK; i++) {
+        const std::string *row = &table.values[i * table.nColumns];
+        for(size_t j = 0; j < table.nColumns; j++)
+          sqlite3_bind_text(sqlStatement, j + 1, row[j].data(),
+                            row[j].size(), SQLITE_STATIC);
+        rc = sqlite3_step(sqlStatement) == SQLITE_DONE ? SQLITE_OK
+                                                        : SQLITE_ERROR;
+        sqlite3_reset(sqlStatement);
+      }
+      sqlite3_finalize(sqlStatement);
+    }
+
+    if(rc == SQLITE_OK)
+      rc = runStatement(db, "COMMIT");
+    return rc;
+  }
+
+  // 64-bit FNV-1a hash of the table contents, so that an index is not
+  // re-used after the values of its tables have been edited
+  std::string hashTables(const std::vector<ttk::CinemaQuery::Table> &tables) {
+    uint64_t hash = 14695981039346656037ULL;
+    const auto update = [&hash](const std::string &str) {
+      // the terminating null character separates the strings
+      for(size_t i = 0; i <= str.size(); i++) {
+        hash ^= static_cast<unsigned char>(str.c_str()[i]);
+        hash *= 1099511628211ULL;
+      }
+    };
+    for(const auto &table : tables) {
+      update(table.name);
+      update(table.definition);
+      for(const auto &value : table.values)
+        update(value);
+    }
+    return std::to_string(hash);
+  }
+
+  // (re)builds the index in a temporary file, then replaces the previous one
+  int buildIndex(const std::vector<ttk::CinemaQuery::Table> &tables,
+                 const std::string &indexFile,
+                 const std::string &indexKey,
+                 std::string &errorMsg) {
+    sqlite3 *db;
+    const std::string tmpFile = indexFile + ".tmp";
+    std::remove(tmpFile.data());
+    int rc = sqlite3_open(tmpFile.data(), &db);
+    if(rc == SQLITE_OK)
+      rc = runStatement(db, "PRAGMA journal_mode = OFF");
+    if(rc == SQLITE_OK)
+      rc = runStatement(db, "PRAGMA synchronous = OFF");
+    if(rc == SQLITE_OK)
+      rc = fillDatabase(db, tables);
+    if(rc == SQLITE_OK)
+      rc = runStatement(db, "CREATE TABLE ttkIndex (key TEXT)");
+    if(rc == SQLITE_OK) {
+      sqlite3_stmt *sqlStatement;
+      rc = sqlite3_prepare_v2(
+        db, "INSERT INTO ttkIndex VALUES (?)", -1, &sqlStatement, nullptr);
+      if(rc == SQLITE_OK) {
+        sqlite3_bind_text(sqlStatement, 1, indexKey.data(), indexKey.size(),
+                          SQLITE_STATIC);
+        rc = sqlite3_step(sqlStatement) == SQLITE_DONE ? SQLITE_OK
+                                                        : SQLITE_ERROR;
+        sqlite3_finalize(sqlStatement);
+      }
+    }
+    if(rc != SQLITE_OK) {
+      errorMsg = sqlite3_errmsg(db);
+      sqlite3_close(db);
+      std::remove(tmpFile.data());
+      return rc;
+    }
+    sqlite3_close(db);
+
+    std::remove(indexFile.data());
+    if(std::rename(tmpFile.data(), indexFile.data()) != 0) {
+      errorMsg = "Unable to write database index " + indexFile;
+      std::remove(tmpFile.data());
+      return SQLITE_CANTOPEN;
+    }
+    return SQLITE_OK;
+  }
+} // namespace
 #endif
 
 ttk::CinemaQuery::CinemaQuery() {
@@ -11,13 +128,43 @@ ttk::CinemaQuery::CinemaQuery() {
 ttk::CinemaQuery::~CinemaQuery() {
 }
 
-int ttk::CinemaQuery::execute(
-  const std::vector<std::string> &sqlTableDefinitions,
-  const std::vector<std::string> &sqlInsertStatements,
-  const std::string &sqlQuery,
-  std::stringstream &resultCSV,
-  int &csvNColumns,
-  int &csvNRows) const {
+bool ttk::CinemaQuery::isIndexUpToDate(const std::string &indexFile,
+                                       const std::string &indexKey) const {
+#if TTK_ENABLE_SQLITE3
+  sqlite3 *db;
+  if(sqlite3_open_v2(indexFile.data(), &db, SQLITE_OPEN_READONLY, nullptr)
+     != SQLITE_OK) {
+    sqlite3_close(db);
+    return false;
+  }
+
+  bool upToDate = false;
+  sqlite3_stmt *sqlStatement;
+  if(sqlite3_prepare_v2(
+       db, "SELECT key FROM ttkIndex", -1, &sqlStatement, nullptr)
+     == SQLITE_OK) {
+    if(sqlite3_step(sqlStatement) == SQLITE_ROW) {
+      const auto key = reinterpret_cast<const char *>(
+        sqlite3_column_text(sqlStatement, 0));
+      upToDate = key != nullptr && indexKey == key;
+    }
+    sqlite3_finalize(sqlStatement);
+  }
+  sqlite3_close(db);
+
+  return upToDate;
+#else
+  return false;
+#endif
+}
+
+int ttk::CinemaQuery::execute(const std::vector<Table> &tables,
+                              const std::string &sqlQuery,
+                              std::stringstream &resultCSV,
+                              int &csvNColumns,
+                              int &csvNRows,
+                              const std::string &indexFile,
+                              const std::string &indexKey) const {
 
 #if TTK_ENABLE_SQLITE3
   // print input
@@ -35,12 +182,48 @@ int ttk::CinemaQuery::execute(
   }
 
   // SQLite Variables
-  sqlite3 *db;
-  char *zErrMsg = 0;
+  sqlite3 *db{};
   int rc;
 
-  // Create Temporary Database
-  {
+  // the index is only a cache: if it cannot be built or opened (e.g. on a
+  // read-only Cinema database), a temporary database is used instead
+  bool useIndex = !indexFile.empty();
+  if(useIndex) {
+    const std::string key = indexKey + ";" + hashTables(tables);
+    if(!this->isIndexUpToDate(indexFile, key)) {
+      Timer timer;
+      this->printMsg(
+        "Building database index", 0, ttk::debug::LineMode::REPLACE);
+
+      std::string errorMsg{};
+      if(buildIndex(tables, indexFile, key, errorMsg) == SQLITE_OK) {
+        this->printMsg("Building database index", 1, timer.getElapsedTime());
+      } else {
+        this->printWrn(errorMsg);
+        useIndex = false;
+      }
+    }
+
+    if(useIndex) {
+      // Open the index (read-only)
+      rc = sqlite3_open_v2(
+        indexFile.data(), &db, SQLITE_OPEN_READONLY, nullptr);
+      if(rc == SQLITE_OK) {
+        this->printMsg("Using database index " + indexFile);
+      } else {
+        this->printWrn(sqlite3_errmsg(db));
+        sqlite3_close(db);
+        useIndex = false;
+      }
+    }
+
+    if(!useIndex) {
+      this->printWrn("Unable to use database index " + indexFile);
+    }
+  }
+
+  if(!useIndex) {
+    // Create Temporary Database
     Timer timer;
     this->printMsg(
       "Creating inmemory database", 0, ttk::debug::LineMode::REPLACE);
@@ -49,38 +232,22 @@ int ttk::CinemaQuery::execute(
     rc = sqlite3_open(":memory:", &db);
     if(rc != SQLITE_OK) {
       this->printErr(sqlite3_errmsg(db));
+      sqlite3_close(db);
       return 0;
     }
 
-    // Create table
-    for(auto &sqlTableDefinition : sqlTableDefinitions) {
-      rc = sqlite3_exec(db, sqlTableDefinition.data(), nullptr, 0, &zErrMsg);
-      if(rc != SQLITE_OK) {
-        this->printErr(zErrMsg);
-
-        sqlite3_free(zErrMsg);
-        sqlite3_close(db);
-
-        return 0;
-      }
-    }
-
-    // Fill table
-    for(auto &sqlInsertStatement : sqlInsertStatements) {
-      rc = sqlite3_exec(db, sqlInsertStatement.data(), nullptr, 0, &zErrMsg);
-      if(rc != SQLITE_OK) {
-        this->printErr(zErrMsg);
-
-        sqlite3_free(zErrMsg);
-        sqlite3_close(db);
-        return 0;
-      }
+    // Create and fill tables
+    rc = fillDatabase(db, tables);
+    if(rc != SQLITE_OK) {
+      this->printErr(sqlite3_errmsg(db));
+      sqlite3_close(db);
+      return 0;
     }
 
     this->printMsg("Creating inmemory database", 1, timer.getElapsedTime());
   }
 
-  // Run SQL statement on temporary database
+  // Run SQL statement on database
   {
     this->printMsg("Querying database", 0, ttk::debug::LineMode::REPLACE);
     Timer timer;
@@ -101,6 +268,7 @@ int ttk::CinemaQuery::execute(
       if(csvNColumns < 1) {
         this->printErr("Query result has no columns.");
 
+        sqlite3_finalize(sqlStatement);
         sqlite3_close(db);
         return 0;
       }
@@ -126,6 +294,7 @@ int ttk::CinemaQuery::execute(
       if(rc != SQLITE_DONE) {
         this->printErr(sqlite3_errmsg(db));
 
+        sqlite3_finalize(sqlStatement);
         sqlite3_close(db);
         return 0;
       } else {
@@ -159,4 +328,4 @@ int ttk::CinemaQuery::execute(
   this->printErr("This filter requires Sqlite3");
   return 0;
 #endif
-}
\ No newline at end of file
+}
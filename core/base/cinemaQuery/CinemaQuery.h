@@ -5,8 +5,13 @@
 ///
 /// \brief TTK %cinemaQuery processing package.
 ///
-/// %CinemaQuery is a TTK processing package that generates a temporary SQLite3
+/// %CinemaQuery is a TTK processing package that generates a SQLite3
 /// Database to perform a SQL query which is returned as a CSV String
+///
+/// The database is either temporary (in memory), or stored in an index file
+/// that is only rebuilt when its key (typically the modification time of the
+/// Cinema database) or the content of the tables changes, so that repeated
+/// queries skip the ingestion.
 
 #pragma once
 
@@ -18,17 +23,41 @@
 namespace ttk {
   class CinemaQuery : virtual public Debug {
   public:
+    /// Content of an input table
+    struct Table {
+      /// table name
+      std::string name{};
+      /// SQL table definition (CREATE TABLE statement)
+      std::string definition{};
+      /// number of columns of the table
+      size_t nColumns{};
+      /// values, row by row (converted by the column type affinity)
+      std::vector<std::string> values{};
+    };
+
     CinemaQuery();
     ~CinemaQuery();
 
-    /** Creates a temporary database based on a SQL table definition and
-     *  and table content to subsequentually return a query result.
+    /**
+     * @brief Check whether an index file was built with the given key
+     */
+    bool isIndexUpToDate(const std::string &indexFile,
+                         const std::string &indexKey) const;
+
+    /** Creates a database based on a list of tables to subsequentually
+     *  return a query result.
+     *
+     *  If indexFile is not empty, the database is stored in this file and
+     *  re-used by the next executions with the same indexKey and the same
+     *  table contents. Otherwise, or if the index file cannot be written or
+     *  opened, a temporary database is created in memory.
      */
-    int execute(const std::vector<std::string> &sqlTableDefinitions,
-                const std::vector<std::string> &sqlInsertStatements,
+    int execute(const std::vector<Table> &tables,
                 const std::string &sqlQuery,
                 std::stringstream &resultCSV,
                 int &csvNColumns,
-                int &csvNRows) const;
+                int &csvNRows,
+                const std::string &indexFile = "",
+                const std::string &indexKey = "") const;
   };
-} // namespace ttk
\ No newline at end of file
+} // namespace ttk
@@ -0,0 +1,76 @@
+#include <MappedFile.h>
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ttk::MappedFile::~MappedFile() {
+  this->close();
+}
+
+int ttk::MappedFile::open(const std::string &fileName,
+                          const bool copyOnWrite) {
+  this->close();
+
+#ifndef _WIN32
+  const int fd = ::open(fileName.data(), O_RDONLY);
+  if(fd < 0) {
+    return -1;
+  }
+  struct stat info;
+  if(fstat(fd, &info) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  const size_t fileSize = static_cast<size_t>(info.st_size);
+  if(fileSize > 0) {
+    const int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *addr = mmap(nullptr, fileSize, prot, MAP_PRIVATE, fd, 0);
+    if(addr != MAP_FAILED) {
+      // the mapping stays valid once the file is closed
+      ::close(fd);
+      this->data_ = static_cast<const char *>(addr);
+      this->size_ = fileSize;
+      this->copyOnWrite_ = copyOnWrite;
+      return 0;
+    }
+  }
+  ::close(fd);
+#endif // _WIN32
+
+  // read the file in a buffer
+  std::ifstream file(fileName.data(), std::ios::binary | std::ios::ate);
+  if(!file.is_open()) {
+    return -1;
+  }
+  const auto size = static_cast<size_t>(file.tellg());
+  // non-null data for empty files
+  this->buffer_.resize(size + 1);
+  file.seekg(0);
+  if(!file.read(this->buffer_.data(), size)) {
+    this->buffer_ = {};
+    return -1;
+  }
+  this->data_ = this->buffer_.data();
+  this->size_ = size;
+  // the buffer is a private copy
+  this->copyOnWrite_ = copyOnWrite;
+  return 0;
+}
+
+void ttk::MappedFile::close() {
+#ifndef _WIN32
+  if(this->data_ != nullptr && this->buffer_.empty()) {
+    munmap(const_cast<char *>(this->data_), this->size_);
+  }
+#endif // _WIN32
+  this->data_ = nullptr;
+  this->size_ = 0;
+  this->copyOnWrite_ = false;
+  this->buffer_ = {};
+}
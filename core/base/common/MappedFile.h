@@ -0,0 +1,61 @@
+/// \ingroup base
+/// \class ttk::MappedFile
+///
+/// \brief Read-only memory mapping of a file.
+///
+/// The file content is mapped in memory (mmap) instead of being read, so
+/// that only the accessed pages are loaded from disk. On platforms without
+/// mmap, the file is read in a buffer.
+///
+/// With copy-on-write mappings, the content can be modified in memory
+/// without modifying the file (the modified pages are copied).
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ttk {
+
+  class MappedFile {
+
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// Map a whole file, return 0 on success, -1 otherwise
+    int open(const std::string &fileName, const bool copyOnWrite = false);
+
+    /// Unmap the file
+    void close();
+
+    inline bool isOpen() const {
+      return this->data_ != nullptr;
+    }
+
+    inline const char *data() const {
+      return this->data_;
+    }
+
+    /// Writable content (copy-on-write mappings only)
+    inline char *writableData() {
+      return this->copyOnWrite_ ? const_cast<char *>(this->data_) : nullptr;
+    }
+
+    inline size_t size() const {
+      return this->size_;
+    }
+
+  private:
+    const char *data_{};
+    size_t size_{};
+    bool copyOnWrite_{};
+    // fallback when the file cannot be mapped
+    std::vector<char> buffer_{};
+  };
+
+} // namespace ttk
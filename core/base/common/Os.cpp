@@ -16,11 +16,14 @@
 #include <cwchar>
 #include <direct.h>
 #include <stdint.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 #include <time.h>
 
 #elif defined(__unix__) || defined(__APPLE__)
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -29,6 +32,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 namespace ttk {
@@ -69,6 +73,21 @@ namespace ttk {
     return 1;
   }
 
+  long long OsCall::getFileModificationTime(const std::string &fileName) {
+#ifdef _WIN32
+    struct _stat64 info;
+    if(_stat64(fileName.data(), &info) != 0) {
+      return -1;
+    }
+#else
+    struct stat info;
+    if(stat(fileName.data(), &info) != 0) {
+      return -1;
+    }
+#endif
+    return static_cast<long long>(info.st_mtime);
+  }
+
   double OsCall::getTimeStamp() {
 #ifdef _WIN32
     LARGE_INTEGER frequency;
@@ -225,6 +244,34 @@ namespace ttk {
       return (int)lowerBound;
   }
 
+  int OsCall::prefetchFile(const std::string &fileName) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(fileName.data(), O_RDONLY);
+    if(fd < 0) {
+      return -1;
+    }
+    int ret = -1;
+#ifdef __APPLE__
+    struct stat info;
+    if(fstat(fd, &info) == 0) {
+      struct radvisory advice;
+      advice.ra_offset = 0;
+      advice.ra_count = static_cast<int>(
+        std::min<off_t>(info.st_size, std::numeric_limits<int>::max()));
+      ret = fcntl(fd, F_RDADVISE, &advice) == -1 ? -1 : 0;
+    }
+#elif defined(POSIX_FADV_WILLNEED)
+    // asynchronous read-ahead of the whole file
+    ret = posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) == 0 ? 0 : -1;
+#endif
+    close(fd);
+    return ret;
+#else
+    // not supported
+    return -1;
+#endif
+  }
+
   int OsCall::rmDir(const std::string &directoryName) {
     return std::remove(directoryName.c_str());
   }
@@ -66,6 +66,10 @@ namespace ttk {
   public:
     static int getCurrentDirectory(std::string &directoryPath);
 
+    /// Last modification time of a file (in seconds since the Epoch),
+    /// -1 if the file cannot be accessed
+    static long long getFileModificationTime(const std::string &fileName);
+
     static float getMemoryInstantUsage();
 
     static int getNumberOfCores();
@@ -80,6 +84,11 @@ namespace ttk {
 
     static int nearbyint(const double &x);
 
+    /// Ask the system to load a file in the page cache in the background
+    /// (returns immediately), -1 if not supported or the file cannot be
+    /// opened
+    static int prefetchFile(const std::string &fileName);
+
     static int rmDir(const std::string &directoryName);
 
     static int rmFile(const std::string &fileName);
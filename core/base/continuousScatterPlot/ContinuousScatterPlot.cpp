@@ -5,8 +5,10 @@ using namespace ttk;
 
 ContinuousScatterPlot::ContinuousScatterPlot()
   : vertexNumber_{}, withDummyValue_{}, dummyValue_{}, resolutions_{},
-    scalarMin_{}, scalarMax_{}, density_{} {
+    scalarMin_{}, scalarMax_{}, density_{}, validPointMask_{} {
   this->setDebugMsgPrefix("ContinuousScatterPlot");
 }
 
-ContinuousScatterPlot::~ContinuousScatterPlot() = default;
\ No newline at end of file
+ContinuousScatterPlot::~ContinuousScatterPlot() = default;
+
+const SimplexId ContinuousScatterPlot::tileSize_;
\ No newline at end of file
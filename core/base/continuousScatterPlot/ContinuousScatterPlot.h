@@ -12,6 +12,12 @@
 /// Proc. of IEEE VIS 2008.\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2008.
 ///
+/// The output density and mask are flat row-major buffers (index
+/// i * resolutionY + j). To avoid atomic contention on the hot bins, each
+/// thread accumulates the projections of its tetrahedra in private tiles of
+/// the image, allocated on first use, which are summed by a parallel
+/// reduction over the tiles.
+///
 /// \sa ttkContinuousScatterPlot.cpp %for a usage example.
 
 #pragma once
@@ -20,6 +26,8 @@
 #include <Geometry.h>
 #include <Triangulation.h>
 
+#include <array>
+
 namespace ttk {
 
   class ContinuousScatterPlot : virtual public Debug {
@@ -65,25 +73,37 @@ namespace ttk {
       return 0;
     }
 
-    inline int setOutputDensity(std::vector<std::vector<double>> *density) {
+    /// resolutionX * resolutionY values, index i * resolutionY + j
+    inline int setOutputDensity(double *density) {
       density_ = density;
       return 0;
     }
 
-    inline int setOutputMask(std::vector<std::vector<char>> *mask) {
+    /// resolutionX * resolutionY values, index i * resolutionY + j
+    inline int setOutputMask(char *mask) {
       validPointMask_ = mask;
       return 0;
     }
 
   protected:
+    /// Width (and height) in bins of the thread-private tiles
+    static const SimplexId tileSize_{64};
+
+    /// Thread-private accumulation buffers, one (flat) tile per entry,
+    /// empty until the thread writes in it
+    struct ThreadTiles {
+      std::vector<std::vector<double>> density{};
+      std::vector<std::vector<char>> mask{};
+    };
+
     SimplexId vertexNumber_;
     bool withDummyValue_;
     double dummyValue_;
     SimplexId resolutions_[2];
     double *scalarMin_;
     double *scalarMax_;
-    std::vector<std::vector<double>> *density_;
-    std::vector<std::vector<char>> *validPointMask_;
+    double *density_;
+    char *validPointMask_;
   };
 } // namespace ttk
 
@@ -101,6 +121,8 @@ int ttk::ContinuousScatterPlot::execute(
     return -3;
   if(!density_)
     return -4;
+  if(!validPointMask_)
+    return -7;
 
   if(triangulation->getNumberOfCells() <= 0) {
     this->printErr("no cells.");
@@ -127,10 +149,26 @@ int ttk::ContinuousScatterPlot::execute(
     delta[0] / resolutions_[0], delta[1] / resolutions_[1]};
   const double epsilon{0.000001};
 
+  // thread-private tiles
+  const SimplexId tileNumber[2]{(resolutions_[0] + tileSize_ - 1) / tileSize_,
+                                (resolutions_[1] + tileSize_ - 1) / tileSize_};
+  std::vector<ThreadTiles> threadTiles(threadNumber_);
+  for(auto &tiles : threadTiles) {
+    tiles.density.resize(tileNumber[0] * tileNumber[1]);
+    tiles.mask.resize(tileNumber[0] * tileNumber[1]);
+  }
+
+  // static schedule: each thread processes a contiguous range of cells,
+  // usually projected on a few tiles
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_) schedule(static)
 #endif
   for(SimplexId cell = 0; cell < numberOfCells; ++cell) {
+#ifdef TTK_ENABLE_OPENMP
+    ThreadTiles &tiles = threadTiles[omp_get_thread_num()];
+#else
+    ThreadTiles &tiles = threadTiles[0];
+#endif
     bool isDummy{};
 
     // get tetrahedron info
@@ -252,9 +290,10 @@ int ttk::ContinuousScatterPlot::execute(
 
     // projection:
     double density{};
-    std::vector<std::vector<SimplexId>> triangles;
+    std::array<std::array<SimplexId, 3>, 4> triangles;
+    int triangleNumber{};
     double imaginaryPosition[3]{};
-    std::vector<SimplexId> triangle(3);
+    std::array<SimplexId, 3> triangle;
     // class 0
     if(isInTriangle) {
       // mass density
@@ -304,17 +343,17 @@ int ttk::ContinuousScatterPlot::execute(
       triangle[0] = vertex[index[3]];
       triangle[1] = vertex[index[0]];
       triangle[2] = vertex[index[1]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
 
       triangle[0] = vertex[index[3]];
       triangle[1] = vertex[index[0]];
       triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
 
       triangle[0] = vertex[index[3]];
       triangle[1] = vertex[index[1]];
       triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
     }
     // class 1
     else {
@@ -376,19 +415,19 @@ int ttk::ContinuousScatterPlot::execute(
       triangle[0] = -1; // new geometry
       triangle[1] = vertex[index[0]];
       triangle[2] = vertex[index[2]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
 
       triangle[1] = vertex[index[2]];
       triangle[2] = vertex[index[1]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
 
       triangle[1] = vertex[index[1]];
       triangle[2] = vertex[index[3]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
 
       triangle[1] = vertex[index[3]];
       triangle[2] = vertex[index[0]];
-      triangles.push_back(triangle);
+      triangles[triangleNumber++] = triangle;
     }
 
     // rendering:
@@ -409,7 +448,7 @@ int ttk::ContinuousScatterPlot::execute(
           // set ray origin
           const double o[3]{scalarMin_[0] + i * sampling[0],
                             scalarMin_[1] + j * sampling[1], 1};
-          for(unsigned int k = 0; k < triangles.size(); ++k) {
+          for(int k = 0; k < triangleNumber; ++k) {
             const auto &tr = triangles[k];
 
             // get triangle info
@@ -448,29 +487,56 @@ int ttk::ContinuousScatterPlot::execute(
             if(v < 0.0 or (u + v) > 1.0)
               continue;
 
-              // triangle/ray intersection below
-#ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
-#pragma omp atomic
-#else
-#pragma omp atomic update
-#endif
-#endif
-            (*density_)[i][j] += (1.0 - u - v) * density;
+            // triangle/ray intersection below
+            const SimplexId tile
+              = (i / tileSize_) * tileNumber[1] + j / tileSize_;
+            auto &tileDensity = tiles.density[tile];
+            auto &tileMask = tiles.mask[tile];
+            if(tileDensity.empty()) {
+              tileDensity.resize(tileSize_ * tileSize_, 0.0);
+              tileMask.resize(tileSize_ * tileSize_, 0);
+            }
+            const SimplexId bin
+              = (i % tileSize_) * tileSize_ + j % tileSize_;
+            tileDensity[bin] += (1.0 - u - v) * density;
+            tileMask[bin] = 1;
+            break;
+          }
+        }
+      }
+    }
+  }
 
+  // reduction of the thread-private tiles
 #ifdef TTK_ENABLE_OPENMP
-#ifdef _WIN32
-#pragma omp atomic
-            (*validPointMask_)[i][j] += 1;
-#else
-#pragma omp atomic write
-            (*validPointMask_)[i][j] = 1;
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
 #endif
-#else
-            (*validPointMask_)[i][j] = 1;
-#endif
-            break;
-          }
+  for(SimplexId tile = 0; tile < tileNumber[0] * tileNumber[1]; ++tile) {
+    const SimplexId tileI = tile / tileNumber[1];
+    const SimplexId tileJ = tile % tileNumber[1];
+    const SimplexId endI
+      = std::min(resolutions_[0] - tileI * tileSize_, tileSize_);
+    const SimplexId endJ
+      = std::min(resolutions_[1] - tileJ * tileSize_, tileSize_);
+    for(SimplexId i = 0; i < endI; ++i) {
+      const SimplexId row = (tileI * tileSize_ + i) * resolutions_[1];
+      for(SimplexId j = 0; j < endJ; ++j) {
+        const SimplexId id = row + tileJ * tileSize_ + j;
+        density_[id] = 0.0;
+        validPointMask_[id] = 0;
+      }
+    }
+    for(const auto &tiles : threadTiles) {
+      const auto &tileDensity = tiles.density[tile];
+      if(tileDensity.empty())
+        continue;
+      const auto &tileMask = tiles.mask[tile];
+      for(SimplexId i = 0; i < endI; ++i) {
+        const SimplexId row = (tileI * tileSize_ + i) * resolutions_[1];
+        for(SimplexId j = 0; j < endJ; ++j) {
+          const SimplexId id = row + tileJ * tileSize_ + j;
+          density_[id] += tileDensity[i * tileSize_ + j];
+          validPointMask_[id] |= tileMask[i * tileSize_ + j];
         }
       }
     }
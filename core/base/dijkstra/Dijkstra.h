@@ -3,20 +3,219 @@
 #include <Geometry.h>
 #include <Triangulation.h>
 
+#include <algorithm>
 #include <array>
-#include <functional>
-#include <queue>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ttk {
   namespace Dijkstra {
+    /**
+     * @brief Monotone priority queue (radix heap) on non-negative
+     * floating-point distances
+     *
+     * The distances are compared through their binary representation (which
+     * preserves the order of the non-negative IEEE 754 values) and stored in
+     * buckets given by the highest bit differing from the last extracted
+     * distance. The pushed distances should not be lower than the last
+     * extracted one, which holds for Dijkstra propagations. Each element is
+     * moved at most once per bit, instead of the O(log n) swaps per
+     * operation of a binary heap.
+     */
+    template <typename T>
+    class RadixHeap {
+      static_assert(std::is_floating_point<T>::value,
+                    "RadixHeap needs floating-point distances");
+      using key_t =
+        typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+      static constexpr size_t keyBits = 8 * sizeof(key_t);
+
+    public:
+      inline bool empty() const {
+        return size_ == 0;
+      }
+
+      /// Remove all elements, keeping the allocated memory
+      inline void clear() {
+        for(auto &bucket : buckets_) {
+          bucket.clear();
+        }
+        last_ = 0;
+        size_ = 0;
+      }
+
+      inline void push(const T dist, const SimplexId vertex) {
+        const auto key = toKey(dist);
+        buckets_[getBucket(key)].emplace_back(key, vertex);
+        size_++;
+      }
+
+      /// Extract an element of minimal distance
+      inline std::pair<T, SimplexId> pop() {
+        if(buckets_[0].empty()) {
+          size_t i = 1;
+          while(buckets_[i].empty()) {
+            i++;
+          }
+          // new reference: the minimum of the first non-empty bucket, whose
+          // elements all go to lower buckets
+          last_ = std::min_element(buckets_[i].begin(), buckets_[i].end())
+                    ->first;
+          for(const auto &elem : buckets_[i]) {
+            buckets_[getBucket(elem.first)].emplace_back(elem);
+          }
+          buckets_[i].clear();
+        }
+        const auto elem = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return std::make_pair(fromKey(elem.first), elem.second);
+      }
+
+    private:
+      static inline key_t toKey(const T dist) {
+        key_t key;
+        std::memcpy(&key, &dist, sizeof(key_t));
+        return key;
+      }
+
+      static inline T fromKey(const key_t key) {
+        T dist;
+        std::memcpy(&dist, &key, sizeof(key_t));
+        return dist;
+      }
+
+      /// 0 if equal to the last extracted key, else 1 + its highest bit
+      /// differing from it
+      inline size_t getBucket(const key_t key) const {
+        key_t diff = key ^ last_;
+        if(diff == 0) {
+          return 0;
+        }
+#ifdef __GNUC__
+        return sizeof(key_t) == 4
+                 ? 32 - __builtin_clz(static_cast<unsigned int>(diff))
+                 : 64 - __builtin_clzll(static_cast<unsigned long long>(diff));
+#else
+        size_t bucket = 0;
+        while(diff != 0) {
+          diff >>= 1;
+          bucket++;
+        }
+        return bucket;
+#endif // __GNUC__
+      }
+
+      std::array<std::vector<std::pair<key_t, SimplexId>>, keyBits + 1>
+        buckets_{};
+      key_t last_{};
+      size_t size_{};
+    };
+
+    /**
+     * @brief Vertex adjacency of a triangulation with precomputed edge
+     * lengths
+     *
+     * Built once per triangulation and shared (read-only) between the
+     * shortest path computations, which then avoid the vertex coordinates
+     * lookups and distance computations of each edge relaxation.
+     */
+    template <typename T>
+    class WeightedGraph {
+    public:
+      template <typename triangulationType>
+      void build(const triangulationType &triangulation,
+                 const int threadNumber = 1) {
+        const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+        offsets_.resize(vertexNumber + 1);
+        offsets_[0] = 0;
+        for(SimplexId i = 0; i < vertexNumber; ++i) {
+          offsets_[i + 1]
+            = offsets_[i] + triangulation.getVertexNeighborNumber(i);
+        }
+        neighbors_.resize(offsets_[vertexNumber]);
+        lengths_.resize(offsets_[vertexNumber]);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < vertexNumber; ++i) {
+          std::array<float, 3> vCoords{};
+          triangulation.getVertexPoint(i, vCoords[0], vCoords[1], vCoords[2]);
+          for(SimplexId j = offsets_[i]; j < offsets_[i + 1]; ++j) {
+            SimplexId neigh{};
+            triangulation.getVertexNeighbor(i, j - offsets_[i], neigh);
+            std::array<float, 3> nCoords{};
+            triangulation.getVertexPoint(
+              neigh, nCoords[0], nCoords[1], nCoords[2]);
+            neighbors_[j] = neigh;
+            lengths_[j] = Geometry::distance(vCoords.data(), nCoords.data());
+          }
+        }
+      }
+
+      /// Release the memory
+      inline void clear() {
+        offsets_ = {};
+        neighbors_ = {};
+        lengths_ = {};
+      }
+
+      inline bool empty() const {
+        return offsets_.empty();
+      }
+
+      inline SimplexId getNumberOfVertices() const {
+        return offsets_.empty() ? 0 : offsets_.size() - 1;
+      }
+
+      /// Range of the edges of a vertex in getNeighbor()/getLength()
+      inline SimplexId getBegin(const SimplexId v) const {
+        return offsets_[v];
+      }
+      inline SimplexId getEnd(const SimplexId v) const {
+        return offsets_[v + 1];
+      }
+      inline SimplexId getNeighbor(const SimplexId e) const {
+        return neighbors_[e];
+      }
+      inline T getLength(const SimplexId e) const {
+        return lengths_[e];
+      }
+
+    private:
+      std::vector<SimplexId> offsets_{};
+      std::vector<SimplexId> neighbors_{};
+      std::vector<T> lengths_{};
+    };
+
+    /**
+     * @brief Scratch buffers of shortestPath(), to be reused between calls
+     * (one per thread)
+     */
+    template <typename T>
+    struct Workspace {
+      RadixHeap<T> heap{};
+      /// 1 for the bounds not settled yet, 0 elsewhere
+      std::vector<char> isBound{};
+    };
+
     /**
      * @brief Compute the Dijkstra shortest path from source
      *
      * @param[in] source Source vertex for the Dijkstra algorithm
      * @param[in] triangulation Access to neighbor vertices
      * @param[out] outputDists Distances to source for every mesh vertex
-     * @param[in] bounds Stop the algorithim if all vertices are reached
+     * @param[in] bounds Stop the algorithim once the shortest paths to all
+     * these vertices are known (the distances of the vertices further than
+     * the furthest bound are then upper bounds, or infinite if not reached)
      * @param[in] mask Vector masking the triangulation
+     * @param[in] graph Optional precomputed edge lengths of triangulation
+     * @param[in] workspace Optional buffers reused between calls
      *
      * @return 0 in case of success
      */
@@ -27,85 +226,394 @@ namespace ttk {
                      std::vector<T> &outputDists,
                      const std::vector<SimplexId> &bounds
                      = std::vector<SimplexId>(),
-                     const std::vector<bool> &mask = std::vector<bool>()) {
+                     const std::vector<bool> &mask = std::vector<bool>(),
+                     const WeightedGraph<T> *graph = nullptr,
+                     Workspace<T> *workspace = nullptr) {
 
-      // should we process the whole mesh or stop at some point?
-      bool processAllVertices = bounds.empty();
       // total number of vertices in the mesh
-      size_t vertexNumber = triangulation.getNumberOfVertices();
+      const size_t vertexNumber = triangulation.getNumberOfVertices();
       // is there a mask?
-      bool isMask = !mask.empty();
+      const bool isMask = !mask.empty();
 
       // check mask size
       if(isMask && mask.size() != vertexNumber) {
         return 1;
       }
-
-      // list all reached bounds
-      std::vector<bool> reachedBounds;
-
-      // alloc and fill reachedBounds
-      if(!processAllVertices) {
-        reachedBounds.resize(bounds.size(), false);
+      // check graph size
+      if(graph != nullptr
+         && static_cast<size_t>(graph->getNumberOfVertices())
+              != vertexNumber) {
+        return 2;
       }
 
-      // preprocess output vector
-      outputDists.clear();
-      outputDists.resize(vertexNumber, std::numeric_limits<T>::infinity());
+      Workspace<T> localWorkspace{};
+      Workspace<T> &ws = workspace != nullptr ? *workspace : localWorkspace;
+      auto &pq = ws.heap;
+      pq.clear();
 
-      // link vertex and current distance to source
-      using pq_t = std::pair<T, SimplexId>;
+      // flag the bounds, the propagation stops when all of them are settled
+      size_t remainingBounds{};
+      if(!bounds.empty()) {
+        ws.isBound.resize(vertexNumber, 0);
+        for(const auto b : bounds) {
+          if(!ws.isBound[b]) {
+            ws.isBound[b] = 1;
+            remainingBounds++;
+          }
+        }
+      }
 
-      // priority queue storing pairs of (distance, vertices TTK id)
-      std::priority_queue<pq_t, std::vector<pq_t>, std::greater<pq_t>> pq;
+      // preprocess output vector (no reallocation if reused)
+      outputDists.assign(vertexNumber, std::numeric_limits<T>::infinity());
 
       // init pipeline
-      pq.push(std::make_pair(T(0.0F), source));
+      pq.push(T(0.0F), source);
       outputDists[source] = T(0.0F);
 
+      const auto relax = [&](const SimplexId vert, const SimplexId neigh,
+                             const T distVN) {
+        // limit to masked vertices
+        if(isMask && !mask[neigh]) {
+          return;
+        }
+        if(outputDists[neigh] > outputDists[vert] + distVN) {
+          outputDists[neigh] = outputDists[vert] + distVN;
+          pq.push(outputDists[neigh], neigh);
+        }
+      };
+
       while(!pq.empty()) {
-        auto elem = pq.top();
-        pq.pop();
-        auto vert = elem.second;
-        std::array<float, 3> vCoords{};
-        triangulation.getVertexPoint(vert, vCoords[0], vCoords[1], vCoords[2]);
+        const auto elem = pq.pop();
+        const auto vert = elem.second;
+        // outdated element (the vertex was reached by a shorter path)
+        if(elem.first > outputDists[vert]) {
+          continue;
+        }
 
-        auto nneigh = triangulation.getVertexNeighborNumber(vert);
+        if(remainingBounds > 0 && ws.isBound[vert]) {
+          ws.isBound[vert] = 0;
+          if(--remainingBounds == 0) {
+            break;
+          }
+        }
 
+        if(graph != nullptr) {
+          for(SimplexId e = graph->getBegin(vert); e < graph->getEnd(vert);
+              ++e) {
+            relax(vert, graph->getNeighbor(e), graph->getLength(e));
+          }
+          continue;
+        }
+
+        std::array<float, 3> vCoords{};
+        triangulation.getVertexPoint(vert, vCoords[0], vCoords[1], vCoords[2]);
+        const auto nneigh = triangulation.getVertexNeighborNumber(vert);
         for(SimplexId i = 0; i < nneigh; i++) {
           // neighbor Id
           SimplexId neigh{};
           triangulation.getVertexNeighbor(vert, i, neigh);
+          // neighbor coordinates
+          std::array<float, 3> nCoords{};
+          triangulation.getVertexPoint(
+            neigh, nCoords[0], nCoords[1], nCoords[2]);
+          // distance between vertex and neighbor
+          const T distVN = Geometry::distance(vCoords.data(), nCoords.data());
+          relax(vert, neigh, distVN);
+        }
+      }
 
-          // limit to masked vertices
-          if(isMask && !mask[neigh]) {
-            continue;
-          }
+      // reset the flags of the unreached bounds
+      if(remainingBounds > 0) {
+        for(const auto b : bounds) {
+          ws.isBound[b] = 0;
+        }
+      }
 
-          // neighbor coordinates
+      return 0;
+    }
+
+    /**
+     * @brief Distance of the vertices not reached by a shortest path
+     */
+    template <typename T>
+    inline T getUnreachedDistance() {
+      return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+    }
+
+    /**
+     * @brief Compute the distance to the closest source with a single
+     * Dijkstra propagation seeded with all the sources
+     *
+     * The ties between sources at the same distance are broken in favor of
+     * the first source in the list.
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distances to the closest source for every mesh
+     * vertex
+     * @param[out] outputSources Index in sources of the closest source for
+     * every mesh vertex (-1 if not reached)
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int multiSourceShortestPath(const std::vector<SimplexId> &sources,
+                                const triangulationType &triangulation,
+                                std::vector<T> &outputDists,
+                                std::vector<SimplexId> &outputSources) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+
+      outputDists.clear();
+      outputDists.resize(vertexNumber, getUnreachedDistance<T>());
+      outputSources.clear();
+      outputSources.resize(vertexNumber, -1);
+
+      RadixHeap<T> pq{};
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const SimplexId source = sources[i];
+        if(source < 0 || source >= vertexNumber) {
+          return 1;
+        }
+        if(outputSources[source] == -1) {
+          outputDists[source] = T(0.0F);
+          outputSources[source] = i;
+          pq.push(T(0.0F), source);
+        }
+      }
+
+      while(!pq.empty()) {
+        const auto elem = pq.pop();
+        const auto vert = elem.second;
+        // outdated element (the vertex was reached by a shorter path)
+        if(elem.first > outputDists[vert]) {
+          continue;
+        }
+        std::array<float, 3> vCoords{};
+        triangulation.getVertexPoint(vert, vCoords[0], vCoords[1], vCoords[2]);
+
+        const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+        for(SimplexId i = 0; i < nneigh; i++) {
+          SimplexId neigh{};
+          triangulation.getVertexNeighbor(vert, i, neigh);
           std::array<float, 3> nCoords{};
           triangulation.getVertexPoint(
             neigh, nCoords[0], nCoords[1], nCoords[2]);
-          // (square) distance between vertex and neighbor
-          T distVN = Geometry::distance(vCoords.data(), nCoords.data());
-          if(outputDists[neigh] > outputDists[vert] + distVN) {
-            outputDists[neigh] = outputDists[vert] + distVN;
-            if(!processAllVertices) {
-              // check if neigh in bounds
-              auto it = std::find(bounds.begin(), bounds.end(), neigh);
-              if(it != bounds.end()) {
-                // mark it as found
-                reachedBounds[it - bounds.begin()] = true;
-              }
-              // break if all are found
-              if(std::all_of(reachedBounds.begin(), reachedBounds.end(),
-                             [](const bool v) { return v; })) {
-                break;
-              }
+          const T dist
+            = outputDists[vert]
+              + static_cast<T>(
+                Geometry::distance(vCoords.data(), nCoords.data()));
+          if(dist < outputDists[neigh]
+             || (dist == outputDists[neigh]
+                 && outputSources[vert] < outputSources[neigh])) {
+            outputDists[neigh] = dist;
+            outputSources[neigh] = outputSources[vert];
+            pq.push(dist, neigh);
+          }
+        }
+      }
+
+      return 0;
+    }
+
+    /**
+     * @brief Parallel variant of multiSourceShortestPath (delta-stepping)
+     *
+     * The vertices are processed by buckets of distances of width delta.
+     * The edges of the vertices of the current bucket are relaxed in
+     * parallel (the light edges, shorter than delta, until the bucket is
+     * stable, then the heavy ones), the resulting updates being applied
+     * between the parallel phases. The output is the same as the one of
+     * multiSourceShortestPath().
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distances to the closest source
+     * @param[out] outputSources Index in sources of the closest source
+     * @param[in] delta Width of the buckets (if not positive, the mean edge
+     * length)
+     * @param[in] threadNumber Number of threads
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int deltaStepping(const std::vector<SimplexId> &sources,
+                      const triangulationType &triangulation,
+                      std::vector<T> &outputDists,
+                      std::vector<SimplexId> &outputSources,
+                      T delta,
+                      const int threadNumber) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+
+      const auto edgeLength = [&triangulation](const std::array<float, 3> &p,
+                                               const SimplexId v) {
+        std::array<float, 3> q{};
+        triangulation.getVertexPoint(v, q[0], q[1], q[2]);
+        return static_cast<T>(Geometry::distance(p.data(), q.data()));
+      };
+
+      if(!(delta > T(0.0F))) {
+        // mean length of the edges of a sample of vertices
+        const SimplexId step = std::max<SimplexId>(1, vertexNumber / 1024);
+        T sum{};
+        SimplexId count{};
+        for(SimplexId v = 0; v < vertexNumber; v += step) {
+          std::array<float, 3> p{};
+          triangulation.getVertexPoint(v, p[0], p[1], p[2]);
+          const auto nneigh = triangulation.getVertexNeighborNumber(v);
+          for(SimplexId i = 0; i < nneigh; i++) {
+            SimplexId neigh{};
+            triangulation.getVertexNeighbor(v, i, neigh);
+            sum += edgeLength(p, neigh);
+            count++;
+          }
+        }
+        delta = count > 0 && sum > T(0.0F) ? sum / count : T(1.0F);
+      }
+
+      outputDists.clear();
+      outputDists.resize(vertexNumber, getUnreachedDistance<T>());
+      outputSources.clear();
+      outputSources.resize(vertexNumber, -1);
+
+      // circular array of buckets: the pending vertices are at most one edge
+      // away from the current bucket, so that the number of buckets depends
+      // on the ratio between the longest edge and delta, not on the largest
+      // distance
+      std::vector<std::vector<SimplexId>> buckets(1);
+      size_t current{};
+      const auto getBucket = [&outputDists, delta](const SimplexId v) {
+        return static_cast<size_t>(outputDists[v] / delta);
+      };
+      const auto insert = [&buckets, &current, &getBucket](const SimplexId v) {
+        const auto b = getBucket(v);
+        if(b - current >= buckets.size()) {
+          // grow the array, the pending buckets keep their distance range
+          std::vector<std::vector<SimplexId>> grown(2 * (b - current + 1));
+          for(size_t i = current; i < current + buckets.size(); ++i) {
+            grown[i % grown.size()].swap(buckets[i % buckets.size()]);
+          }
+          buckets.swap(grown);
+        }
+        buckets[b % buckets.size()].emplace_back(v);
+      };
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const SimplexId source = sources[i];
+        if(source < 0 || source >= vertexNumber) {
+          return 1;
+        }
+        if(outputSources[source] == -1) {
+          outputDists[source] = T(0.0F);
+          outputSources[source] = i;
+          insert(source);
+        }
+      }
+
+      struct Request {
+        SimplexId vertex;
+        T dist;
+        SimplexId source;
+      };
+      std::vector<std::vector<Request>> requests(std::max(1, threadNumber));
+
+      // relax (in parallel) the light or heavy edges of a set of vertices,
+      // then apply the updates
+      const auto relax = [&](const std::vector<SimplexId> &vertices,
+                             const bool light) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+        for(size_t j = 0; j < vertices.size(); ++j) {
+#ifdef TTK_ENABLE_OPENMP
+          auto &threadRequests = requests[omp_get_thread_num()];
+#else
+          auto &threadRequests = requests[0];
+#endif // TTK_ENABLE_OPENMP
+          const SimplexId vert = vertices[j];
+          std::array<float, 3> vCoords{};
+          triangulation.getVertexPoint(
+            vert, vCoords[0], vCoords[1], vCoords[2]);
+          const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+          for(SimplexId i = 0; i < nneigh; i++) {
+            SimplexId neigh{};
+            triangulation.getVertexNeighbor(vert, i, neigh);
+            const T length = edgeLength(vCoords, neigh);
+            if((length <= delta) != light) {
+              continue;
+            }
+            const T dist = outputDists[vert] + length;
+            if(dist < outputDists[neigh]
+               || (dist == outputDists[neigh]
+                   && outputSources[vert] < outputSources[neigh])) {
+              threadRequests.push_back({neigh, dist, outputSources[vert]});
+            }
+          }
+        }
+
+        for(auto &threadRequests : requests) {
+          for(const auto &r : threadRequests) {
+            if(r.dist < outputDists[r.vertex]
+               || (r.dist == outputDists[r.vertex]
+                   && r.source < outputSources[r.vertex])) {
+              outputDists[r.vertex] = r.dist;
+              outputSources[r.vertex] = r.source;
+              insert(r.vertex);
+            }
+          }
+          threadRequests.clear();
+        }
+      };
+
+      std::vector<char> isListed(vertexNumber, 0);
+      std::vector<SimplexId> frontier{}, settled{};
+
+      while(true) {
+        // next non-empty bucket
+        const size_t end = current + buckets.size();
+        while(current < end && buckets[current % buckets.size()].empty()) {
+          current++;
+        }
+        if(current == end) {
+          break;
+        }
+        settled.clear();
+
+        // (the array may grow when relaxing the edges)
+        while(!buckets[current % buckets.size()].empty()) {
+          auto &bucket = buckets[current % buckets.size()];
+          // outdated (moved to another bucket) and duplicated vertices
+          frontier.clear();
+          for(const auto v : bucket) {
+            if(getBucket(v) == current && !(isListed[v] & 1)) {
+              isListed[v] |= 1;
+              frontier.emplace_back(v);
             }
-            pq.push(std::make_pair(outputDists[neigh], neigh));
           }
+          bucket.clear();
+          for(const auto v : frontier) {
+            isListed[v] &= ~1;
+            if(!(isListed[v] & 2)) {
+              isListed[v] |= 2;
+              settled.emplace_back(v);
+            }
+          }
+
+          relax(frontier, true);
+        }
+
+        // the heavy edges lead to the next buckets
+        relax(settled, false);
+        for(const auto v : settled) {
+          isListed[v] = 0;
         }
+        current++;
       }
 
       return 0;
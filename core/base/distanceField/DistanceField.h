@@ -10,6 +10,10 @@
 /// identifiers attached to them) and produces a distance field to the closest
 /// source.
 ///
+/// The distances to all the sources are computed in a single pass, either
+/// with a multi-source Dijkstra propagation or, for large meshes, with its
+/// parallel delta-stepping variant.
+///
 /// \b Related \b publication \n
 /// "A note on two problems in connexion with graphs" \n
 /// Edsger W. Dijkstra \n
@@ -32,6 +36,8 @@ namespace ttk {
   class DistanceField : virtual public Debug {
 
   public:
+    enum class Method { DIJKSTRA = 0, DELTA_STEPPING = 1 };
+
     DistanceField();
     ~DistanceField();
 
@@ -52,6 +58,17 @@ namespace ttk {
       return 0;
     }
 
+    inline int setMethod(const Method method) {
+      method_ = method;
+      return 0;
+    }
+
+    /// Width of the delta-stepping buckets (mean edge length if not positive)
+    inline int setDelta(const double delta) {
+      delta_ = delta;
+      return 0;
+    }
+
     inline int preconditionTriangulation(AbstractTriangulation *triangulation) {
       return triangulation->preconditionVertexNeighbors();
     }
@@ -83,6 +100,8 @@ namespace ttk {
     void *outputScalarFieldPointer_;
     void *outputIdentifiers_;
     void *outputSegmentation_;
+    Method method_{Method::DIJKSTRA};
+    double delta_{};
   };
 } // namespace ttk
 
@@ -100,9 +119,6 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
 
   Timer t;
 
-  std::fill(dist, dist + vertexNumber_, std::numeric_limits<dataType>::max());
-  std::fill(origin, origin + vertexNumber_, -1);
-
   // get the sources
   std::set<SimplexId> isSource;
   for(SimplexId k = 0; k < sourceNumber_; ++k)
@@ -112,34 +128,31 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
     sources.push_back(s);
   isSource.clear();
 
-  // prepare output
-  std::vector<std::vector<dataType>> scalars(sources.size());
-
-  // @PETER This doesn't seem to very work efficient, there's multilple source
-  // shortest paths algorithms.
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId i = 0; i < (SimplexId)sources.size(); ++i) {
-    int ret = Dijkstra::shortestPath<dataType>(
-      sources[i], *triangulation_, scalars[i]);
-    if(ret != 0) {
-      printErr("[Dijkstra] was not successful. Error code is  "
-               + std::to_string(ret) + ".");
-    }
+  // distances to all the sources in one pass
+  std::vector<dataType> scalars;
+  std::vector<SimplexId> closest;
+  int ret{};
+  if(method_ == Method::DELTA_STEPPING) {
+    ret = Dijkstra::deltaStepping<dataType>(
+      sources, *triangulation_, scalars, closest,
+      static_cast<dataType>(delta_), threadNumber_);
+  } else {
+    ret = Dijkstra::multiSourceShortestPath<dataType>(
+      sources, *triangulation_, scalars, closest);
+  }
+  if(ret != 0) {
+    printErr("[Dijkstra] was not successful. Error code is  "
+             + std::to_string(ret) + ".");
+    return -1;
   }
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
   for(SimplexId k = 0; k < vertexNumber_; ++k) {
-    for(SimplexId i = 0; i < (SimplexId)sources.size(); ++i) {
-      if(i == 0 or dist[k] > scalars[i][k]) {
-        dist[k] = scalars[i][k];
-        origin[k] = sources[i];
-        seg[k] = i;
-      }
-    }
+    dist[k] = scalars[k];
+    seg[k] = closest[k];
+    origin[k] = closest[k] == -1 ? -1 : sources[closest[k]];
   }
 
   {
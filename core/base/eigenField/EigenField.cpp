@@ -8,6 +8,29 @@
 #include <Spectra/MatOp/SparseSymMatProd.h>
 #include <Spectra/SymEigsSolver.h>
 
+template <typename T>
+struct ttk::EigenField::EigenCache {
+  // the Laplacian matrix only depends on the triangulation
+  const void *triangulation{};
+  SimplexId vertexNumber{};
+  Eigen::SparseMatrix<T> laplacian{};
+  // eigenvectors computed for eigenNumber (empty if not computed)
+  unsigned int eigenNumber{};
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> eigenvectors{};
+};
+
+template <>
+std::shared_ptr<ttk::EigenField::EigenCache<float>> &
+  ttk::EigenField::getEigenCache<float>() const {
+  return floatEigenCache_;
+}
+
+template <>
+std::shared_ptr<ttk::EigenField::EigenCache<double>> &
+  ttk::EigenField::getEigenCache<double>() const {
+  return doubleEigenCache_;
+}
+
 #endif // TTK_ENABLE_EIGEN && TTK_ENABLE_SPECTRA
 
 // main routine
@@ -35,51 +58,80 @@ int ttk::EigenField::execute(const TriangulationType &triangulation,
   // number of vertices
   const auto vertexNumber = triangulation.getNumberOfVertices();
 
+  auto &cache = getEigenCache<T>();
+  if(cache == nullptr) {
+    cache = std::make_shared<EigenCache<T>>();
+  }
+
   // graph laplacian of current mesh
-  SpMat lap;
-  // compute graph laplacian using cotangent weights
-  Laplacian::cotanWeights<T>(lap, triangulation);
+  if(cache->triangulation != &triangulation
+     || cache->vertexNumber != vertexNumber) {
+    // compute graph laplacian using cotangent weights
+    Laplacian::cotanWeights<T>(cache->laplacian, triangulation);
+    cache->triangulation = &triangulation;
+    cache->vertexNumber = vertexNumber;
+    cache->eigenvectors.resize(0, 0);
+  }
+  const SpMat &lap = cache->laplacian;
   // lap is square
   eigen_plain_assert(lap.cols() == lap.rows());
 
-  auto n = lap.cols();
-  auto m = eigenNumber;
-  // threshold: minimal number of eigenpairs to get a converging solution
-  const size_t minEigenNumber = 20;
+  if(cache->eigenvectors.rows() == vertexNumber
+     && cache->eigenNumber == eigenNumber) {
+    this->printMsg("Reusing cached eigenfunctions");
+  } else {
+
+    auto n = lap.cols();
+    auto m = eigenNumber;
+    // threshold: minimal number of eigenpairs to get a converging solution
+    const size_t minEigenNumber = 20;
+
+    if(eigenNumber == 0) {
+      // default value
+      m = n / 1000;
+    } else if(eigenNumber < minEigenNumber) {
+      m = minEigenNumber;
+    }
 
-  if(eigenNumber == 0) {
-    // default value
-    m = n / 1000;
-  } else if(eigenNumber < minEigenNumber) {
-    m = minEigenNumber;
-  }
+    Spectra::SparseSymMatProd<T> op(lap);
+    Spectra::SymEigsSolver<T, Spectra::LARGEST_ALGE, decltype(op)> solver(
+      &op, m, 2 * m);
+
+    if(cache->eigenvectors.rows() == vertexNumber) {
+      // warm start: initial residual in the span of the previously
+      // computed eigenvectors
+      Eigen::Matrix<T, Eigen::Dynamic, 1> residual
+        = cache->eigenvectors.rowwise().sum();
+      solver.init(residual.data());
+    } else {
+      solver.init();
+    }
+
+    // number of eigenpairs correctly computed
+    int nconv = solver.compute();
+
+    switch(solver.info()) {
+      case Spectra::COMPUTATION_INFO::NUMERICAL_ISSUE:
+        this->printMsg("Numerical Issue!", ttk::debug::Priority::ERROR);
+        break;
+      case Spectra::COMPUTATION_INFO::NOT_CONVERGING:
+        this->printMsg("No Convergence! (" + std::to_string(nconv)
+                         + " out of " + std::to_string(eigenNumber)
+                         + " values computed)",
+                       ttk::debug::Priority::ERROR);
+        break;
+      case Spectra::COMPUTATION_INFO::NOT_COMPUTED:
+        this->printMsg("Invalid Input!", ttk::debug::Priority::ERROR);
+        break;
+      default:
+        break;
+    }
 
-  Spectra::SparseSymMatProd<T> op(lap);
-  Spectra::SymEigsSolver<T, Spectra::LARGEST_ALGE, decltype(op)> solver(
-    &op, m, 2 * m);
-
-  solver.init();
-
-  // number of eigenpairs correctly computed
-  int nconv = solver.compute();
-
-  switch(solver.info()) {
-    case Spectra::COMPUTATION_INFO::NUMERICAL_ISSUE:
-      this->printMsg("Numerical Issue!", ttk::debug::Priority::ERROR);
-      break;
-    case Spectra::COMPUTATION_INFO::NOT_CONVERGING:
-      this->printMsg("No Convergence! (" + std::to_string(nconv) + " out of "
-                       + std::to_string(eigenNumber) + " values computed)",
-                     ttk::debug::Priority::ERROR);
-      break;
-    case Spectra::COMPUTATION_INFO::NOT_COMPUTED:
-      this->printMsg("Invalid Input!", ttk::debug::Priority::ERROR);
-      break;
-    default:
-      break;
+    cache->eigenvectors = solver.eigenvectors();
+    cache->eigenNumber = eigenNumber;
   }
 
-  DMat eigenvectors = solver.eigenvectors();
+  const DMat &eigenvectors = cache->eigenvectors;
 
   auto outputEigenFunctions = static_cast<T *>(outputFieldPointer);
 
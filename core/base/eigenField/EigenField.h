@@ -17,6 +17,8 @@
 #include <Laplacian.h>
 #include <Triangulation.h>
 
+#include <memory>
+
 namespace ttk {
 
   class EigenField : virtual public Debug {
@@ -38,6 +40,29 @@ namespace ttk {
                 const unsigned int eigenNumber = 500,
                 bool computeStatistics = false,
                 T *const outputStatistics = nullptr) const;
+
+    /**
+     * @brief Release the cached Laplacian matrix and eigenpairs
+     *
+     * The cache is keyed on the triangulation and its size: it should be
+     * cleared when the vertex coordinates change.
+     */
+    inline void clearEigenCache() {
+      floatEigenCache_.reset();
+      doubleEigenCache_.reset();
+    }
+
+  private:
+    // Laplacian matrix and eigenvectors of the previous calls (defined in
+    // EigenField.cpp when Eigen and Spectra are enabled)
+    template <typename T>
+    struct EigenCache;
+
+    template <typename T>
+    std::shared_ptr<EigenCache<T>> &getEigenCache() const;
+
+    mutable std::shared_ptr<EigenCache<float>> floatEigenCache_{};
+    mutable std::shared_ptr<EigenCache<double>> doubleEigenCache_{};
   };
 
 } // namespace ttk
@@ -12,6 +12,55 @@ FiberSurface::FiberSurface() {
   this->setDebugMsgPrefix("FiberSurface");
 }
 
+int FiberSurface::restoreCachedEdges(vector<SimplexId> &missingEdges) const {
+
+  missingEdges.clear();
+
+  for(SimplexId i = 0; i < polygonEdgeNumber_; i++) {
+    const auto it = edgeCache_.find((*polygon_)[i]);
+    if(it == edgeCache_.end()) {
+      missingEdges.push_back(i);
+      continue;
+    }
+
+    // the cached surface may come from another edge index
+    *polygonEdgeVertexLists_[i] = it->second.vertexList_;
+    auto &triangleList = *polygonEdgeTriangleLists_[i];
+    triangleList = it->second.triangleList_;
+    for(auto &triangle : triangleList) {
+      triangle.polygonEdgeId_ = i;
+    }
+  }
+
+  return 0;
+}
+
+int FiberSurface::updateEdgeCache() {
+
+  // only keep the edges of the current polygon
+  map<pair<pair<double, double>, pair<double, double>>, EdgeSurface>
+    edgeCache;
+
+  for(SimplexId i = 0; i < polygonEdgeNumber_; i++) {
+    const auto &edge = (*polygon_)[i];
+    if(edgeCache.find(edge) != edgeCache.end())
+      continue;
+
+    auto &edgeSurface = edgeCache[edge];
+    const auto it = edgeCache_.find(edge);
+    if(it != edgeCache_.end()) {
+      edgeSurface = std::move(it->second);
+    } else {
+      edgeSurface.vertexList_ = *polygonEdgeVertexLists_[i];
+      edgeSurface.triangleList_ = *polygonEdgeTriangleLists_[i];
+    }
+  }
+
+  edgeCache_.swap(edgeCache);
+
+  return 0;
+}
+
 int FiberSurface::getNumberOfCommonVertices(
   const SimplexId &tetId,
   const SimplexId &triangleId0,
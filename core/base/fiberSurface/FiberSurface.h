@@ -47,6 +47,8 @@
 #include <Geometry.h>
 #include <Triangulation.h>
 
+#include <map>
+
 namespace ttk {
 
   class FiberSurface : virtual public Debug {
@@ -119,6 +121,11 @@ namespace ttk {
     }
 #endif
 
+    /// Release the per-edge surfaces kept by the incremental mode
+    inline void flushEdgeCache() {
+      edgeCache_.clear();
+    }
+
     template <class dataTypeU, class dataTypeV, typename triangulationType>
     inline int processTetrahedron(const SimplexId &tetId,
                                   const std::pair<double, double> &rangePoint0,
@@ -133,12 +140,27 @@ namespace ttk {
 
     inline int setInputField(const void *uField, const void *vField) {
 
+      if((uField != uField_) || (vField != vField_))
+        flushEdgeCache();
+
       uField_ = uField;
       vField_ = vField;
 
       return 0;
     }
 
+    /// In incremental mode, the surface of each polygon edge is kept
+    /// between two calls to computeSurface() and only the edges whose
+    /// extremities have changed are extracted again. The cache is flushed
+    /// when another domain (or domain size) or other fields are given, and
+    /// has to be flushed (flushEdgeCache()) when they are modified in place.
+    inline int setIncrementalMode(const bool &onOff) {
+      incrementalMode_ = onOff;
+      if(!onOff)
+        flushEdgeCache();
+      return 0;
+    }
+
     inline int setPointMerging(const bool &onOff) {
       pointSnapping_ = onOff;
       return 0;
@@ -482,7 +504,17 @@ namespace ttk {
       const std::vector<std::pair<SimplexId, SimplexId>> &triangles,
       const double &distanceThreshold) const;
 
-    bool pointSnapping_{false};
+    // surface of a polygon edge, before its merge by finalize()
+    struct EdgeSurface {
+      std::vector<Vertex> vertexList_{};
+      std::vector<Triangle> triangleList_{};
+    };
+
+    int restoreCachedEdges(std::vector<SimplexId> &missingEdges) const;
+
+    int updateEdgeCache();
+
+    bool pointSnapping_{false}, incrementalMode_{false};
 
     SimplexId pointNumber_{}, tetNumber_{}, polygonEdgeNumber_{};
     const void *uField_{}, *vField_{};
@@ -505,6 +537,16 @@ namespace ttk {
 #ifdef TTK_ENABLE_FIBER_SURFACE_WITH_RANGE_OCTREE
     RangeDrivenOctree octree_{};
 #endif
+
+    // per-edge surfaces of the previous call (incremental mode), indexed by
+    // the range coordinates of the edge extremities
+    std::map<std::pair<std::pair<double, double>, std::pair<double, double>>,
+             EdgeSurface>
+      edgeCache_{};
+    // domain of the cached surfaces (triangulation or point set and tet
+    // list) and its numbers of vertices and tetrahedra
+    std::array<const void *, 2> edgeCacheDomain_{};
+    std::array<SimplexId, 2> edgeCacheDomainSize_{};
   };
 } // namespace ttk
 
@@ -1695,25 +1737,60 @@ inline int ttk::FiberSurface::computeSurface(
 
   Timer t;
 
+  // polygon edges to extract (the others are restored from the cache)
+  std::vector<SimplexId> edgeIds;
+  if(incrementalMode_) {
+    // the cached surfaces are only valid on the same domain
+    const std::array<const void *, 2> domain{
+      triangulation ? static_cast<const void *>(triangulation) : pointSet_,
+      triangulation ? nullptr : tetList_};
+    const std::array<SimplexId, 2> domainSize{
+      triangulation ? triangulation->getNumberOfVertices() : pointNumber_,
+      triangulation ? triangulation->getNumberOfCells() : tetNumber_};
+    if(domain != edgeCacheDomain_ || domainSize != edgeCacheDomainSize_) {
+      flushEdgeCache();
+      edgeCacheDomain_ = domain;
+      edgeCacheDomainSize_ = domainSize;
+    }
+    restoreCachedEdges(edgeIds);
+  } else {
+    edgeIds.resize(polygonEdgeNumber_);
+    for(SimplexId i = 0; i < polygonEdgeNumber_; i++)
+      edgeIds[i] = i;
+  }
+  const SimplexId edgeNumber = edgeIds.size();
+
 #ifdef TTK_ENABLE_FIBER_SURFACE_WITH_RANGE_OCTREE
   if(!octree_.empty()) {
 
+    // all the polygon edges are queried in one traversal of the octree
+    std::vector<
+      std::pair<std::pair<double, double>, std::pair<double, double>>>
+      edges(edgeNumber);
+    for(SimplexId i = 0; i < edgeNumber; i++)
+      edges[i] = (*polygon_)[edgeIds[i]];
+    std::vector<std::vector<SimplexId>> tetLists;
+    octree_.rangeSegmentQuery(edges, tetLists);
+
+    // the output lists of an edge are not shared: one thread per edge
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
 #endif
-    for(SimplexId i = 0; i < polygonEdgeNumber_; i++) {
-
-      computeSurfaceWithOctree<dataTypeU, dataTypeV>(
-        (*polygon_)[i].first, (*polygon_)[i].second, triangulation, i);
+    for(SimplexId i = 0; i < edgeNumber; i++) {
+      for(const auto tetId : tetLists[i]) {
+        processTetrahedron<dataTypeU, dataTypeV>(
+          tetId, edges[i].first, edges[i].second, triangulation, edgeIds[i]);
+      }
     }
   } else {
     // regular extraction (the octree has not been computed)
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
-    for(SimplexId i = 0; i < polygonEdgeNumber_; i++) {
+    for(SimplexId i = 0; i < edgeNumber; i++) {
+      const auto &edge = (*polygon_)[edgeIds[i]];
       computeSurface<dataTypeU, dataTypeV>(
-        (*polygon_)[i].first, (*polygon_)[i].second, triangulation, i);
+        edge.first, edge.second, triangulation, edgeIds[i]);
     }
   }
 
@@ -1721,13 +1798,20 @@ inline int ttk::FiberSurface::computeSurface(
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
-  for(SimplexId i = 0; i < polygonEdgeNumber_; i++) {
-
+  for(SimplexId i = 0; i < edgeNumber; i++) {
+    const auto &edge = (*polygon_)[edgeIds[i]];
     computeSurface<dataTypeU, dataTypeV>(
-      (*polygon_)[i].first, (*polygon_)[i].second, i);
+      edge.first, edge.second, triangulation, edgeIds[i]);
   }
 #endif
 
+  if(incrementalMode_) {
+    this->printMsg("Extracted " + std::to_string(edgeNumber) + "/"
+                     + std::to_string(polygonEdgeNumber_) + " polygon edges",
+                   debug::Priority::DETAIL);
+    updateEdgeCache();
+  }
+
   finalize<dataTypeU, dataTypeV>(pointSnapping_, false, false, false);
 
   this->printMsg("Extracted", 1.0, t.getElapsedTime(), this->threadNumber_);
@@ -1,9 +1,48 @@
 #include <HarmonicField.h>
 #include <Laplacian.h>
-#include <set>
+#include <map>
 
 #ifdef TTK_ENABLE_EIGEN
 #include <Eigen/Sparse>
+
+template <typename T>
+struct ttk::HarmonicField::SolverCache {
+  using SpMat = Eigen::SparseMatrix<T>;
+
+  // the Laplacian matrix depends on the triangulation and on the weights
+  const void *triangulation{};
+  SimplexId vertexNumber{}, edgeNumber{};
+  bool useCotanWeights{};
+  SpMat laplacian{};
+
+  // the factorized system also depends on the constraint vertices (not on
+  // the constraint values, which only appear in the right-hand side)
+  bool isFactorized{false};
+  std::vector<SimplexId> constraintIds{};
+  T alpha{};
+  SolvingMethodType solvingMethod{};
+  SpMat system{};
+  // the symbolic analysis only depends on the sparsity pattern of the
+  // Laplacian matrix and is kept when the constraint vertices change
+  bool isPatternAnalyzed{false};
+  Eigen::SimplicialCholesky<SpMat> cholesky{};
+  Eigen::ConjugateGradient<SpMat, Eigen::Upper | Eigen::Lower>
+    conjugateGradient{};
+  // previous solution, initial guess of the iterative solver
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> solution{};
+};
+
+template <>
+std::shared_ptr<ttk::HarmonicField::SolverCache<float>> &
+  ttk::HarmonicField::getSolverCache<float>() const {
+  return floatSolverCache_;
+}
+
+template <>
+std::shared_ptr<ttk::HarmonicField::SolverCache<double>> &
+  ttk::HarmonicField::getSolverCache<double>() const {
+  return doubleSolverCache_;
+}
 #endif // TTK_ENABLE_EIGEN
 
 ttk::HarmonicField::SolvingMethodType
@@ -21,18 +60,6 @@ ttk::HarmonicField::SolvingMethodType
   return SolvingMethodType::CHOLESKY;
 }
 
-template <typename SparseMatrixType,
-          typename SparseVectorType,
-          typename SolverType>
-int ttk::HarmonicField::solve(SparseMatrixType const &lap,
-                              SparseMatrixType const &penalty,
-                              SparseVectorType const &constraints,
-                              SparseMatrixType &sol) const {
-  SolverType solver(lap - penalty);
-  sol = solver.solve(penalty * constraints);
-  return solver.info();
-}
-
 // main routine
 template <class T, class TriangulationType>
 int ttk::HarmonicField::execute(const TriangulationType &triangulation,
@@ -43,6 +70,27 @@ int ttk::HarmonicField::execute(const TriangulationType &triangulation,
                                 bool useCotanWeights,
                                 SolvingMethodUserType solvingMethod,
                                 double logAlpha) const {
+  return executeMultiple(triangulation, constraintNumber, sources, constraints,
+                         1, outputScalarField, useCotanWeights, solvingMethod,
+                         logAlpha);
+}
+
+template <class T, class TriangulationType>
+int ttk::HarmonicField::executeMultiple(const TriangulationType &triangulation,
+                                        SimplexId constraintNumber,
+                                        SimplexId *sources,
+                                        T *constraints,
+                                        int fieldNumber,
+                                        T *outputScalarFields,
+                                        bool useCotanWeights,
+                                        SolvingMethodUserType solvingMethod,
+                                        double logAlpha) const {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(fieldNumber < 1) {
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
 
 #ifdef TTK_ENABLE_EIGEN
 
@@ -51,7 +99,7 @@ int ttk::HarmonicField::execute(const TriangulationType &triangulation,
 #endif // TTK_ENABLE_OPENMP
 
   using SpMat = Eigen::SparseMatrix<T>;
-  using SpVec = Eigen::SparseVector<T>;
+  using DMat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
   using TripletType = Eigen::Triplet<T>;
 
   Timer tm;
@@ -91,67 +139,121 @@ int ttk::HarmonicField::execute(const TriangulationType &triangulation,
 
   this->printMsg(begMsg);
 
-  // filter unique constraint identifiers
-  std::set<SimplexId> uniqueIdentifiersSet;
+  // filter unique constraint identifiers (sorted), mapped to their first
+  // occurrence in the input constraints
+  std::map<SimplexId, SimplexId> firstOccurrences{};
   for(SimplexId i = 0; i < constraintNumber; ++i) {
-    uniqueIdentifiersSet.insert(sources[i]);
+    firstOccurrences.emplace(sources[i], i);
   }
 
-  // (constraint id, scalar field value)
-  std::vector<std::pair<SimplexId, T>> idValues{};
-
-  for(const auto id : uniqueIdentifiersSet) {
-    for(SimplexId j = 0; j < constraintNumber; ++j) {
-      if(id == sources[j]) {
-        idValues.emplace_back(id, constraints[j]);
-        break;
-      }
-    }
+  std::vector<SimplexId> constraintIds{};
+  constraintIds.reserve(firstOccurrences.size());
+  for(const auto &pair : firstOccurrences) {
+    constraintIds.emplace_back(pair.first);
   }
 
-  // unique constraint number
-  size_t uniqueConstraintNumber = idValues.size();
+  // penalty value
+  const T alpha = Geometry::powIntTen(logAlpha);
+
+  auto &cache = getSolverCache<T>();
+  if(cache == nullptr) {
+    cache = std::make_shared<SolverCache<T>>();
+  }
 
   // graph laplacian of current mesh
-  SpMat lap;
-  if(useCotanWeights) {
-    Laplacian::cotanWeights<T>(lap, triangulation);
+  if(cache->triangulation != &triangulation
+     || cache->vertexNumber != vertexNumber
+     || cache->edgeNumber != edgeNumber
+     || cache->useCotanWeights != useCotanWeights) {
+    if(useCotanWeights) {
+      Laplacian::cotanWeights<T>(cache->laplacian, triangulation);
+    } else {
+      Laplacian::discreteLaplacian<T>(cache->laplacian, triangulation);
+    }
+    cache->triangulation = &triangulation;
+    cache->vertexNumber = vertexNumber;
+    cache->edgeNumber = edgeNumber;
+    cache->useCotanWeights = useCotanWeights;
+    cache->isFactorized = false;
+    cache->isPatternAnalyzed = false;
+    cache->solution.resize(0, 0);
   } else {
-    Laplacian::discreteLaplacian<T>(lap, triangulation);
+    this->printMsg("Reusing cached Laplacian matrix", debug::Priority::DETAIL);
   }
 
-  // constraints vector
-  SpVec constraintsMat(vertexNumber);
-  for(const auto &pair : idValues) {
-    // put constraint at identifier index
-    constraintsMat.coeffRef(pair.first) = pair.second;
-  }
+  int res = 0;
 
-  // penalty matrix
-  SpMat penalty(vertexNumber, vertexNumber);
-  // penalty value
-  const T alpha = Geometry::powIntTen(logAlpha);
+  // factorize the system matrix (laplacian - penalty) when the constraint
+  // vertices change
+  if(!cache->isFactorized || cache->constraintIds != constraintIds
+     || cache->alpha != alpha || cache->solvingMethod != sm) {
+
+    // penalty matrix
+    SpMat penalty(vertexNumber, vertexNumber);
+    std::vector<TripletType> triplets;
+    triplets.reserve(constraintIds.size());
+    for(const auto id : constraintIds) {
+      triplets.emplace_back(TripletType(id, id, alpha));
+    }
+    penalty.setFromTriplets(triplets.begin(), triplets.end());
+
+    cache->system = cache->laplacian - penalty;
+
+    switch(sm) {
+      case SolvingMethodType::CHOLESKY:
+        if(!cache->isPatternAnalyzed) {
+          cache->cholesky.analyzePattern(cache->system);
+          cache->isPatternAnalyzed = true;
+        }
+        cache->cholesky.factorize(cache->system);
+        res = cache->cholesky.info();
+        break;
+      case SolvingMethodType::ITERATIVE:
+        cache->conjugateGradient.compute(cache->system);
+        res = cache->conjugateGradient.info();
+        break;
+    }
 
-  std::vector<TripletType> triplets;
-  triplets.reserve(uniqueConstraintNumber);
-  for(const auto &pair : idValues) {
-    triplets.emplace_back(TripletType(pair.first, pair.first, alpha));
+    cache->isFactorized = (res == Eigen::ComputationInfo::Success);
+    cache->constraintIds = std::move(constraintIds);
+    cache->alpha = alpha;
+    cache->solvingMethod = sm;
+  } else {
+    this->printMsg("Reusing cached factorization", debug::Priority::DETAIL);
   }
-  penalty.setFromTriplets(triplets.begin(), triplets.end());
 
-  int res = 0;
-  SpMat sol;
+  // right-hand sides (penalty * constraints), one column per field
+  DMat rhs = DMat::Zero(vertexNumber, fieldNumber);
+  for(const auto &pair : firstOccurrences) {
+    for(int j = 0; j < fieldNumber; ++j) {
+      rhs(pair.first, j) = alpha * constraints[pair.second * fieldNumber + j];
+    }
+  }
 
-  switch(sm) {
-    case SolvingMethodType::CHOLESKY:
-      res = solve<SpMat, SpVec, Eigen::SimplicialCholesky<SpMat>>(
-        lap, penalty, constraintsMat, sol);
-      break;
-    case SolvingMethodType::ITERATIVE:
-      res = solve<SpMat, SpVec,
-                  Eigen::ConjugateGradient<SpMat, Eigen::Upper | Eigen::Lower>>(
-        lap, penalty, constraintsMat, sol);
-      break;
+  DMat sol;
+
+  if(cache->isFactorized) {
+    switch(sm) {
+      case SolvingMethodType::CHOLESKY:
+        sol = cache->cholesky.solve(rhs);
+        res = cache->cholesky.info();
+        break;
+      case SolvingMethodType::ITERATIVE:
+        // warm start from the previous solution
+        if(cache->solution.rows() == vertexNumber
+           && cache->solution.cols() == fieldNumber) {
+          sol = cache->conjugateGradient.solveWithGuess(rhs, cache->solution);
+        } else {
+          sol = cache->conjugateGradient.solve(rhs);
+        }
+        res = cache->conjugateGradient.info();
+        if(res == Eigen::ComputationInfo::Success) {
+          cache->solution = sol;
+        }
+        break;
+    }
+  } else {
+    sol = DMat::Zero(vertexNumber, fieldNumber);
   }
 
   auto info = static_cast<Eigen::ComputationInfo>(res);
@@ -169,16 +271,15 @@ int ttk::HarmonicField::execute(const TriangulationType &triangulation,
       break;
   }
 
-  // convert to dense Eigen matrix
-  Eigen::Matrix<T, Eigen::Dynamic, 1> solDense(sol);
-
   // copy solver solution into output array
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber; ++i) {
-    // cannot avoid copy here...
-    outputScalarField[i] = -solDense(i, 0);
+    for(int j = 0; j < fieldNumber; ++j) {
+      // cannot avoid copy here...
+      outputScalarFields[i * fieldNumber + j] = -sol(i, j);
+    }
   }
 
   this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
@@ -199,7 +300,10 @@ int ttk::HarmonicField::execute(const TriangulationType &triangulation,
 #define HARMONICFIELD_SPECIALIZE(TYPE)                                   \
   template int ttk::HarmonicField::execute<TYPE>(                        \
     const Triangulation &, SimplexId, SimplexId *, TYPE *, TYPE *, bool, \
-    SolvingMethodUserType, double) const
+    SolvingMethodUserType, double) const;                                \
+  template int ttk::HarmonicField::executeMultiple<TYPE>(                \
+    const Triangulation &, SimplexId, SimplexId *, TYPE *, int, TYPE *,  \
+    bool, SolvingMethodUserType, double) const
 
 HARMONICFIELD_SPECIALIZE(float);
 HARMONICFIELD_SPECIALIZE(double);
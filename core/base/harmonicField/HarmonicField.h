@@ -16,6 +16,8 @@
 // base code includes
 #include <Triangulation.h>
 
+#include <memory>
+
 namespace ttk {
 
   class HarmonicField : virtual public Debug {
@@ -49,16 +51,52 @@ namespace ttk {
                 = SolvingMethodUserType::AUTO,
                 double logAlpha = 5.0) const;
 
+    /**
+     * @brief Compute several harmonic fields sharing the same constraint
+     * vertices with a single factorization (one right-hand side per field)
+     *
+     * @param[in] constraints fieldNumber values per source (interleaved)
+     * @param[out] outputScalarFields fieldNumber values per vertex
+     * (interleaved)
+     *
+     * @return 0 in case of success
+     */
+    template <class T, class TriangulationType = AbstractTriangulation>
+    int executeMultiple(const TriangulationType &triangulation,
+                        SimplexId constraintNumber,
+                        SimplexId *sources,
+                        T *constraints,
+                        int fieldNumber,
+                        T *outputScalarFields,
+                        bool useCotanWeights = true,
+                        SolvingMethodUserType solvingMethod
+                        = SolvingMethodUserType::AUTO,
+                        double logAlpha = 5.0) const;
+
+    /**
+     * @brief Release the cached Laplacian matrix and factorization
+     *
+     * The cache is keyed on the triangulation, its size and the weighting
+     * scheme: it should be cleared when the vertex coordinates change.
+     */
+    inline void clearSolverCache() {
+      floatSolverCache_.reset();
+      doubleSolverCache_.reset();
+    }
+
   private:
     SolvingMethodType findBestSolver(const SimplexId vertexNumber,
                                      const SimplexId edgeNumber) const;
 
-    template <typename SparseMatrixType,
-              typename SparseVectorType,
-              typename SolverType>
-    int solve(SparseMatrixType const &lap,
-              SparseMatrixType const &penalty,
-              SparseVectorType const &constraints,
-              SparseMatrixType &sol) const;
+    // Laplacian matrix and factorized system of the previous calls
+    // (defined in HarmonicField.cpp when Eigen is enabled)
+    template <typename T>
+    struct SolverCache;
+
+    template <typename T>
+    std::shared_ptr<SolverCache<T>> &getSolverCache() const;
+
+    mutable std::shared_ptr<SolverCache<float>> floatSolverCache_{};
+    mutable std::shared_ptr<SolverCache<double>> doubleSolverCache_{};
   };
 } // namespace ttk
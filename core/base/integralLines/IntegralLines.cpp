@@ -10,3 +10,61 @@ IntegralLines::IntegralLines()
 }
 
 IntegralLines::~IntegralLines() = default;
+
+std::vector<SimplexId> IntegralLines::getSeeds() const {
+  const SimplexId *identifiers
+    = static_cast<SimplexId *>(vertexIdentifierScalarField_);
+
+  std::unordered_set<SimplexId> isSeed;
+  for(SimplexId k = 0; k < seedNumber_; ++k)
+    isSeed.insert(identifiers[k]);
+  std::vector<SimplexId> seeds;
+  for(auto k : isSeed)
+    seeds.push_back(k);
+
+  return seeds;
+}
+
+void IntegralLines::computeExtrema(SharedTrajectories &shared) const {
+  const SimplexId n = shared.vertices.size();
+
+  // jump[i]: furthest vertex reached so far from i, distance[i]: the length
+  // of the line between them (the extrema point to themselves)
+  std::vector<SimplexId> jump(n), nextJump(n);
+  std::vector<float> nextDistance(n);
+  auto &distance = shared.distanceToExtremum;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; ++i)
+    jump[i] = shared.next[i] == -1 ? i : shared.next[i];
+
+  bool changed = true;
+  while(changed) {
+    changed = false;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(|| : changed)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < n; ++i) {
+      const SimplexId j = jump[i];
+      if(jump[j] != j) {
+        nextJump[i] = jump[j];
+        nextDistance[i] = distance[i] + distance[j];
+        changed = true;
+      } else {
+        nextJump[i] = j;
+        nextDistance[i] = distance[i];
+      }
+    }
+    std::swap(jump, nextJump);
+    std::swap(distance, nextDistance);
+  }
+
+  shared.extremum.resize(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < n; ++i)
+    shared.extremum[i] = shared.vertices[jump[i]];
+}
@@ -9,6 +9,13 @@
 /// Given a list of sources, the package produces forward or backward integral
 /// lines along the edges of the input triangulation.
 ///
+/// The lines of the seeds are traced in parallel. With shared paths, the
+/// successor of each vertex is computed only once (by the thread that reaches
+/// it first) and the tracing of a seed stops as soon as it reaches a vertex
+/// already visited: the lines are then stored as a forest in which merging
+/// lines share their suffix (see SharedTrajectories). The extremum reached by
+/// each vertex and its distance to it are computed by pointer jumping.
+///
 /// \sa ttkIntegralLines.cpp %for a usage example.
 
 #pragma once
@@ -26,6 +33,21 @@ namespace ttk {
   class IntegralLines : virtual public Debug {
 
   public:
+    /// Integral lines stored as a forest, each visited vertex once
+    struct SharedTrajectories {
+      /// visited vertices (identifiers in the triangulation)
+      std::vector<SimplexId> vertices{};
+      /// index of the successor of each visited vertex in vertices (-1 for
+      /// the extrema ending the lines)
+      std::vector<SimplexId> next{};
+      /// extremum ending the line of each visited vertex
+      std::vector<SimplexId> extremum{};
+      /// curvilinear distance between each visited vertex and its extremum
+      std::vector<float> distanceToExtremum{};
+      /// index of each seed in vertices
+      std::vector<SimplexId> seeds{};
+    };
+
     IntegralLines();
     ~IntegralLines() override;
 
@@ -45,16 +67,36 @@ namespace ttk {
     inline float getGradient(const triangulationType *triangulation,
                              const SimplexId &a,
                              const SimplexId &b,
-                             dataType *scalars) const {
+                             const dataType *scalars) const {
       return fabs(scalars[b] - scalars[a])
              / getDistance<triangulationType>(triangulation, a, b);
     }
 
+    /**
+     * @brief Successor of a vertex along its integral line
+     * @return -1 if the vertex is an extremum
+     */
+    template <typename dataType, typename idType, class triangulationType>
+    SimplexId getNextVertex(const triangulationType *triangulation,
+                            const SimplexId &v,
+                            const dataType *scalars,
+                            const idType *offsets) const;
+
     template <typename dataType,
               typename idType,
               class triangulationType = ttk::AbstractTriangulation>
     int execute(const triangulationType *) const;
 
+    /**
+     * @brief Trace the integral lines as a forest with shared suffixes
+     *
+     * The output is given by setOutputSharedTrajectories().
+     */
+    template <typename dataType,
+              typename idType,
+              class triangulationType = ttk::AbstractTriangulation>
+    int executeShared(const triangulationType *) const;
+
     template <typename dataType,
               typename idType,
               class Compare,
@@ -102,7 +144,24 @@ namespace ttk {
       return 0;
     }
 
+    inline int
+      setOutputSharedTrajectories(SharedTrajectories *sharedTrajectories) {
+      outputSharedTrajectories_ = sharedTrajectories;
+      return 0;
+    }
+
   protected:
+    /// Identifiers of the seeds, without duplicates
+    std::vector<SimplexId> getSeeds() const;
+
+    /**
+     * @brief Extremum and distance to it of the vertices of a forest
+     *
+     * Pointer jumping: each round doubles the number of edges covered by
+     * the pointers, hence O(log n) parallel rounds for lines of n vertices.
+     */
+    void computeExtrema(SharedTrajectories &shared) const;
+
     SimplexId vertexNumber_;
     SimplexId seedNumber_;
     int direction_;
@@ -110,94 +169,183 @@ namespace ttk {
     void *inputOffsets_;
     void *vertexIdentifierScalarField_;
     std::vector<std::vector<SimplexId>> *outputTrajectories_;
+    SharedTrajectories *outputSharedTrajectories_{};
   };
 } // namespace ttk
 
+template <typename dataType, typename idType, class triangulationType>
+ttk::SimplexId
+  ttk::IntegralLines::getNextVertex(const triangulationType *triangulation,
+                                    const SimplexId &v,
+                                    const dataType *scalars,
+                                    const idType *offsets) const {
+  SimplexId vnext{-1};
+  float fnext = std::numeric_limits<float>::min();
+  SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
+  bool isLocalMax = true;
+  bool isLocalMin = true;
+  for(SimplexId k = 0; k < neighborNumber; ++k) {
+    SimplexId n;
+    triangulation->getVertexNeighbor(v, k, n);
+
+    if(scalars[n] <= scalars[v])
+      isLocalMax = false;
+    if(scalars[n] >= scalars[v])
+      isLocalMin = false;
+
+    if((direction_ == static_cast<int>(Direction::Forward))
+       xor (scalars[n] < scalars[v])) {
+      const float f = getGradient<dataType, triangulationType>(
+        triangulation, v, n, scalars);
+      if(f > fnext) {
+        vnext = n;
+        fnext = f;
+      }
+    }
+  }
+
+  if(vnext == -1 and !isLocalMax and !isLocalMin) {
+    idType onext = -1;
+    for(SimplexId k = 0; k < neighborNumber; ++k) {
+      SimplexId n;
+      triangulation->getVertexNeighbor(v, k, n);
+
+      if(scalars[n] == scalars[v]) {
+        const idType o = offsets[n];
+        if((direction_ == static_cast<int>(Direction::Forward))
+           xor (o < offsets[v])) {
+          if(o > onext) {
+            vnext = n;
+            onext = o;
+          }
+        }
+      }
+    }
+  }
+
+  return vnext;
+}
+
 template <typename dataType, typename idType, class triangulationType>
 int ttk::IntegralLines::execute(const triangulationType *triangulation) const {
-  idType *offsets = static_cast<idType *>(inputOffsets_);
-  SimplexId *identifiers
-    = static_cast<SimplexId *>(vertexIdentifierScalarField_);
-  dataType *scalars = static_cast<dataType *>(inputScalarField_);
+  const idType *offsets = static_cast<idType *>(inputOffsets_);
+  const dataType *scalars = static_cast<dataType *>(inputScalarField_);
   std::vector<std::vector<SimplexId>> *trajectories = outputTrajectories_;
 
   Timer t;
 
-  // get the seeds
-  std::unordered_set<SimplexId> isSeed;
-  for(SimplexId k = 0; k < seedNumber_; ++k)
-    isSeed.insert(identifiers[k]);
-  std::vector<SimplexId> seeds;
-  for(auto k : isSeed)
-    seeds.push_back(k);
-  isSeed.clear();
+  const std::vector<SimplexId> seeds = getSeeds();
 
   trajectories->resize(seeds.size());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < (SimplexId)seeds.size(); ++i) {
     SimplexId v{seeds[i]};
     (*trajectories)[i].push_back(v);
 
-    bool isMax{};
-    while(!isMax) {
-      SimplexId vnext{-1};
-      float fnext = std::numeric_limits<float>::min();
-      SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
-      bool isLocalMax = true;
-      bool isLocalMin = true;
-      for(SimplexId k = 0; k < neighborNumber; ++k) {
-        SimplexId n;
-        triangulation->getVertexNeighbor(v, k, n);
-
-        if(scalars[n] <= scalars[v])
-          isLocalMax = false;
-        if(scalars[n] >= scalars[v])
-          isLocalMin = false;
+    while(true) {
+      v = getNextVertex<dataType, idType, triangulationType>(
+        triangulation, v, scalars, offsets);
+      if(v == -1)
+        break;
+      (*trajectories)[i].push_back(v);
+    }
+  }
 
-        if((direction_ == static_cast<int>(Direction::Forward))
-           xor (scalars[n] < scalars[v])) {
-          const float f = getGradient<dataType, triangulationType>(
-            triangulation, v, n, scalars);
-          if(f > fnext) {
-            vnext = n;
-            fnext = f;
-          }
-        }
-      }
+  {
+    std::stringstream msg;
+    msg << "Processed " << vertexNumber_ << " points";
+    this->printMsg(msg.str(), 1, t.getElapsedTime(), threadNumber_);
+  }
 
-      if(vnext == -1 and !isLocalMax and !isLocalMin) {
-        idType onext = -1;
-        for(SimplexId k = 0; k < neighborNumber; ++k) {
-          SimplexId n;
-          triangulation->getVertexNeighbor(v, k, n);
-
-          if(scalars[n] == scalars[v]) {
-            const idType o = offsets[n];
-            if((direction_ == static_cast<int>(Direction::Forward))
-               xor (o < offsets[v])) {
-              if(o > onext) {
-                vnext = n;
-                onext = o;
-              }
-            }
-          }
-        }
-      }
+  return 0;
+}
+
+template <typename dataType, typename idType, class triangulationType>
+int ttk::IntegralLines::executeShared(
+  const triangulationType *triangulation) const {
+  const idType *offsets = static_cast<idType *>(inputOffsets_);
+  const dataType *scalars = static_cast<dataType *>(inputScalarField_);
+  SharedTrajectories &shared = *outputSharedTrajectories_;
+
+  Timer t;
+
+  const std::vector<SimplexId> seeds = getSeeds();
+
+  // a vertex is claimed by the first thread reaching it, which computes its
+  // successor: the lines reaching it afterwards stop there
+  std::vector<char> isVisited(vertexNumber_, 0);
+  std::vector<SimplexId> nextVertex(vertexNumber_, -1);
+  std::vector<std::vector<SimplexId>> threadVertices(threadNumber_);
 
-      if(vnext == -1)
-        isMax = true;
-      else {
-        v = vnext;
-        (*trajectories)[i].push_back(v);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < (SimplexId)seeds.size(); ++i) {
+#ifdef TTK_ENABLE_OPENMP
+    auto &visited = threadVertices[omp_get_thread_num()];
+#else
+    auto &visited = threadVertices[0];
+#endif // TTK_ENABLE_OPENMP
+    SimplexId v{seeds[i]};
+    while(v != -1) {
+      char wasVisited;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+      {
+        wasVisited = isVisited[v];
+        isVisited[v] = 1;
       }
+      if(wasVisited)
+        break;
+      visited.push_back(v);
+      nextVertex[v] = getNextVertex<dataType, idType, triangulationType>(
+        triangulation, v, scalars, offsets);
+      v = nextVertex[v];
     }
   }
 
-  {
-    std::stringstream msg;
-    msg << "Processed " << vertexNumber_ << " points";
-    this->printMsg(msg.str(), 1, t.getElapsedTime(), 1);
+  // compact storage of the visited vertices
+  shared.vertices.clear();
+  for(const auto &visited : threadVertices)
+    shared.vertices.insert(shared.vertices.end(), visited.begin(),
+                           visited.end());
+  threadVertices.clear();
+
+  const SimplexId visitedNumber = shared.vertices.size();
+  std::vector<SimplexId> localId(vertexNumber_, -1);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < visitedNumber; ++i)
+    localId[shared.vertices[i]] = i;
+
+  shared.next.resize(visitedNumber);
+  shared.distanceToExtremum.resize(visitedNumber);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < visitedNumber; ++i) {
+    const SimplexId v = shared.vertices[i];
+    const SimplexId n = nextVertex[v];
+    shared.next[i] = n == -1 ? -1 : localId[n];
+    shared.distanceToExtremum[i]
+      = n == -1 ? 0.0f
+                : getDistance<triangulationType>(triangulation, v, n);
   }
 
+  shared.seeds.resize(seeds.size());
+  for(size_t i = 0; i < seeds.size(); ++i)
+    shared.seeds[i] = localId[seeds[i]];
+
+  computeExtrema(shared);
+
+  this->printMsg("Processed " + std::to_string(seeds.size()) + " seeds ("
+                   + std::to_string(visitedNumber) + " shared vertices)",
+                 1, t.getElapsedTime(), threadNumber_);
+
   return 0;
 }
 
@@ -207,83 +355,27 @@ template <typename dataType,
           class triangulationType>
 int ttk::IntegralLines::execute(Compare cmp,
                                 const triangulationType *triangulation) const {
-  idType *offsets = static_cast<idType *>(inputOffsets_);
-  SimplexId *identifiers
-    = static_cast<SimplexId *>(vertexIdentifierScalarField_);
-  dataType *scalars = static_cast<dataType *>(inputScalarField_);
+  const idType *offsets = static_cast<idType *>(inputOffsets_);
+  const dataType *scalars = static_cast<dataType *>(inputScalarField_);
   std::vector<std::vector<SimplexId>> *trajectories = outputTrajectories_;
 
   Timer t;
 
-  // get the seeds
-  std::unordered_set<SimplexId> isSeed;
-  for(SimplexId k = 0; k < seedNumber_; ++k)
-    isSeed.insert(identifiers[k]);
-  std::vector<SimplexId> seeds;
-  for(auto k : isSeed)
-    seeds.push_back(k);
-  isSeed.clear();
+  const std::vector<SimplexId> seeds = getSeeds();
 
   trajectories->resize(seeds.size());
   for(SimplexId i = 0; i < (SimplexId)seeds.size(); ++i) {
     SimplexId v{seeds[i]};
     (*trajectories)[i].push_back(v);
 
-    bool isMax{};
-    while(!isMax) {
-      SimplexId vnext{-1};
-      float fnext = std::numeric_limits<float>::min();
-      SimplexId neighborNumber = triangulation->getVertexNeighborNumber(v);
-      bool isLocalMax = true;
-      bool isLocalMin = true;
-      for(SimplexId k = 0; k < neighborNumber; ++k) {
-        SimplexId n;
-        triangulation->getVertexNeighbor(v, k, n);
-
-        if(scalars[n] <= scalars[v])
-          isLocalMax = false;
-        if(scalars[n] >= scalars[v])
-          isLocalMin = false;
-
-        if((direction_ == static_cast<int>(Direction::Forward))
-           xor (scalars[n] < scalars[v])) {
-          const float f
-            = getGradient<dataType, triangulationType>(v, n, scalars);
-          if(f > fnext) {
-            vnext = n;
-            fnext = f;
-          }
-        }
-      }
-
-      if(vnext == -1 and !isLocalMax and !isLocalMin) {
-        SimplexId onext = -1;
-        for(SimplexId k = 0; k < neighborNumber; ++k) {
-          SimplexId n;
-          triangulation->getVertexNeighbor(v, k, n);
-
-          if(scalars[n] == scalars[v]) {
-            const SimplexId o = offsets[n];
-            if((direction_ == static_cast<int>(Direction::Forward))
-               xor (o < offsets[v])) {
-              if(o > onext) {
-                vnext = n;
-                onext = o;
-              }
-            }
-          }
-        }
-      }
-
-      if(vnext == -1)
-        isMax = true;
-      else {
-        v = vnext;
-        (*trajectories)[i].push_back(v);
-
-        if(cmp(v))
-          isMax = true;
-      }
+    while(true) {
+      v = getNextVertex<dataType, idType, triangulationType>(
+        triangulation, v, scalars, offsets);
+      if(v == -1)
+        break;
+      (*trajectories)[i].push_back(v);
+      if(cmp(v))
+        break;
     }
   }
 
@@ -42,6 +42,14 @@ namespace ttk {
                 const dataTypeV *const vField,
                 const triangulationType &triangulation);
 
+    /// Same as above but only stores the identifiers of the Jacobi edges
+    /// (smaller memory footprint when the edge types are not needed).
+    template <class dataTypeU, class dataTypeV, typename triangulationType>
+    int execute(std::vector<SimplexId> &jacobiSet,
+                const dataTypeU *const uField,
+                const dataTypeV *const vField,
+                const triangulationType &triangulation);
+
     template <class dataTypeU, class dataTypeV, typename triangulationType>
     char getCriticalType(const SimplexId &edgeId,
                          const dataTypeU *const uField,
@@ -103,6 +111,47 @@ namespace ttk {
     }
 
   protected:
+    template <class itemType,
+              class dataTypeU,
+              class dataTypeV,
+              typename triangulationType>
+    int computeJacobiSet(std::vector<itemType> &jacobiSet,
+                         const dataTypeU *const uField,
+                         const dataTypeV *const vField,
+                         const triangulationType &triangulation);
+
+    /// Classify an edge from its link, using caller-provided buffers of
+    /// size 2 * starNumber (link vertices, sides and union-find parents)
+    /// and 2 * starNumber (link edges).
+    template <class dataTypeU, class dataTypeV, typename triangulationType>
+    char classifyEdgeLink(const SimplexId &edgeId,
+                          const SimplexId &starNumber,
+                          const dataTypeU *const uField,
+                          const dataTypeV *const vField,
+                          const triangulationType &triangulation,
+                          SimplexId *const linkVertices,
+                          signed char *const linkSides,
+                          SimplexId *const linkParents,
+                          SimplexId *const linkEdges) const;
+
+    static inline void
+      addJacobiEdge(std::vector<std::pair<SimplexId, char>> &jacobiSet,
+                    const SimplexId edgeId,
+                    const char type) {
+      jacobiSet.emplace_back(edgeId, type);
+    }
+
+    static inline void addJacobiEdge(std::vector<SimplexId> &jacobiSet,
+                                     const SimplexId edgeId,
+                                     const char /*type*/) {
+      jacobiSet.emplace_back(edgeId);
+    }
+
+    // edges with larger stars fall back to heap-allocated link buffers
+    static const SimplexId linkBufferSize_ = 32;
+    // number of edges processed by each parallel task
+    static const SimplexId edgeChunkSize_ = 4096;
+
     template <class dataTypeU, class dataTypeV, typename triangulationType>
     int executeLegacy(std::vector<std::pair<SimplexId, char>> &jacobiSet,
                       const dataTypeU *const uField,
@@ -6,16 +6,52 @@ int ttk::JacobiSet::execute(std::vector<std::pair<SimplexId, char>> &jacobiSet,
                             const dataTypeV *const vField,
                             const triangulationType &triangulation) {
 
+#ifndef TTK_ENABLE_KAMIKAZE
+  if((triangulation.isEmpty()) && (vertexNumber_)) {
+    return executeLegacy(jacobiSet, uField, vField, triangulation);
+  }
+#endif
+
+  return computeJacobiSet(jacobiSet, uField, vField, triangulation);
+}
+
+template <class dataTypeU, class dataTypeV, typename triangulationType>
+int ttk::JacobiSet::execute(std::vector<SimplexId> &jacobiSet,
+                            const dataTypeU *const uField,
+                            const dataTypeV *const vField,
+                            const triangulationType &triangulation) {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if((triangulation.isEmpty()) && (vertexNumber_)) {
+    std::vector<std::pair<SimplexId, char>> jacobiEdges{};
+    const int ret
+      = executeLegacy(jacobiEdges, uField, vField, triangulation);
+    jacobiSet.resize(jacobiEdges.size());
+    for(size_t i = 0; i < jacobiEdges.size(); i++) {
+      jacobiSet[i] = jacobiEdges[i].first;
+    }
+    return ret;
+  }
+#endif
+
+  return computeJacobiSet(jacobiSet, uField, vField, triangulation);
+}
+
+template <class itemType,
+          class dataTypeU,
+          class dataTypeV,
+          typename triangulationType>
+int ttk::JacobiSet::computeJacobiSet(std::vector<itemType> &jacobiSet,
+                                     const dataTypeU *const uField,
+                                     const dataTypeV *const vField,
+                                     const triangulationType &triangulation) {
+
   Timer t;
 
   // check the consistency of the variables -- to adapt
 #ifndef TTK_ENABLE_KAMIKAZE
-  if((triangulation.isEmpty())) {
-    if(vertexNumber_) {
-      return executeLegacy(jacobiSet, uField, vField, triangulation);
-    }
+  if((triangulation.isEmpty()))
     return -1;
-  }
   if(!uField)
     return -2;
   if(!vField)
@@ -54,52 +90,58 @@ int ttk::JacobiSet::execute(std::vector<std::pair<SimplexId, char>> &jacobiSet,
 
   SimplexId edgeNumber = triangulation.getNumberOfEdges();
 
-  std::vector<std::vector<std::pair<SimplexId, char>>> threadedCriticalTypes(
-    threadNumber_);
+  // the edges are processed by chunks, each chunk storing its own Jacobi
+  // edges: the concatenation is sorted by edge id whatever the scheduling
+  const SimplexId chunkNumber
+    = (edgeNumber + edgeChunkSize_ - 1) / edgeChunkSize_;
+  std::vector<std::vector<itemType>> chunkCriticalTypes(chunkNumber);
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId i = 0; i < edgeNumber; i++) {
-
-    char type = getCriticalType(i, uField, vField, triangulation);
+  SimplexId minimumNumber = 0, saddleNumber = 0, maximumNumber = 0,
+            monkeySaddleNumber = 0;
 
-    if(type != -2) {
-      // -2: regular vertex
-      ThreadId threadId = 0;
 #ifdef TTK_ENABLE_OPENMP
-      threadId = omp_get_thread_num();
-#endif
-      threadedCriticalTypes[threadId].push_back(
-        std::pair<SimplexId, char>(i, type));
-    }
-  }
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic) \
+  reduction(+ : minimumNumber, saddleNumber, maximumNumber, monkeySaddleNumber)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < chunkNumber; i++) {
+
+    const SimplexId chunkEnd = std::min(edgeNumber, (i + 1) * edgeChunkSize_);
+
+    for(SimplexId j = i * edgeChunkSize_; j < chunkEnd; j++) {
+
+      char type = getCriticalType(j, uField, vField, triangulation);
+
+      switch(type) {
+        case -2:
+          // -2: regular edge
+          continue;
+        case 0:
+          minimumNumber++;
+          break;
+        case 1:
+          saddleNumber++;
+          break;
+        case 2:
+          maximumNumber++;
+          break;
+        case -1:
+          monkeySaddleNumber++;
+          break;
+      }
 
-  // now merge the threaded lists
-  for(SimplexId i = 0; i < threadNumber_; i++) {
-    for(SimplexId j = 0; j < (SimplexId)threadedCriticalTypes[i].size(); j++) {
-      jacobiSet.push_back(threadedCriticalTypes[i][j]);
+      addJacobiEdge(chunkCriticalTypes[i], j, type);
     }
   }
 
-  SimplexId minimumNumber = 0, saddleNumber = 0, maximumNumber = 0,
-            monkeySaddleNumber = 0;
-
-  for(SimplexId i = 0; i < (SimplexId)jacobiSet.size(); i++) {
-    switch(jacobiSet[i].second) {
-      case 0:
-        minimumNumber++;
-        break;
-      case 1:
-        saddleNumber++;
-        break;
-      case 2:
-        maximumNumber++;
-        break;
-      case -1:
-        monkeySaddleNumber++;
-        break;
-    }
+  // now merge the chunk lists
+  size_t jacobiEdgeNumber = 0;
+  for(const auto &chunk : chunkCriticalTypes) {
+    jacobiEdgeNumber += chunk.size();
+  }
+  jacobiSet.reserve(jacobiEdgeNumber);
+  for(auto &chunk : chunkCriticalTypes) {
+    jacobiSet.insert(jacobiSet.end(), chunk.begin(), chunk.end());
+    std::vector<itemType>{}.swap(chunk);
   }
 
   this->printMsg(
@@ -308,6 +350,37 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
                                      const dataTypeV *const vField,
                                      const triangulationType &triangulation) {
 
+  const SimplexId starNumber = triangulation.getEdgeStarNumber(edgeId);
+
+  if(starNumber <= linkBufferSize_) {
+    // common case: the edge link fits in stack buffers
+    SimplexId linkVertices[2 * linkBufferSize_];
+    signed char linkSides[2 * linkBufferSize_];
+    SimplexId linkParents[2 * linkBufferSize_];
+    SimplexId linkEdges[2 * linkBufferSize_];
+    return classifyEdgeLink(edgeId, starNumber, uField, vField, triangulation,
+                            linkVertices, linkSides, linkParents, linkEdges);
+  }
+
+  std::vector<SimplexId> linkVertices(2 * starNumber),
+    linkParents(2 * starNumber), linkEdges(2 * starNumber);
+  std::vector<signed char> linkSides(2 * starNumber);
+  return classifyEdgeLink(edgeId, starNumber, uField, vField, triangulation,
+                          linkVertices.data(), linkSides.data(),
+                          linkParents.data(), linkEdges.data());
+}
+
+template <class dataTypeU, class dataTypeV, typename triangulationType>
+char ttk::JacobiSet::classifyEdgeLink(const SimplexId &edgeId,
+                                      const SimplexId &starNumber,
+                                      const dataTypeU *const uField,
+                                      const dataTypeV *const vField,
+                                      const triangulationType &triangulation,
+                                      SimplexId *const linkVertices,
+                                      signed char *const linkSides,
+                                      SimplexId *const linkParents,
+                                      SimplexId *const linkEdges) const {
+
   SimplexId vertexId0 = -1, vertexId1 = -1;
   triangulation.getEdgeVertex(edgeId, 0, vertexId0);
   triangulation.getEdgeVertex(edgeId, 1, vertexId1);
@@ -328,223 +401,154 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
   rangeNormal[0] = -rangeEdge[1];
   rangeNormal[1] = rangeEdge[0];
 
-  SimplexId starNumber = triangulation.getEdgeStarNumber(edgeId);
-  std::vector<SimplexId> lowerNeighbors, upperNeighbors;
-
-  SimplexId neighborNumber = 0;
+  // 1) gather the link vertices (with their side of the edge in the range)
+  // and the link edges (one per star cell) in local ids
+  SimplexId linkVertexNumber = 0, linkEdgeNumber = 0, lowerNumber = 0;
+  bool isConsistent = true;
 
   for(SimplexId i = 0; i < starNumber; i++) {
 
     SimplexId tetId = -1;
     triangulation.getEdgeStar(edgeId, i, tetId);
 
+    SimplexId localIds[2];
+    int localNumber = 0;
+
     SimplexId vertexNumber = triangulation.getCellVertexNumber(tetId);
     for(SimplexId j = 0; j < vertexNumber; j++) {
       SimplexId vertexId = -1;
       triangulation.getCellVertex(tetId, j, vertexId);
 
-      if((vertexId != -1) && (vertexId != vertexId0)
-         && (vertexId != vertexId1)) {
-        // new neighbor
-        bool isIn = false;
-        for(SimplexId k = 0; k < (SimplexId)lowerNeighbors.size(); k++) {
-          if(vertexId == lowerNeighbors[k]) {
-            isIn = true;
-            break;
-          }
-        }
+      if((vertexId == -1) || (vertexId == vertexId0)
+         || (vertexId == vertexId1)) {
+        continue;
+      }
 
-        if(!isIn) {
-          for(SimplexId k = 0; k < (SimplexId)upperNeighbors.size(); k++) {
-            if(vertexId == upperNeighbors[k]) {
-              isIn = true;
-              break;
-            }
-          }
+      SimplexId localId = -1;
+      for(SimplexId k = 0; k < linkVertexNumber; k++) {
+        if(linkVertices[k] == vertexId) {
+          localId = k;
+          break;
         }
+      }
 
-        if(!isIn) {
-          // compute the actual distance field
-          // A) compute the distance field
-          double projectedVertex[2];
-          projectedVertex[0] = uField[vertexId];
-          projectedVertex[1] = vField[vertexId];
+      if(localId == -1) {
+        // new neighbor: signed distance to the edge line in the range
+        // (linear function of the dot product)
+        double distance
+          = (uField[vertexId] - projectedPivotVertex[0]) * rangeNormal[0]
+            + (vField[vertexId] - projectedPivotVertex[1]) * rangeNormal[1];
+
+        if(distance == 0) {
+          // degenerate
+          // compute the distance field out of the offset positions
+          double offsetProjectedPivotVertex[2];
+          offsetProjectedPivotVertex[0] = (*sosOffsetsU_)[vertexId0];
+          offsetProjectedPivotVertex[1]
+            = (*sosOffsetsV_)[vertexId0] * (*sosOffsetsV_)[vertexId0];
+
+          double offsetProjectedOtherVertex[2];
+          offsetProjectedOtherVertex[0] = (*sosOffsetsU_)[vertexId1];
+          offsetProjectedOtherVertex[1]
+            = (*sosOffsetsV_)[vertexId1] * (*sosOffsetsV_)[vertexId1];
+
+          double offsetRangeNormal[2];
+          offsetRangeNormal[0]
+            = offsetProjectedPivotVertex[1] - offsetProjectedOtherVertex[1];
+          offsetRangeNormal[1]
+            = offsetProjectedOtherVertex[0] - offsetProjectedPivotVertex[0];
 
-          double vertexRangeEdge[2];
-          vertexRangeEdge[0] = projectedVertex[0] - projectedPivotVertex[0];
-          vertexRangeEdge[1] = projectedVertex[1] - projectedPivotVertex[1];
-
-          // signed distance: linear function of the dot product
-          double distance = vertexRangeEdge[0] * rangeNormal[0]
-                            + vertexRangeEdge[1] * rangeNormal[1];
-
-          neighborNumber++;
-
-          if(distance < 0) {
-            lowerNeighbors.push_back(vertexId);
-          } else if(distance > 0) {
-            upperNeighbors.push_back(vertexId);
-          } else {
-            // degenerate
-            // compute the distance field out of the offset positions
-            double offsetProjectedPivotVertex[2];
-            offsetProjectedPivotVertex[0] = (*sosOffsetsU_)[vertexId0];
-            offsetProjectedPivotVertex[1]
-              = (*sosOffsetsV_)[vertexId0] * (*sosOffsetsV_)[vertexId0];
-
-            double offsetProjectedOtherVertex[2];
-            offsetProjectedOtherVertex[0] = (*sosOffsetsU_)[vertexId1];
-            offsetProjectedOtherVertex[1]
-              = (*sosOffsetsV_)[vertexId1] * (*sosOffsetsV_)[vertexId1];
-
-            double offsetRangeEdge[2];
-            offsetRangeEdge[0]
-              = offsetProjectedOtherVertex[0] - offsetProjectedPivotVertex[0];
-            offsetRangeEdge[1]
-              = offsetProjectedOtherVertex[1] - offsetProjectedPivotVertex[1];
-
-            double offsetRangeNormal[2];
-            offsetRangeNormal[0] = -offsetRangeEdge[1];
-            offsetRangeNormal[1] = offsetRangeEdge[0];
-
-            projectedVertex[0] = (*sosOffsetsU_)[vertexId];
-            projectedVertex[1]
-              = (*sosOffsetsV_)[vertexId] * (*sosOffsetsV_)[vertexId];
-
-            vertexRangeEdge[0]
-              = projectedVertex[0] - offsetProjectedPivotVertex[0];
-            vertexRangeEdge[1]
-              = projectedVertex[1] - offsetProjectedPivotVertex[1];
-
-            distance = vertexRangeEdge[0] * offsetRangeNormal[0]
-                       + vertexRangeEdge[1] * offsetRangeNormal[1];
-
-            if(distance < 0) {
-              lowerNeighbors.push_back(vertexId);
-            } else if(distance > 0) {
-              upperNeighbors.push_back(vertexId);
-            } else {
-              this->printWrn(
-                "Inconsistent (non-bijective?) offsets for vertex #"
-                + std::to_string(vertexId));
-            }
+          double projectedVertex[2];
+          projectedVertex[0] = (*sosOffsetsU_)[vertexId];
+          projectedVertex[1]
+            = (*sosOffsetsV_)[vertexId] * (*sosOffsetsV_)[vertexId];
+
+          distance = (projectedVertex[0] - offsetProjectedPivotVertex[0])
+                       * offsetRangeNormal[0]
+                     + (projectedVertex[1] - offsetProjectedPivotVertex[1])
+                         * offsetRangeNormal[1];
+
+          if(distance == 0) {
+            this->printWrn("Inconsistent (non-bijective?) offsets for vertex #"
+                           + std::to_string(vertexId));
+            isConsistent = false;
           }
         }
+
+        localId = linkVertexNumber;
+        linkVertices[localId] = vertexId;
+        linkSides[localId] = distance < 0 ? -1 : 1;
+        linkParents[localId] = localId;
+        if(distance < 0) {
+          lowerNumber++;
+        }
+        linkVertexNumber++;
+      }
+
+      if(localNumber < 2) {
+        localIds[localNumber] = localId;
+        localNumber++;
       }
     }
+
+    if(localNumber == 2) {
+      linkEdges[2 * linkEdgeNumber] = localIds[0];
+      linkEdges[2 * linkEdgeNumber + 1] = localIds[1];
+      linkEdgeNumber++;
+    }
   }
 
   // at this point, we know if each vertex of the edge link is higher or not.
-  if((SimplexId)(lowerNeighbors.size() + upperNeighbors.size())
-     != neighborNumber) {
+  if(!isConsistent) {
     // Inconsistent offsets (cf above error message)
     return -2;
   }
 
-  if(lowerNeighbors.empty()) {
+  if(lowerNumber == 0) {
     // minimum
     return 0;
   }
-  if(upperNeighbors.empty()) {
+  if(lowerNumber == linkVertexNumber) {
     // maximum
     return 2;
   }
 
-  // let's check the connectivity now
-  std::vector<UnionFind> lowerSeeds(lowerNeighbors.size());
-  std::vector<UnionFind *> lowerList(lowerNeighbors.size());
-  std::vector<UnionFind> upperSeeds(upperNeighbors.size());
-  std::vector<UnionFind *> upperList(upperNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)lowerSeeds.size(); i++) {
-    lowerList[i] = &(lowerSeeds[i]);
-  }
-  for(SimplexId i = 0; i < (SimplexId)upperSeeds.size(); i++) {
-    upperList[i] = &(upperSeeds[i]);
+  // 2) connected components of the lower and upper links (union-find on
+  // the local ids, with path halving)
+  const auto findRoot = [linkParents](SimplexId id) {
+    while(linkParents[id] != id) {
+      linkParents[id] = linkParents[linkParents[id]];
+      id = linkParents[id];
+    }
+    return id;
+  };
+
+  for(SimplexId i = 0; i < linkEdgeNumber; i++) {
+    const SimplexId localId0 = linkEdges[2 * i];
+    const SimplexId localId1 = linkEdges[2 * i + 1];
+    if(linkSides[localId0] == linkSides[localId1]) {
+      const SimplexId root0 = findRoot(localId0);
+      const SimplexId root1 = findRoot(localId1);
+      if(root0 < root1) {
+        linkParents[root1] = root0;
+      } else {
+        linkParents[root0] = root1;
+      }
+    }
   }
 
-  for(SimplexId i = 0; i < starNumber; i++) {
-
-    SimplexId tetId = -1;
-    triangulation.getEdgeStar(edgeId, i, tetId);
-
-    SimplexId vertexNumber = triangulation.getCellVertexNumber(tetId);
-    for(SimplexId j = 0; j < vertexNumber; j++) {
-      SimplexId edgeVertexId0 = -1;
-      triangulation.getCellVertex(tetId, j, edgeVertexId0);
-      if((edgeVertexId0 != vertexId0) && (edgeVertexId0 != vertexId1)) {
-        for(SimplexId k = j + 1; k < vertexNumber; k++) {
-          SimplexId edgeVertexId1 = -1;
-          triangulation.getCellVertex(tetId, k, edgeVertexId1);
-          if((edgeVertexId1 != vertexId0) && (edgeVertexId1 != vertexId1)) {
-            // processing the edge (edgeVertexId0, edgeVertexId1)
-
-            // we need to find out if they're lower or not
-            bool lower0 = false;
-            for(SimplexId l = 0; l < (SimplexId)lowerNeighbors.size(); l++) {
-              if(lowerNeighbors[l] == edgeVertexId0) {
-                lower0 = true;
-                break;
-              }
-            }
-            bool lower1 = false;
-            for(SimplexId l = 0; l < (SimplexId)lowerNeighbors.size(); l++) {
-              if(lowerNeighbors[l] == edgeVertexId1) {
-                lower1 = true;
-                break;
-              }
-            }
-
-            std::vector<SimplexId> *neighbors = &lowerNeighbors;
-            std::vector<UnionFind *> *seeds = &lowerList;
-
-            if(!lower0) {
-              neighbors = &upperNeighbors;
-              seeds = &upperList;
-            }
-
-            if(lower0 == lower1) {
-              // connect their union-find sets!
-              SimplexId lowerId0 = -1, lowerId1 = -1;
-              for(SimplexId l = 0; l < (SimplexId)neighbors->size(); l++) {
-                if((*neighbors)[l] == edgeVertexId0) {
-                  lowerId0 = l;
-                }
-                if((*neighbors)[l] == edgeVertexId1) {
-                  lowerId1 = l;
-                }
-              }
-
-              if((lowerId0 != -1) && (lowerId1 != -1)) {
-                (*seeds)[lowerId0]
-                  = makeUnion((*seeds)[lowerId0], (*seeds)[lowerId1]);
-                (*seeds)[lowerId1] = (*seeds)[lowerId0];
-              }
-            }
-
-            break;
-          }
-        }
+  SimplexId lowerComponentNumber = 0, upperComponentNumber = 0;
+  for(SimplexId i = 0; i < linkVertexNumber; i++) {
+    if(linkParents[i] == i) {
+      if(linkSides[i] < 0) {
+        lowerComponentNumber++;
+      } else {
+        upperComponentNumber++;
       }
     }
   }
 
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  std::vector<UnionFind *>::iterator it;
-  sort(lowerList.begin(), lowerList.end());
-  it = unique(lowerList.begin(), lowerList.end());
-  lowerList.resize(distance(lowerList.begin(), it));
-
-  sort(upperList.begin(), upperList.end());
-  it = unique(upperList.begin(), upperList.end());
-  upperList.resize(distance(upperList.begin(), it));
-
-  if((upperList.size() == 1) && (lowerList.size() == 1))
+  if((upperComponentNumber == 1) && (lowerComponentNumber == 1))
     return -2;
 
   return 1;
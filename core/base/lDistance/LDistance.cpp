@@ -3,3 +3,5 @@
 ttk::LDistance::LDistance() {
   this->setDebugMsgPrefix("LDistance");
 }
+
+constexpr size_t ttk::LDistance::BlockSize;
@@ -13,6 +13,7 @@
 #pragma once
 
 // Standard.
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <string>
@@ -56,6 +57,30 @@ namespace ttk {
       return (var1 > var2) ? var1 - var2 : var2 - var1;
     }
 
+    /**
+     * @brief Sum of the n-th powers of the absolute differences of two
+     * arrays, accumulated in double precision
+     *
+     * The common L1 and L2 cases are specialised so that the loops can be
+     * vectorized by the compiler.
+     */
+    template <class dataType>
+    static double sumPowDiff(const dataType *const input1,
+                             const dataType *const input2,
+                             const int n,
+                             const size_t count);
+
+    /**
+     * @brief Maximum absolute difference of two arrays
+     */
+    template <class dataType>
+    static double maxAbsDiff(const dataType *const input1,
+                             const dataType *const input2,
+                             const size_t count);
+
+    /// Number of vertices processed by a sumPowDiff/maxAbsDiff call
+    static constexpr size_t BlockSize{4096};
+
   protected:
     double result{};
   };
@@ -101,29 +126,39 @@ int ttk::LDistance::computeLn(const dataType *const input1,
                               dataType *const output,
                               const int n,
                               const ttk::SimplexId vertexNumber) {
-  dataType sum = 0;
+  double sum = 0;
 
+  if(output == nullptr) {
+    // process the vertices by blocks with the vectorized kernel
+    const SimplexId nBlocks = (vertexNumber + BlockSize - 1) / BlockSize;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(+ : sum)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId b = 0; b < nBlocks; ++b) {
+      const size_t beg = b * BlockSize;
+      const size_t count = std::min(BlockSize, vertexNumber - beg);
+      sum += sumPowDiff(input1 + beg, input2 + beg, n, count);
+    }
+  } else {
 // Compute difference for each point.
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_) reduction(+ : sum)
 #endif
-  for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
-    const dataType diff = abs_diff<dataType>(input1[i], input2[i]);
-    const dataType power = Geometry::pow(diff, n);
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      const dataType diff = abs_diff<dataType>(input1[i], input2[i]);
+      const dataType power = Geometry::pow(diff, n);
 
-    // Careful: huge dataset + huge values
-    // may exceed double capacity.
-    sum += power;
+      // accumulate in double: huge datasets with huge values may
+      // exceed the capacity of dataType
+      sum += power;
 
-    // Store difference.
-    if(output)
+      // Store difference.
       output[i] = power;
+    }
   }
 
-  sum = Geometry::pow(sum, 1.0 / (double)n);
-
   // Affect result.
-  result = (double)sum;
+  result = std::pow(sum, 1.0 / n);
   this->printMsg("L" + std::to_string(n)
                  + "-distance: " + std::to_string(result));
 
@@ -138,25 +173,90 @@ int ttk::LDistance::computeLinf(const dataType *const input1,
   if(vertexNumber < 1)
     return 0;
 
-  dataType maxValue = abs_diff<dataType>(input1[0], input2[0]);
+  double maxValue = 0;
 
+  if(output == nullptr) {
+    const SimplexId nBlocks = (vertexNumber + BlockSize - 1) / BlockSize;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(max : maxValue)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId b = 0; b < nBlocks; ++b) {
+      const size_t beg = b * BlockSize;
+      const size_t count = std::min(BlockSize, vertexNumber - beg);
+      maxValue
+        = std::max(maxValue, maxAbsDiff(input1 + beg, input2 + beg, count));
+    }
+  } else {
 // Compute difference for each point.
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_) reduction(max : maxValue)
 #endif
-  for(ttk::SimplexId i = 1; i < vertexNumber; ++i) {
-    const dataType iter = abs_diff<dataType>(input1[i], input2[i]);
-    if(iter > maxValue)
-      maxValue = iter;
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      const dataType iter = abs_diff<dataType>(input1[i], input2[i]);
+      if(iter > maxValue)
+        maxValue = iter;
 
-    // Store absolute difference in output.
-    if(output)
+      // Store absolute difference in output.
       output[i] = iter;
+    }
   }
 
   // Affect result.
-  result = (double)maxValue;
+  result = maxValue;
   this->printMsg("Linf-distance: " + std::to_string(result));
 
   return 0;
 }
+
+template <class dataType>
+double ttk::LDistance::sumPowDiff(const dataType *const input1,
+                                  const dataType *const input2,
+                                  const int n,
+                                  const size_t count) {
+  double sum = 0;
+
+  if(n == 1) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < count; ++i) {
+      sum += std::abs(static_cast<double>(input1[i])
+                      - static_cast<double>(input2[i]));
+    }
+  } else if(n == 2) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < count; ++i) {
+      const double diff
+        = static_cast<double>(input1[i]) - static_cast<double>(input2[i]);
+      sum += diff * diff;
+    }
+  } else {
+    for(size_t i = 0; i < count; ++i) {
+      const double diff = std::abs(static_cast<double>(input1[i])
+                                   - static_cast<double>(input2[i]));
+      sum += Geometry::powInt(diff, n);
+    }
+  }
+
+  return sum;
+}
+
+template <class dataType>
+double ttk::LDistance::maxAbsDiff(const dataType *const input1,
+                                  const dataType *const input2,
+                                  const size_t count) {
+  double maxValue = 0;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp simd reduction(max : maxValue)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < count; ++i) {
+    const double diff = std::abs(static_cast<double>(input1[i])
+                                 - static_cast<double>(input2[i]));
+    maxValue = diff > maxValue ? diff : maxValue;
+  }
+
+  return maxValue;
+}
@@ -3,3 +3,6 @@
 ttk::LDistanceMatrix::LDistanceMatrix() {
   this->setDebugMsgPrefix("LDistanceMatrix");
 }
+
+constexpr size_t ttk::LDistanceMatrix::TileSize;
+constexpr size_t ttk::LDistanceMatrix::BlockSize;
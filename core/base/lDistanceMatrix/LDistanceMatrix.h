@@ -8,7 +8,11 @@
 #include <LDistance.h>
 #include <Wrapper.h>
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ttk {
@@ -25,6 +29,11 @@ namespace ttk {
                                              const size_t nPoints) const;
 
   protected:
+    /// Number of inputs per side of a matrix tile
+    static constexpr size_t TileSize{8};
+    /// Number of points processed at once for a pair of inputs
+    static constexpr size_t BlockSize{LDistance::BlockSize};
+
     std::string DistanceType{};
   };
 } // namespace ttk
@@ -34,41 +43,113 @@ std::vector<std::vector<double>>
   ttk::LDistanceMatrix::execute(const std::vector<void *> &inputs,
                                 const size_t nPoints) const {
 
+  Timer tm{};
+
   const auto nInputs = inputs.size();
-  std::vector<std::vector<double>> distMatrix(nInputs);
-
-  LDistance worker{};
-  worker.setThreadNumber(this->threadNumber_);
-
-  // compute matrix upper triangle
-  // (some parallelism inside the LDistance computation)
-  for(size_t i = 0; i < nInputs; ++i) {
-    auto &distCol = distMatrix[i];
-    distCol.resize(nInputs);
-    // get pointer to scalar field of input i
-    const auto inputDataPtr1{static_cast<T *>(inputs[i])};
-    for(size_t j = i + 1; j < nInputs; ++j) {
-      // get pointer to scalar field of input jc
-      const auto inputDataPtr2{static_cast<T *>(inputs[j])};
-      // empty output
-      T *outputPtr{};
-      // call execute
-      worker.execute(
-        inputDataPtr1, inputDataPtr2, outputPtr, this->DistanceType, nPoints);
-      // store result
-      distMatrix[i][j] = worker.getResult();
+  std::vector<std::vector<double>> distMatrix(
+    nInputs, std::vector<double>(nInputs, 0.0));
+
+  const bool isInf = this->DistanceType == "inf";
+  int n = 0;
+  if(!isInf) {
+    try {
+      n = std::stoi(this->DistanceType);
+    } catch(const std::logic_error &) {
+      // non-numeric or out-of-range distance type
+      n = 0;
     }
   }
+  if(!isInf && n < 1) {
+    this->printErr("Invalid distance type " + this->DistanceType);
+    return distMatrix;
+  }
+
+  // the upper triangle of the matrix is split into tiles of TileSize x
+  // TileSize pairs of inputs: every block of BlockSize points of a tile
+  // input is loaded once and re-used against all the inputs of the other
+  // tile side
+  const size_t nTiles = (nInputs + TileSize - 1) / TileSize;
+  std::vector<std::pair<size_t, size_t>> tiles{};
+  for(size_t i = 0; i < nTiles; ++i) {
+    for(size_t j = i; j < nTiles; ++j) {
+      tiles.emplace_back(i, j);
+    }
+  }
+
+  // with few tiles, also split the points into slabs to feed all threads
+  const size_t nBlocks = (nPoints + BlockSize - 1) / BlockSize;
+  const size_t nTasks = 4 * this->threadNumber_;
+  const size_t nSlabs = std::max<size_t>(
+    1, std::min(nBlocks, (nTasks + tiles.size() - 1)
+                           / std::max<size_t>(tiles.size(), 1)));
+  const size_t blocksPerSlab = (nBlocks + nSlabs - 1) / nSlabs;
+
+  // partial sums (or maxima) per tile, slab and tile pair
+  constexpr size_t tileArea = TileSize * TileSize;
+  std::vector<double> partials(tiles.size() * nSlabs * tileArea, 0.0);
 
-  // distance matrix is symmetric
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t task = 0; task < tiles.size() * nSlabs; ++task) {
+    const auto &tile = tiles[task / nSlabs];
+    const size_t slab = task % nSlabs;
+    const size_t iBeg = tile.first * TileSize;
+    const size_t iEnd = std::min(iBeg + TileSize, nInputs);
+    const size_t jBeg = tile.second * TileSize;
+    const size_t jEnd = std::min(jBeg + TileSize, nInputs);
+    const size_t pBeg = std::min(slab * blocksPerSlab * BlockSize, nPoints);
+    const size_t pEnd
+      = std::min((slab + 1) * blocksPerSlab * BlockSize, nPoints);
+
+    double *const acc = &partials[task * tileArea];
+
+    for(size_t beg = pBeg; beg < pEnd; beg += BlockSize) {
+      const size_t count = std::min(BlockSize, pEnd - beg);
+      for(size_t i = iBeg; i < iEnd; ++i) {
+        const auto in1{static_cast<const T *>(inputs[i]) + beg};
+        for(size_t j = std::max(i + 1, jBeg); j < jEnd; ++j) {
+          const auto in2{static_cast<const T *>(inputs[j]) + beg};
+          double &val = acc[(i - iBeg) * TileSize + j - jBeg];
+          if(isInf) {
+            val = std::max(val, LDistance::maxAbsDiff(in1, in2, count));
+          } else {
+            val += LDistance::sumPowDiff(in1, in2, n, count);
+          }
+        }
+      }
+    }
+  }
+
+  // reduce the slabs (in a fixed order) and fill both matrix triangles
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < nInputs; ++i) {
-    for(size_t j = i + 1; j < nInputs; ++j) {
-      distMatrix[j][i] = distMatrix[i][j];
+  for(size_t t = 0; t < tiles.size(); ++t) {
+    const size_t iBeg = tiles[t].first * TileSize;
+    const size_t iEnd = std::min(iBeg + TileSize, nInputs);
+    const size_t jBeg = tiles[t].second * TileSize;
+    const size_t jEnd = std::min(jBeg + TileSize, nInputs);
+    for(size_t i = iBeg; i < iEnd; ++i) {
+      for(size_t j = std::max(i + 1, jBeg); j < jEnd; ++j) {
+        const size_t offset = (i - iBeg) * TileSize + j - jBeg;
+        double val = 0.0;
+        for(size_t slab = 0; slab < nSlabs; ++slab) {
+          const double part
+            = partials[(t * nSlabs + slab) * tileArea + offset];
+          val = isInf ? std::max(val, part) : val + part;
+        }
+        if(!isInf) {
+          val = std::pow(val, 1.0 / n);
+        }
+        distMatrix[i][j] = val;
+        distMatrix[j][i] = val;
+      }
     }
   }
 
+  this->printMsg("Computed distance matrix", 1.0, tm.getElapsedTime(),
+                 this->threadNumber_);
+
   return distMatrix;
 }
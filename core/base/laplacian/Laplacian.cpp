@@ -4,17 +4,93 @@
 #ifdef TTK_ENABLE_EIGEN
 #include <Eigen/Sparse>
 
+#include <algorithm>
 #include <array>
 
+namespace {
+  /**
+   * @brief Allocate the compressed storage of the Laplacian matrix
+   *
+   * Each column (or row, the matrix is symmetric) holds the diagonal
+   * coefficient and one coefficient per neighbor vertex, sorted by vertex
+   * id. The column offsets are given by the vertex neighbor numbers, so
+   * that the coefficients can be directly written in parallel, without
+   * going through a list of triplets.
+   */
+  template <typename T, class TriangulationType, typename SparseMatrixType>
+  void allocateLaplacian(SparseMatrixType &output,
+                         const TriangulationType &triangulation) {
+
+    using StorageIndex = typename SparseMatrixType::StorageIndex;
+    const auto vertexNumber = triangulation.getNumberOfVertices();
+
+#ifdef TTK_ENABLE_OPENMP
+    const auto threadNumber = triangulation.getThreadNumber();
+#endif // TTK_ENABLE_OPENMP
+
+    // clear output (compressed mode)
+    output.resize(vertexNumber, vertexNumber);
+    output.setZero();
+
+    // column offsets: diagonal + neighbors
+    auto outer = output.outerIndexPtr();
+    outer[0] = 0;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      outer[i + 1] = triangulation.getVertexNeighborNumber(i) + 1;
+    }
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      outer[i + 1] += outer[i];
+    }
+
+    output.resizeNonZeros(outer[vertexNumber]);
+    auto inner = output.innerIndexPtr();
+    auto values = output.valuePtr();
+
+    // sorted row indices
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+      const auto begin = outer[i];
+      const auto end = outer[i + 1];
+      inner[begin] = i;
+      for(StorageIndex j = begin + 1; j < end; ++j) {
+        ttk::SimplexId neighId{};
+        triangulation.getVertexNeighbor(i, j - begin - 1, neighId);
+        inner[j] = neighId;
+      }
+      std::sort(inner + begin, inner + end);
+      std::fill(values + begin, values + end, T(0.0));
+    }
+  }
+
+  /**
+   * @brief Position of the coefficient (row, col) in the compressed storage
+   * allocated by allocateLaplacian()
+   */
+  template <typename SparseMatrixType>
+  inline typename SparseMatrixType::StorageIndex
+    getCoefficientIndex(const SparseMatrixType &matrix,
+                        const ttk::SimplexId row,
+                        const ttk::SimplexId col) {
+    const auto inner = matrix.innerIndexPtr();
+    const auto begin = inner + matrix.outerIndexPtr()[col];
+    const auto end = inner + matrix.outerIndexPtr()[col + 1];
+    return std::lower_bound(begin, end, row) - inner;
+  }
+} // namespace
+
 template <typename T,
           class TriangulationType,
           typename SparseMatrixType = Eigen::SparseMatrix<T>>
 int ttk::Laplacian::discreteLaplacian(SparseMatrixType &output,
                                       const TriangulationType &triangulation) {
 
-  using Triplet = Eigen::Triplet<T>;
+  using StorageIndex = typename SparseMatrixType::StorageIndex;
   const auto vertexNumber = triangulation.getNumberOfVertices();
-  const auto edgeNumber = triangulation.getNumberOfEdges();
 
   // early return when input graph is empty
   if(vertexNumber <= 0) {
@@ -26,42 +102,23 @@ int ttk::Laplacian::discreteLaplacian(SparseMatrixType &output,
   const auto threadNumber = triangulation.getThreadNumber();
 #endif // TTK_ENABLE_OPENMP
 
-  // clear output
-  output.resize(vertexNumber, vertexNumber);
-  output.setZero();
+  allocateLaplacian<T>(output, triangulation);
 
-  // number of triplets to insert into laplacian matrix: vertexNumber_
-  // values on the diagonal + 2 values per edge
-  std::vector<Triplet> triplets(vertexNumber + 2 * edgeNumber);
+  const auto outer = output.outerIndexPtr();
+  const auto inner = output.innerIndexPtr();
+  auto values = output.valuePtr();
 
-  // on the diagonal: number of neighbors
+  // on the diagonal: number of neighbors, -1 for every neighbor
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber)
 #endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber; ++i) {
-    const auto nneigh = triangulation.getVertexNeighborNumber(i);
-    triplets[i] = Triplet(i, i, T(nneigh));
-  }
-
-  // neighbors mapping: loop over edges
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber)
-#endif // TTK_ENABLE_OPENMP
-  for(SimplexId i = 0; i < edgeNumber; ++i) {
-    // the two vertices of the current edge
-    std::vector<SimplexId> edgeVertices(2);
-    for(SimplexId j = 0; j < 2; ++j) {
-      triangulation.getEdgeVertex(i, j, edgeVertices[j]);
+    const T nneigh = outer[i + 1] - outer[i] - 1;
+    for(StorageIndex j = outer[i]; j < outer[i + 1]; ++j) {
+      values[j] = inner[j] == i ? nneigh : T(-1.0);
     }
-    // fill triplets for both vertices of current edge
-    triplets[vertexNumber + 2 * i]
-      = Triplet(edgeVertices[0], edgeVertices[1], T(-1.0));
-    triplets[vertexNumber + 2 * i + 1]
-      = Triplet(edgeVertices[1], edgeVertices[0], T(-1.0));
   }
 
-  output.setFromTriplets(triplets.begin(), triplets.end());
-
   return 0;
 }
 
@@ -71,7 +128,7 @@ template <typename T,
 int ttk::Laplacian::cotanWeights(SparseMatrixType &output,
                                  const TriangulationType &triangulation) {
 
-  using Triplet = Eigen::Triplet<T>;
+  using StorageIndex = typename SparseMatrixType::StorageIndex;
   const auto vertexNumber = triangulation.getNumberOfVertices();
   const auto edgeNumber = triangulation.getNumberOfEdges();
 
@@ -85,89 +142,67 @@ int ttk::Laplacian::cotanWeights(SparseMatrixType &output,
     return -1;
   }
 
-  // clear output
-  output.resize(vertexNumber, vertexNumber);
-  output.setZero();
-
-  // number of triplets to insert into laplacian matrix: vertexNumber_
-  // values on the diagonal + 2 values per edge
-  std::vector<Triplet> triplets(vertexNumber + 2 * edgeNumber);
+  allocateLaplacian<T>(output, triangulation);
 
-  // hold sum of cotan weights for every vertex
-  std::vector<T> vertexWeightSum(vertexNumber, T(0.0));
+  const auto outer = output.outerIndexPtr();
+  const auto inner = output.innerIndexPtr();
+  auto values = output.valuePtr();
 
-  // iterate over all edges
+  // iterate over all edges: every edge owns its two off-diagonal
+  // coefficients, no synchronization is needed
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber)
 #endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < edgeNumber; ++i) {
 
     // the two vertices of the current edge (+ a third)
-    std::vector<SimplexId> edgeVertices(3);
+    std::array<SimplexId, 3> edgeVertices{};
     for(SimplexId j = 0; j < 2; ++j) {
       triangulation.getEdgeVertex(i, j, edgeVertices[j]);
     }
 
-    // get the triangles that share the current edge
-    // in 2D only 2, in 3D, maybe more...
-    const auto trianglesNumber = triangulation.getEdgeTriangleNumber(i);
-    // stores the triangles ID for every triangle around the current edge
-    std::vector<SimplexId> edgeTriangles(trianglesNumber);
-    for(SimplexId j = 0; j < trianglesNumber; ++j) {
-      triangulation.getEdgeTriangle(i, j, edgeTriangles[j]);
+    // compute the 3D coords of the two vertices of the edge
+    std::array<float, 9> coords{};
+    for(SimplexId k = 0; k < 2; ++k) {
+      triangulation.getVertexPoint(
+        edgeVertices[k], coords[3 * k], coords[3 * k + 1], coords[3 * k + 2]);
     }
 
-    // iterate over current edge triangles
-    std::vector<T> angles{};
+    // cotan weights for every triangle around the current edge
+    // (in 2D only 2, in 3D, maybe more...)
+    T cotan_weight{0.0};
 
-    for(const auto &j : edgeTriangles) {
+    const auto trianglesNumber = triangulation.getEdgeTriangleNumber(i);
+    for(SimplexId j = 0; j < trianglesNumber; ++j) {
+      SimplexId triangleId{};
+      triangulation.getEdgeTriangle(i, j, triangleId);
 
       // get the third vertex of the triangle
       SimplexId thirdNeigh;
       // a triangle has only three vertices
       for(SimplexId k = 0; k < 3; ++k) {
-        triangulation.getTriangleVertex(j, k, thirdNeigh);
+        triangulation.getTriangleVertex(triangleId, k, thirdNeigh);
         if(thirdNeigh != edgeVertices[0] && thirdNeigh != edgeVertices[1]) {
-          // store the third vertex ID into the edgeVertices array to
-          // be more easily handled
           edgeVertices[2] = thirdNeigh;
           break;
         }
       }
-      // compute the 3D coords of the three vertices
-      std::array<float, 9> coords{};
-      for(SimplexId k = 0; k < 3; ++k) {
-        triangulation.getVertexPoint(
-          edgeVertices[k], coords[3 * k], coords[3 * k + 1], coords[3 * k + 2]);
-      }
-      angles.emplace_back(ttk::Geometry::angle(&coords[6], // edgeVertices[2]
-                                               &coords[0], // edgeVertices[0]
-                                               &coords[6], // edgeVertices[2]
-                                               &coords[3]) // edgeVertices[1]
-      );
-    }
+      triangulation.getVertexPoint(
+        edgeVertices[2], coords[6], coords[7], coords[8]);
 
-    // cotan weights for every triangle around the current edge
-    T cotan_weight{0.0};
-    // C++ has no map statement until C++17 (std::transform)
-    for(auto &angle : angles) {
+      const T angle = ttk::Geometry::angle(&coords[6], // edgeVertices[2]
+                                           &coords[0], // edgeVertices[0]
+                                           &coords[6], // edgeVertices[2]
+                                           &coords[3]); // edgeVertices[1]
       cotan_weight += T(1.0) / std::tan(angle);
     }
 
     // since we iterate over the edges, fill the laplacian matrix
     // symmetrically for the two vertices
-    triplets[2 * i] = Triplet(edgeVertices[0], edgeVertices[1], -cotan_weight);
-    triplets[2 * i + 1]
-      = Triplet(edgeVertices[1], edgeVertices[0], -cotan_weight);
-
-    // store the cotan weight sum for the two vertices of the current edge
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp critical
-#endif // TTK_ENABLE_OPENMP
-    {
-      vertexWeightSum[edgeVertices[0]] += cotan_weight;
-      vertexWeightSum[edgeVertices[1]] += cotan_weight;
-    }
+    values[getCoefficientIndex(output, edgeVertices[0], edgeVertices[1])]
+      = -cotan_weight;
+    values[getCoefficientIndex(output, edgeVertices[1], edgeVertices[0])]
+      = -cotan_weight;
   }
 
   // on the diagonal: sum of cotan weights for every vertex
@@ -175,11 +210,18 @@ int ttk::Laplacian::cotanWeights(SparseMatrixType &output,
 #pragma omp parallel for num_threads(threadNumber)
 #endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber; ++i) {
-    triplets[2 * edgeNumber + i] = Triplet(i, i, vertexWeightSum[i]);
+    StorageIndex diagonal{-1};
+    T vertexWeightSum{0.0};
+    for(StorageIndex j = outer[i]; j < outer[i + 1]; ++j) {
+      if(inner[j] == i) {
+        diagonal = j;
+      } else {
+        vertexWeightSum -= values[j];
+      }
+    }
+    values[diagonal] = vertexWeightSum;
   }
 
-  output.setFromTriplets(triplets.begin(), triplets.end());
-
   return 0;
 }
 
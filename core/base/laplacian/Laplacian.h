@@ -7,6 +7,9 @@ namespace ttk {
     /**
      * @brief Compute the Laplacian matrix of the graph
      *
+     * The matrix is directly assembled in compressed storage, its sparsity
+     * pattern being given by the vertex neighbors.
+     *
      * @param[out] output Laplacian matrix
      * @param[in] triangulation Access to neighbor vertices, should be already
      * preprocessed
@@ -23,9 +26,12 @@ namespace ttk {
      * @brief Compute the Laplacian matrix of the graph using the
      * cotangente weights method
      *
+     * The matrix is directly assembled in compressed storage, its sparsity
+     * pattern being given by the vertex neighbors.
+     *
      * @param[out] output Laplacian matrix
-     * @param[in] triangulation Access to neighbor vertices, should be already
-     * preprocessed
+     * @param[in] triangulation Access to neighbor vertices and edge
+     * triangles, should be already preprocessed
      *
      * @return 0 in case of success
      */
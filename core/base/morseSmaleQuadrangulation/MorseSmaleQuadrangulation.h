@@ -235,6 +235,8 @@ namespace ttk {
     std::vector<SimplexId> outputPointsCells_{};
     // triangulation subdivision to detect cells
     BarycentricSubdivision bs{};
+    // edge lengths of the input triangulation, for the Dijkstra propagations
+    Dijkstra::WeightedGraph<float> dijkstraGraph_{};
 
     // if dual quadrangulation
     bool DualQuadrangulation{false};
@@ -661,6 +663,9 @@ int ttk::MorseSmaleQuadrangulation::subdiviseDegenerateQuads(
   auto quads = reinterpret_cast<std::vector<Quad> *>(&outputCells_);
   auto qsubd = reinterpret_cast<std::vector<Quad> *>(&outputSubd);
 
+  // Dijkstra buffers, reused between quads
+  Dijkstra::Workspace<float> workspace{};
+
   for(size_t i = 0; i < quads->size(); ++i) {
     auto q = quads->at(i);
     auto seps = quadSeps_[i];
@@ -705,11 +710,14 @@ int ttk::MorseSmaleQuadrangulation::subdiviseDegenerateQuads(
     std::vector<SimplexId> boundi{criticalPointsIdentifier_[q.i]};
     std::vector<SimplexId> boundk{criticalPointsIdentifier_[q.k]};
     std::array<std::vector<float>, 6> outputDists{};
+    const std::vector<bool> noMask{};
 
-    Dijkstra::shortestPath(
-      criticalPointsIdentifier_[q.i], triangulation, outputDists[0], boundk);
-    Dijkstra::shortestPath(
-      criticalPointsIdentifier_[q.k], triangulation, outputDists[1], boundi);
+    Dijkstra::shortestPath(criticalPointsIdentifier_[q.i], triangulation,
+                           outputDists[0], boundk, noMask, &dijkstraGraph_,
+                           &workspace);
+    Dijkstra::shortestPath(criticalPointsIdentifier_[q.k], triangulation,
+                           outputDists[1], boundi, noMask, &dijkstraGraph_,
+                           &workspace);
 
     auto inf = std::numeric_limits<float>::infinity();
     std::vector<float> sum(outputDists[0].size(), inf);
@@ -752,10 +760,14 @@ int ttk::MorseSmaleQuadrangulation::subdiviseDegenerateQuads(
     auto m1 = outputPointsIds_[m1Pos];
 
     Dijkstra::shortestPath(criticalPointsIdentifier_[vert1Sep], triangulation,
-                           outputDists[2], bounds);
-    Dijkstra::shortestPath(v0, triangulation, outputDists[3], bounds);
-    Dijkstra::shortestPath(m0, triangulation, outputDists[4], bounds);
-    Dijkstra::shortestPath(m1, triangulation, outputDists[5], bounds);
+                           outputDists[2], bounds, noMask, &dijkstraGraph_,
+                           &workspace);
+    Dijkstra::shortestPath(v0, triangulation, outputDists[3], bounds, noMask,
+                           &dijkstraGraph_, &workspace);
+    Dijkstra::shortestPath(m0, triangulation, outputDists[4], bounds, noMask,
+                           &dijkstraGraph_, &workspace);
+    Dijkstra::shortestPath(m1, triangulation, outputDists[5], bounds, noMask,
+                           &dijkstraGraph_, &workspace);
 
     std::fill(sum.begin(), sum.end(), inf);
 
@@ -801,6 +813,11 @@ template <typename triangulationType>
 int ttk::MorseSmaleQuadrangulation::subdivise(
   const triangulationType &triangulation) {
 
+  // edge lengths shared by all the Dijkstra propagations
+  dijkstraGraph_.build(triangulation, threadNumber_);
+  // Dijkstra buffers, one per thread
+  std::vector<Dijkstra::Workspace<float>> workspaces(threadNumber_);
+
   // separatrices middles index in output points array
   sepMids_.resize(sepBegs_.size());
 
@@ -871,8 +888,14 @@ int ttk::MorseSmaleQuadrangulation::subdivise(
 #pragma omp parallel for num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
     for(size_t j = 0; j < outputDists.size(); ++j) {
+#ifdef TTK_ENABLE_OPENMP
+      auto &workspace = workspaces[omp_get_thread_num()];
+#else
+      auto &workspace = workspaces[0];
+#endif // TTK_ENABLE_OPENMP
       Dijkstra::shortestPath(midsNearestVertex[j], triangulation,
-                             outputDists.at(j), std::vector<SimplexId>(), mask);
+                             outputDists.at(j), std::vector<SimplexId>(), mask,
+                             &dijkstraGraph_, &workspace);
     }
 
     auto inf = std::numeric_limits<float>::infinity();
@@ -957,6 +980,8 @@ int ttk::MorseSmaleQuadrangulation::subdivise(
   // overwrite old quads
   outputCells_ = std::move(outputSubd);
 
+  dijkstraGraph_.clear();
+
   return 0;
 }
 
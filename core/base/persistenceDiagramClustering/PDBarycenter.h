@@ -93,6 +93,13 @@ namespace ttk {
       std::vector<std::vector<matchingTuple>> *all_matchings,
       bool use_kdt);
 
+    /// Call func(i) for every input diagram i, as OpenMP tasks scheduled
+    /// from the largest diagram to the smallest. When called from a parallel
+    /// region, the tasks are run by the threads of the enclosing team.
+    template <typename Func>
+    void runPerDiagramTasks(const std::vector<int> &sizes,
+                            const Func &func) const;
+
     dataType
       updateBarycenter(std::vector<std::vector<matchingTuple>> &matchings);
 
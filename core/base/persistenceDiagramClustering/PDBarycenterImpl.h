@@ -22,6 +22,7 @@
 
 #include <cstdlib> /* srand, rand */
 //
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -44,6 +45,46 @@ std::vector<std::vector<matchingTuple>>
   // }
 }
 
+template <typename dataType>
+template <typename Func>
+void PDBarycenter<dataType>::runPerDiagramTasks(const std::vector<int> &sizes,
+                                                const Func &func) const {
+  // largest diagrams first, so that the last tasks are the shortest ones
+  std::vector<int> order(numberOfInputs_);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+    order.begin(), order.end(),
+    [&sizes](const int a, const int b) { return sizes[a] > sizes[b]; });
+  const Func *const f = &func;
+
+#ifdef TTK_ENABLE_OPENMP
+  if(omp_in_parallel()) {
+    // already in a parallel region (e.g. one barycenter per cluster): the
+    // tasks are shared with the enclosing team
+    for(const int i : order) {
+#pragma omp task firstprivate(i, f)
+      (*f)(i);
+    }
+#pragma omp taskwait
+  } else {
+#pragma omp parallel num_threads(threadNumber_)
+    {
+#pragma omp single nowait
+      {
+        for(const int i : order) {
+#pragma omp task firstprivate(i, f)
+          (*f)(i);
+        }
+      }
+    }
+  }
+#else
+  for(const int i : order) {
+    (*f)(i);
+  }
+#endif // TTK_ENABLE_OPENMP
+}
+
 template <typename dataType>
 void PDBarycenter<dataType>::runMatching(
   dataType *total_cost,
@@ -57,25 +98,13 @@ void PDBarycenter<dataType>::runMatching(
   bool use_kdt,
   int actual_distance) {
   Timer time_matchings;
-#ifdef TTK_ENABLE_OPENMP
-  omp_set_num_threads(threadNumber_);
-#pragma omp parallel for schedule(dynamic, 1)
-#endif
+  std::vector<dataType> costs(numberOfInputs_);
 
-  for(int i = 0; i < numberOfInputs_; i++) {
-    // cout<<"input "<<i<<" sizes : "<<current_bidder_diagrams_.size()<<"
-    // "<<barycenter_goods_.size()<<" "<<min_diag_price->size()<<endl;
+  const auto matchDiagram = [&](const int i) {
     Auction<dataType> auction = Auction<dataType>(
       current_bidder_diagrams_[i], barycenter_goods_[i], wasserstein_,
       geometrical_factor_, lambda_, 0.01, kdt, correspondance_kdt_map, epsilon,
       min_diag_price->at(i), use_kdt);
-    // cout<<"\n RUN MATCHINGS : "<<i<<endl;
-    // cout<<use_kdt<<endl;
-    // cout<<epsilon<<endl;
-    // cout<<geometrical_factor_<<endl;
-    // cout<<wasserstein_<<endl;
-    // cout<<min_diag_price->at(i)<<endl;
-    // cout<<min_price->at(i)<<endl;
     int n_biddings = 0;
     auction.buildUnassignedBidders();
     auction.reinitializeGoods();
@@ -86,43 +115,21 @@ void PDBarycenter<dataType>::runMatching(
     std::vector<matchingTuple> matchings;
     dataType cost = auction.getMatchingsAndDistance(&matchings, true);
     all_matchings->at(i) = matchings;
-    if(actual_distance) {
-      (*total_cost) += cost;
-    } else {
-      (*total_cost) += cost * cost;
-    }
-
-    // cout<<auction.getMinimalDiagonalPrice()<<endl;
-    // cout<<getMinimalPrice(i)<<endl;
-    // cout<<cost<<endl;
-
-    // if(cost <= ((1.01 * 1.01) * (cost - epsilon *
-    // auction.getAugmentedNumberOfBidders()))) {
-    //     precision_objective_[i] = true;
-    // } else {
-    //     precision_objective_[i] = false;
-    // }
+    costs[i] = actual_distance ? cost : cost * cost;
+
     dataType quotient = epsilon * auction.getAugmentedNumberOfBidders() / cost;
     precision_[i] = quotient < 1 ? 1. / sqrt(1 - quotient) - 1 : 10;
-    // cout<<" "<<precision_[i];
-    // std::cout<< "Barycenter cost for diagram " << i <<" : "<< cost <<
-    // std::endl; std::cout<< "Number of biddings : " << n_biddings <<
-    // std::endl; Resizes the diagram which was enrich with diagonal bidders
-    // during the auction
+    // Resizes the diagram which was enrich with diagonal bidders during the
+    // auction
     // TODO do this inside the auction !
     current_bidder_diagrams_[i].bidders_.resize(sizes[i]);
+  };
+  runPerDiagramTasks(sizes, matchDiagram);
+
+  // sequential sum: the total cost does not depend on the scheduling
+  for(const auto cost : costs) {
+    (*total_cost) += cost;
   }
-  // cout<<endl;
-  /* print matchings
-          for(long unsigned int i=0; i<(*all_matchings).size(); i++){
-              for (long unsigned int j = 0; j < (*all_matchings)[i].size(); j++)
-     { std::cout << get<0>((*all_matchings)[i][j]) << " " ; std::cout <<
-     get<1>((*all_matchings)[i][j]) << " " ; std::cout <<
-     get<2>((*all_matchings)[i][j]) << "  |   " ;
-              }
-      std::cout << "\n" ;
-          }*/
-  // cout<<time_matchings.getElapsedTime()<<endl;
 }
 
 template <typename dataType>
@@ -134,11 +141,9 @@ void PDBarycenter<dataType>::runMatchingAuction(
   std::vector<dataType> *min_diag_price,
   std::vector<std::vector<matchingTuple>> *all_matchings,
   bool use_kdt) {
-#ifdef TTK_ENABLE_OPENMP
-  omp_set_num_threads(threadNumber_);
-#pragma omp parallel for schedule(dynamic, 1)
-#endif
-  for(int i = 0; i < numberOfInputs_; i++) {
+  std::vector<dataType> costs(numberOfInputs_);
+
+  const auto matchDiagram = [&](const int i) {
     Auction<dataType> auction = Auction<dataType>(
       current_bidder_diagrams_[i], barycenter_goods_[i], wasserstein_,
       geometrical_factor_, lambda_, 0.01, kdt, correspondance_kdt_map,
@@ -146,27 +151,17 @@ void PDBarycenter<dataType>::runMatchingAuction(
     std::vector<matchingTuple> matchings;
     dataType cost = auction.run(&matchings);
     all_matchings->at(i) = matchings;
-    // std::cout << "cost of matching " << i <<" : "<<cost<<std::endl;
-    // std::cout << "now total : " << *total_cost<<std::endl;
-
-    (*total_cost) += cost * cost;
-    // std::cout<< "Barycenter cost for diagram " << i <<" : "<< cost <<
-    // std::endl; std::cout<< "Number of biddings : " << n_biddings <<
-    // std::endl; Resizes the diagram which was enrich with diagonal bidders
-    // during the auction
+    costs[i] = cost * cost;
+    // Resizes the diagram which was enrich with diagonal bidders during the
+    // auction
     // TODO do this inside the auction !
     current_bidder_diagrams_[i].bidders_.resize(sizes[i]);
+  };
+  runPerDiagramTasks(sizes, matchDiagram);
+
+  for(const auto cost : costs) {
+    (*total_cost) += cost;
   }
-  /* to print matchings
-  for(long unsigned int i=0; i<(*all_matchings).size(); i++){
-              for (long unsigned int j = 0; j < (*all_matchings)[i].size(); j++)
-  { std::cout << get<0>((*all_matchings)[i][j]) << " " ; std::cout <<
-  get<1>((*all_matchings)[i][j]) << " " ; std::cout <<
-  get<2>((*all_matchings)[i][j]) << "  |   " ;
-              }
-      std::cout << "\n" ;
-          }
-  */
 }
 
 template <typename dataType>
@@ -19,8 +19,11 @@
 //
 #include <KDTree.h>
 //
+#include <algorithm>
 #include <array>
 #include <limits>
+#include <numeric>
+#include <random>
 
 #ifdef _WIN32
 #include <ciso646>
@@ -55,6 +58,7 @@ namespace ttk {
       cost_sad_ = 0;
       UseDeltaLim_ = false;
       distanceWritingOptions_ = 0;
+      mini_batch_size_ = 0;
       this->setDebugMsgPrefix("PersistenceDiagramClustering");
     };
 
@@ -99,6 +103,10 @@ namespace ttk {
     void initializeEmptyClusters();
     void initializeCentroids();
     void initializeCentroidsKMeanspp();
+    void initializeCentroidsFromInput(const vector<dataType> &min_persistence);
+    void applyInitialPrices();
+    void sampleMiniBatches(const bool full);
+    void computeCentroidPrices();
     void initializeAcceleratedKMeans();
     void initializeBarycenterComputers(vector<dataType> min_persistence);
     void printDistancesToFile();
@@ -226,6 +234,41 @@ namespace ttk {
       deltaLim_ = deltaLim;
     }
 
+    /// Number of diagrams used per iteration to update the centroids
+    /// (mini-batch k-means), 0 to use all of them.
+    inline void setMiniBatchSize(const int miniBatchSize) {
+      mini_batch_size_ = miniBatchSize;
+    }
+
+    /// Warm-start the clustering from previously computed centroids (one
+    /// vector of pairs per cluster and per pair type) instead of
+    /// initializing them from the input diagrams.
+    inline void setInitialCentroids(
+      const std::vector<std::vector<diagramTuple>> *centroids_min,
+      const std::vector<std::vector<diagramTuple>> *centroids_saddle,
+      const std::vector<std::vector<diagramTuple>> *centroids_max) {
+      initial_centroids_[0] = centroids_min;
+      initial_centroids_[1] = centroids_saddle;
+      initial_centroids_[2] = centroids_max;
+    }
+
+    /// Auction prices of the initial centroid pairs (same layout as the
+    /// initial centroids), used to warm-start the matchings.
+    inline void
+      setInitialPrices(const std::vector<std::vector<dataType>> *prices_min,
+                       const std::vector<std::vector<dataType>> *prices_saddle,
+                       const std::vector<std::vector<dataType>> *prices_max) {
+      initial_prices_[0] = prices_min;
+      initial_prices_[1] = prices_saddle;
+      initial_prices_[2] = prices_max;
+    }
+
+    /// Average auction prices of the final centroid pairs, in the order of
+    /// the final centroids returned by execute().
+    inline const std::vector<std::vector<dataType>> &getCentroidPrices() const {
+      return centroid_prices_;
+    }
+
     inline void printClustering() {
       std::string msg = "";
       for(int c = 0; c < k_; ++c) {
@@ -336,6 +379,21 @@ namespace ttk {
     std::vector<std::vector<int>> old_clustering_;
     std::vector<int> inv_clustering_;
 
+    // mini-batch: subset of every cluster used to update its centroid
+    int mini_batch_size_;
+    std::vector<std::vector<int>> batches_;
+    // diagrams whose centroid copy was not updated with the last batch
+    std::vector<bool> stale_;
+    std::mt19937 batch_generator_;
+
+    // warm start
+    std::array<const std::vector<std::vector<diagramTuple>> *, 3>
+      initial_centroids_{};
+    std::array<const std::vector<std::vector<dataType>> *, 3>
+      initial_prices_{};
+    std::array<std::vector<std::vector<dataType>>, 3> warm_prices_{};
+    std::vector<std::vector<dataType>> centroid_prices_;
+
     std::vector<std::vector<int>> centroids_sizes_;
 
     std::vector<bool> r_;
@@ -167,7 +167,12 @@ std::vector<int> PDClustering<dataType>::execute(
     }
 
     // Initializing centroids and clusters
-    if(use_kmeanspp_) {
+    const bool warm_start = initial_centroids_[0] != nullptr
+                            || initial_centroids_[1] != nullptr
+                            || initial_centroids_[2] != nullptr;
+    if(warm_start) {
+      initializeCentroidsFromInput(min_persistence);
+    } else if(use_kmeanspp_) {
       initializeCentroidsKMeanspp();
     } else {
       initializeCentroids();
@@ -181,6 +186,11 @@ std::vector<int> PDClustering<dataType>::execute(
       updateClusters();
       old_clustering_ = clustering_;
     }
+    if(warm_start) {
+      applyInitialPrices();
+    }
+    stale_.assign(numberOfInputs_, false);
+    batch_generator_.seed(deterministic_ ? 0 : std::random_device()());
     if(debugLevel_ > 3 && k_ > 1) {
       printMsg("Initial Clustering: ");
       printClustering();
@@ -480,6 +490,17 @@ std::vector<int> PDClustering<dataType>::execute(
       }
     }
     resetDosToOriginalValues();
+    if(!use_progressive_ && k_ > 1) {
+      clustering_ = old_clustering_; // reverting to last clustering
+    }
+    if(mini_batch_size_ > 0 && !matchings_only) {
+      // the mini-batches only provide the matchings of a subset of the
+      // diagrams: match every diagram to its final centroid
+      std::fill(stale_.begin(), stale_.end(), true);
+      updateCentroidsPosition(&min_off_diag_price, &min_diag_price,
+                              all_matchings_per_type_and_cluster, true);
+      resetDosToOriginalValues();
+    }
     {
       std::stringstream msg;
       if(matchings_only) {
@@ -493,9 +514,6 @@ std::vector<int> PDClustering<dataType>::execute(
     // dataType real_cost=0;
     // real_cost=computeRealCost();
     // cout<<"REAL COST : "<<real_cost<<endl;
-    if(!use_progressive_ && k_ > 1) {
-      clustering_ = old_clustering_; // reverting to last clustering
-    }
     invertClusters(); // this is to pass the old inverse clustering to the VTK
                       // wrapper
     if(k_ > 1) {
@@ -592,6 +610,8 @@ std::vector<int> PDClustering<dataType>::execute(
     }
   }
 
+  computeCentroidPrices();
+
   if(distanceWritingOptions_ == 1) {
     printDistancesToFile();
   } else if(distanceWritingOptions_ == 2) {
@@ -1173,6 +1193,147 @@ void PDClustering<dataType>::initializeCentroidsKMeanspp() {
   }
 }
 
+template <typename dataType>
+void PDClustering<dataType>::initializeCentroidsFromInput(
+  const vector<dataType> &min_persistence) {
+  std::array<std::vector<GoodDiagram<dataType>> *, 3> centroids{
+    &centroids_min_, &centroids_saddle_, &centroids_max_};
+
+  for(int i_crit = 0; i_crit < 3; i_crit++) {
+    warm_prices_[i_crit].assign(k_, std::vector<dataType>());
+    if(!original_dos[i_crit]) {
+      continue;
+    }
+    centroids[i_crit]->resize(k_);
+    const auto input = initial_centroids_[i_crit];
+    const auto prices = initial_prices_[i_crit];
+    if(input == nullptr) {
+      continue;
+    }
+    for(int c = 0; c < k_ && c < (int)input->size(); c++) {
+      GoodDiagram<dataType> &centroid = (*centroids[i_crit])[c];
+      for(size_t j = 0; j < (*input)[c].size(); ++j) {
+        diagramTuple t = (*input)[c][j];
+        // like the input diagrams, the progressive approach starts from the
+        // most persistent pairs of the centroids
+        if(use_progressive_ && std::get<4>(t) < min_persistence[i_crit]) {
+          continue;
+        }
+        Good<dataType> g(t, centroid.size(), lambda_);
+        centroid.addGood(g);
+        const bool has_price = prices != nullptr && c < (int)prices->size()
+                               && j < (*prices)[c].size();
+        warm_prices_[i_crit][c].push_back(has_price ? (*prices)[c][j] : 0);
+      }
+    }
+  }
+}
+
+template <typename dataType>
+void PDClustering<dataType>::applyInitialPrices() {
+  std::array<std::vector<GoodDiagram<dataType>> *, 3> copies{
+    &centroids_with_price_min_, &centroids_with_price_saddle_,
+    &centroids_with_price_max_};
+
+  for(int i_crit = 0; i_crit < 3; i_crit++) {
+    if(!original_dos[i_crit]) {
+      continue;
+    }
+    for(int c = 0; c < k_; ++c) {
+      const std::vector<dataType> &prices = warm_prices_[i_crit][c];
+      for(int idx : clustering_[c]) {
+        GoodDiagram<dataType> &copy = (*copies[i_crit])[idx];
+        for(int i = 0; i < copy.size() && i < (int)prices.size(); ++i) {
+          copy.get(i).setPrice(prices[i]);
+        }
+      }
+    }
+  }
+}
+
+template <typename dataType>
+void PDClustering<dataType>::sampleMiniBatches(const bool full) {
+  const bool use_batches
+    = !full && mini_batch_size_ > 0 && mini_batch_size_ < numberOfInputs_;
+
+  batches_.resize(k_);
+  for(int c = 0; c < k_; ++c) {
+    batches_[c] = clustering_[c];
+    if(use_batches && batches_[c].size() > 1) {
+      // each cluster contributes to the batch in proportion to its size
+      size_t batch_size = std::ceil((double)clustering_[c].size()
+                                    * mini_batch_size_ / numberOfInputs_);
+      batch_size
+        = std::max<size_t>(1, std::min(batch_size, batches_[c].size()));
+      std::shuffle(batches_[c].begin(), batches_[c].end(), batch_generator_);
+      // the centroid copies of the diagrams left out of the batch will not
+      // follow the centroid
+      for(size_t i = batch_size; i < batches_[c].size(); ++i) {
+        stale_[batches_[c][i]] = true;
+      }
+      batches_[c].resize(batch_size);
+      std::sort(batches_[c].begin(), batches_[c].end());
+    }
+
+    for(int idx : batches_[c]) {
+      if(!stale_[idx]) {
+        continue;
+      }
+      // restart the matching of an outdated diagram from the current centroid
+      if(original_dos[0]) {
+        centroids_with_price_min_[idx]
+          = centroidWithZeroPrices(centroids_min_[c]);
+        current_bidder_diagrams_min_[idx]
+          = diagramWithZeroPrices(current_bidder_diagrams_min_[idx]);
+      }
+      if(original_dos[1]) {
+        centroids_with_price_saddle_[idx]
+          = centroidWithZeroPrices(centroids_saddle_[c]);
+        current_bidder_diagrams_saddle_[idx]
+          = diagramWithZeroPrices(current_bidder_diagrams_saddle_[idx]);
+      }
+      if(original_dos[2]) {
+        centroids_with_price_max_[idx]
+          = centroidWithZeroPrices(centroids_max_[c]);
+        current_bidder_diagrams_max_[idx]
+          = diagramWithZeroPrices(current_bidder_diagrams_max_[idx]);
+      }
+      stale_[idx] = false;
+    }
+  }
+}
+
+template <typename dataType>
+void PDClustering<dataType>::computeCentroidPrices() {
+  std::array<const std::vector<GoodDiagram<dataType>> *, 3> centroids{
+    &centroids_min_, &centroids_saddle_, &centroids_max_};
+  std::array<const std::vector<GoodDiagram<dataType>> *, 3> copies{
+    &centroids_with_price_min_, &centroids_with_price_saddle_,
+    &centroids_with_price_max_};
+  const std::array<bool, 3> dos{do_min_, do_sad_, do_max_};
+
+  centroid_prices_.assign(k_, std::vector<dataType>());
+  for(int c = 0; c < k_; ++c) {
+    for(int i_crit = 0; i_crit < 3; i_crit++) {
+      if(!dos[i_crit]) {
+        continue;
+      }
+      // every diagram of the cluster holds its own prices for the centroid
+      // pairs: average them
+      const int size = (*centroids[i_crit])[c].size();
+      std::vector<dataType> prices(size, 0);
+      for(int idx : clustering_[c]) {
+        const GoodDiagram<dataType> &copy = (*copies[i_crit])[idx];
+        for(int i = 0; i < size && i < copy.size(); ++i) {
+          prices[i] += copy.get(i).getPrice() / clustering_[c].size();
+        }
+      }
+      centroid_prices_[c].insert(
+        centroid_prices_[c].end(), prices.begin(), prices.end());
+    }
+  }
+}
+
 template <typename dataType>
 void PDClustering<dataType>::initializeAcceleratedKMeans() {
   // r_ is a vector stating for each diagram if its distance to its centroid is
@@ -1663,13 +1824,11 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
     &all_matchings_per_type_and_cluster,
   int only_matchings) {
   barycenter_inputs_reset_flag = true;
+  sampleMiniBatches(only_matchings);
   std::vector<dataType> max_shift_vector(3);
   max_shift_vector[0] = 0;
   max_shift_vector[1] = 0;
   max_shift_vector[2] = 0;
-  dataType max_shift_c_min = 0;
-  dataType max_shift_c_sad = 0;
-  dataType max_shift_c_max = 0;
   dataType max_wasserstein_shift = 0;
   bool precision_min = true;
   bool precision_sad = true;
@@ -1687,13 +1846,46 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
   if(do_max_) {
     cost_max_ = 0;
   }
+
+  // The clusters are processed in parallel, from the largest to the smallest,
+  // and the auctions of each cluster are split into tasks that idle threads
+  // pick up. Shared results are stored per cluster and gathered afterwards.
+  std::vector<int> cluster_order(k_);
+  std::iota(cluster_order.begin(), cluster_order.end(), 0);
+  std::stable_sort(cluster_order.begin(), cluster_order.end(),
+                   [this](const int a, const int b) {
+                     return batches_[a].size() > batches_[b].size();
+                   });
+  std::vector<std::array<dataType, 3>> cluster_costs(k_);
+  std::vector<std::array<dataType, 3>> cluster_shifts(k_);
+  std::vector<std::array<bool, 3>> cluster_precisions(k_);
+  std::vector<dataType> cluster_wasserstein_shifts(k_);
+  // prices are indexed by the position of the diagrams in their cluster
+  std::vector<std::vector<std::vector<dataType>>> cluster_min_prices(k_),
+    cluster_min_diag_prices(k_);
+
   // std::cout<<"here 1"<<std::endl;
-  for(int c = 0; c < k_; ++c) {
-    if(clustering_[c].size() > 0) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int i_cluster = 0; i_cluster < k_; ++i_cluster) {
+    const int c = cluster_order[i_cluster];
+    if(batches_[c].size() > 0) {
+      cluster_min_prices[c] = *min_price;
+      cluster_min_diag_prices[c] = *min_diag_price;
+      cluster_costs[c] = {0, 0, 0};
+      cluster_shifts[c] = {0, 0, 0};
+      cluster_precisions[c] = {true, true, true};
+      dataType max_shift_c_min = 0;
+      dataType max_shift_c_sad = 0;
+      dataType max_shift_c_max = 0;
       std::vector<GoodDiagram<dataType>> centroids_with_price_min,
         centroids_with_price_sad, centroids_with_price_max;
+      // extrapolates the cost of the batch to the whole cluster
+      const dataType batch_weight
+        = (dataType)clustering_[c].size() / batches_[c].size();
       int count = 0;
-      for(int idx : clustering_[c]) {
+      for(int idx : batches_[c]) {
         // Timer time_first_thing;
         int number_of_points_min = 0;
         int number_of_points_max = 0;
@@ -1826,7 +2018,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         std::vector<BidderDiagram<dataType>> diagrams_c_min;
         if(barycenter_inputs_reset_flag) {
           // cout<<"resetting inputs bec of flag"<<endl;
-          for(int idx : clustering_[c]) {
+          for(int idx : batches_[c]) {
             diagrams_c_min.push_back(current_bidder_diagrams_min_[idx]);
           }
           sizes.resize(diagrams_c_min.size());
@@ -1836,11 +2028,11 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
           barycenter_computer_min_[c].setNumberOfInputs(diagrams_c_min.size());
           barycenter_computer_min_[c].setCurrentBidders(diagrams_c_min);
 
-          vector<GoodDiagram<dataType>> barycenter_goods(clustering_[c].size());
-          for(unsigned int i_diagram = 0; i_diagram < clustering_[c].size();
+          vector<GoodDiagram<dataType>> barycenter_goods(batches_[c].size());
+          for(unsigned int i_diagram = 0; i_diagram < batches_[c].size();
               i_diagram++) {
             barycenter_goods[i_diagram]
-              = centroids_with_price_min_[clustering_[c][i_diagram]];
+              = centroids_with_price_min_[batches_[c][i_diagram]];
           }
           barycenter_computer_min_[c].setCurrentBarycenter(barycenter_goods);
           all_matchings.resize(diagrams_c_min.size());
@@ -1885,7 +2077,8 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         // min "; cout<<"run matchings "<<endl;
         barycenter_computer_min_[c].runMatching(
           &total_cost, epsilon_[0], sizes, *pair.first, pair.second,
-          &(min_diag_price->at(0)), &(min_price->at(0)), &(all_matchings),
+          &(cluster_min_diag_prices[c][0]), &(cluster_min_prices[c][0]),
+          &(all_matchings),
           use_kdt, only_matchings);
         for(unsigned int ii = 0; ii < all_matchings.size(); ii++) {
           all_matchings_per_type_and_cluster[c][0][ii].resize(
@@ -1897,9 +2090,9 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         }
         // cout<<"matchings done"<<endl;
         // std::cout<<"min : runned, now updating barycenter"<<std::endl;
-        precision_min
+        cluster_precisions[c][0]
           = barycenter_computer_min_[c].isPrecisionObjectiveMet(deltaLim_, 0);
-        cost_min_ += sqrt(total_cost);
+        cluster_costs[c][0] = sqrt(batch_weight * total_cost);
         Timer time_update;
         if(!only_matchings) {
           max_shift_c_min
@@ -1907,9 +2100,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         }
         // cout<<"time update min "<<time_update.getElapsedTime()<<endl;
         // std::cout<<"min : barycenter updated"<<std::endl;
-        if(max_shift_c_min > max_shift_vector[0]) {
-          max_shift_vector[0] = max_shift_c_min;
-        }
+        cluster_shifts[c][0] = max_shift_c_min;
 
         // Now that barycenters and diagrams are updated in
         // PDBarycenter class, we import the results here.
@@ -1922,7 +2113,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         // for(int ic=0;ic<clustering_[c].size();ic++){
         // cout<<" "<<clustering_[c][ic];}
         // cout<<endl;
-        for(int idx : clustering_[c]) {
+        for(int idx : batches_[c]) {
           // cout<<"test "<<i<<" "<<current_bidder_diagrams_min_.size()<<"
           // "<<diagrams_c_min.size()<<endl;
           current_bidder_diagrams_min_[idx] = diagrams_c_min[i];
@@ -1935,7 +2126,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
 
         GoodDiagram<dataType> old_centroid = centroids_min_[c];
         centroids_min_[c] = centroidWithZeroPrices(
-          centroids_with_price_min_[clustering_[c][0]]);
+          centroids_with_price_min_[batches_[c][0]]);
         // std::cout<<"yo"<<std::endl;
         // cout<<"here"<<endl;
         if(use_accelerated_) {
@@ -1953,7 +2144,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
 
         std::vector<BidderDiagram<dataType>> diagrams_c_min;
         if(barycenter_inputs_reset_flag) {
-          for(int idx : clustering_[c]) {
+          for(int idx : batches_[c]) {
             diagrams_c_min.push_back(current_bidder_diagrams_saddle_[idx]);
           }
           sizes.resize(diagrams_c_min.size());
@@ -1962,11 +2153,11 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
           }
           barycenter_computer_sad_[c].setNumberOfInputs(diagrams_c_min.size());
           barycenter_computer_sad_[c].setCurrentBidders(diagrams_c_min);
-          vector<GoodDiagram<dataType>> barycenter_goods(clustering_[c].size());
-          for(unsigned int i_diagram = 0; i_diagram < clustering_[c].size();
+          vector<GoodDiagram<dataType>> barycenter_goods(batches_[c].size());
+          for(unsigned int i_diagram = 0; i_diagram < batches_[c].size();
               i_diagram++) {
             barycenter_goods[i_diagram]
-              = centroids_with_price_saddle_[clustering_[c][i_diagram]];
+              = centroids_with_price_saddle_[batches_[c][i_diagram]];
           }
           barycenter_computer_sad_[c].setCurrentBarycenter(barycenter_goods);
           all_matchings.resize(diagrams_c_min.size());
@@ -2003,7 +2194,8 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         // std::cout<<"sad : run matchings"<<std::endl;
         barycenter_computer_sad_[c].runMatching(
           &total_cost, epsilon_[1], sizes, *pair.first, pair.second,
-          &(min_diag_price->at(1)), &(min_price->at(1)), &(all_matchings),
+          &(cluster_min_diag_prices[c][1]), &(cluster_min_prices[c][1]),
+          &(all_matchings),
           use_kdt, only_matchings);
         for(unsigned int ii = 0; ii < all_matchings.size(); ii++) {
           all_matchings_per_type_and_cluster[c][1][ii].resize(
@@ -2014,18 +2206,16 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
           all_matchings_per_type_and_cluster[c][1][ii].resize(0);
         }
 
-        precision_sad
+        cluster_precisions[c][1]
           = barycenter_computer_sad_[c].isPrecisionObjectiveMet(deltaLim_, 0);
         if(!only_matchings) {
           max_shift_c_sad
             = barycenter_computer_sad_[c].updateBarycenter(all_matchings);
         }
         // std::cout<<"sad : runned, now updating barycenter"<<std::endl;
-        cost_sad_ += sqrt(total_cost);
+        cluster_costs[c][1] = sqrt(batch_weight * total_cost);
         // std::cout<<"sad : barycenter updated"<<std::endl;
-        if(max_shift_c_sad > max_shift_vector[1]) {
-          max_shift_vector[1] = max_shift_c_sad;
-        }
+        cluster_shifts[c][1] = max_shift_c_sad;
 
         // Now that barycenters and diagrams are updated in PDBarycenter class,
         // we import the results here.
@@ -2033,14 +2223,14 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         centroids_with_price_sad
           = barycenter_computer_sad_[c].getCurrentBarycenter();
         int i = 0;
-        for(int idx : clustering_[c]) {
+        for(int idx : batches_[c]) {
           current_bidder_diagrams_saddle_[idx] = diagrams_c_min[i];
           centroids_with_price_saddle_[idx] = centroids_with_price_sad[i];
           i++;
         }
         GoodDiagram<dataType> old_centroid = centroids_saddle_[c];
         centroids_saddle_[c] = centroidWithZeroPrices(
-          centroids_with_price_saddle_[clustering_[c][0]]);
+          centroids_with_price_saddle_[batches_[c][0]]);
         if(use_accelerated_)
           wasserstein_shift
             += computeDistance(old_centroid, centroids_saddle_[c], 0.01);
@@ -2057,7 +2247,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         std::vector<int> sizes;
         std::vector<BidderDiagram<dataType>> diagrams_c_min;
         if(barycenter_inputs_reset_flag) {
-          for(int idx : clustering_[c]) {
+          for(int idx : batches_[c]) {
             diagrams_c_min.push_back(current_bidder_diagrams_max_[idx]);
           }
           sizes.resize(diagrams_c_min.size());
@@ -2066,11 +2256,11 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
           }
           barycenter_computer_max_[c].setNumberOfInputs(diagrams_c_min.size());
           barycenter_computer_max_[c].setCurrentBidders(diagrams_c_min);
-          vector<GoodDiagram<dataType>> barycenter_goods(clustering_[c].size());
-          for(unsigned int i_diagram = 0; i_diagram < clustering_[c].size();
+          vector<GoodDiagram<dataType>> barycenter_goods(batches_[c].size());
+          for(unsigned int i_diagram = 0; i_diagram < batches_[c].size();
               i_diagram++) {
             barycenter_goods[i_diagram]
-              = centroids_with_price_max_[clustering_[c][i_diagram]];
+              = centroids_with_price_max_[batches_[c][i_diagram]];
           }
           // cout<<"BARYCENTER SIZE "<<barycenter_goods[0].size()<<endl;
           barycenter_computer_max_[c].setCurrentBarycenter(barycenter_goods);
@@ -2157,7 +2347,8 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         // cout<<"size centroid "<<centroids_with_price_max[c].size()<<endl;
         barycenter_computer_max_[c].runMatching(
           &total_cost, epsilon_[2], sizes, *pair.first, pair.second,
-          &(min_diag_price->at(2)), &(min_price->at(2)), &(all_matchings),
+          &(cluster_min_diag_prices[c][2]), &(cluster_min_prices[c][2]),
+          &(all_matchings),
           use_kdt, only_matchings);
         for(unsigned int ii = 0; ii < all_matchings.size(); ii++) {
           all_matchings_per_type_and_cluster[c][2][ii].resize(
@@ -2167,12 +2358,12 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         for(int ii = all_matchings.size(); ii < numberOfInputs_; ii++) {
           all_matchings_per_type_and_cluster[c][2][ii].resize(0);
         }
-        precision_max
+        cluster_precisions[c][2]
           = barycenter_computer_max_[c].isPrecisionObjectiveMet(deltaLim_, 0);
 
         // std::cout<<"max : runned, now updating barycenter"<<std::endl;
         // cout<<" COST FROM MATCHINGS "<<sqrt(total_cost)<<endl;
-        cost_max_ += sqrt(total_cost);
+        cluster_costs[c][2] = sqrt(batch_weight * total_cost);
         Timer time_update;
         // for(int iii=0; iii<centroids_with_price_max.size(); iii++){
         //     cout<<"BARYCENTER SIZE BEFORE UPDATE
@@ -2184,9 +2375,7 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         }
         // cout<<"time update max "<<time_update.getElapsedTime()<<endl;
         // std::cout<<"max: barycenter updated"<<std::endl;
-        if(max_shift_c_max > max_shift_vector[2]) {
-          max_shift_vector[2] = max_shift_c_max;
-        }
+        cluster_shifts[c][2] = max_shift_c_max;
 
         // Now that barycenters and diagrams are updated in PDBarycenter class,
         // we import the results here.
@@ -2198,14 +2387,14 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         //     "<<centroids_with_price_max[iii].size()<<endl;
         // }
         int i = 0;
-        for(int idx : clustering_[c]) {
+        for(int idx : batches_[c]) {
           current_bidder_diagrams_max_[idx] = diagrams_c_min[i];
           centroids_with_price_max_[idx] = centroids_with_price_max[i];
           i++;
         }
         GoodDiagram<dataType> old_centroid = centroids_max_[c];
         centroids_max_[c] = centroidWithZeroPrices(
-          centroids_with_price_max_[clustering_[c][0]]);
+          centroids_with_price_max_[batches_[c][0]]);
         if(use_accelerated_) {
           // cout<<"here"<<endl;
           wasserstein_shift
@@ -2214,11 +2403,8 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
         }
       }
 
-      cost_ = cost_min_ + cost_sad_ + cost_max_;
+      cluster_wasserstein_shifts[c] = wasserstein_shift;
       // std::cout<<"here"<<std::endl;
-      if(wasserstein_shift > max_wasserstein_shift) {
-        max_wasserstein_shift = wasserstein_shift;
-      }
       // std::cout<<"there"<<std::endl;
       if(use_accelerated_) {
         for(int i = 0; i < numberOfInputs_; ++i) {
@@ -2239,12 +2425,50 @@ std::vector<dataType> PDClustering<dataType>::updateCentroidsPosition(
             Geometry::pow(u_[idx], 1. / wasserstein_)
               + Geometry::pow(wasserstein_shift, 1. / wasserstein_),
             wasserstein_);
-          r_[idx] = true;
         }
       }
       // cout<<"there end"<<endl;
     }
   }
+
+  // gather the results of the clusters, in the sequential order
+  for(int c = 0; c < k_; ++c) {
+    if(batches_[c].size() == 0) {
+      continue;
+    }
+    cost_min_ += cluster_costs[c][0];
+    cost_sad_ += cluster_costs[c][1];
+    cost_max_ += cluster_costs[c][2];
+    for(int i_crit = 0; i_crit < 3; i_crit++) {
+      if(cluster_shifts[c][i_crit] > max_shift_vector[i_crit]) {
+        max_shift_vector[i_crit] = cluster_shifts[c][i_crit];
+      }
+      for(size_t i = 0; i < batches_[c].size(); ++i) {
+        (*min_price)[i_crit][i] = cluster_min_prices[c][i_crit][i];
+        (*min_diag_price)[i_crit][i] = cluster_min_diag_prices[c][i_crit][i];
+      }
+    }
+    if(do_min_) {
+      precision_min = cluster_precisions[c][0];
+    }
+    if(do_sad_) {
+      precision_sad = cluster_precisions[c][1];
+    }
+    if(do_max_) {
+      precision_max = cluster_precisions[c][2];
+    }
+    if(cluster_wasserstein_shifts[c] > max_wasserstein_shift) {
+      max_wasserstein_shift = cluster_wasserstein_shifts[c];
+    }
+    if(use_accelerated_) {
+      // r_ is a bit vector: not written concurrently
+      for(int idx : clustering_[c]) {
+        r_[idx] = true;
+      }
+    }
+  }
+  cost_ = cost_min_ + cost_sad_ + cost_max_;
+
   // Normally return max_shift, but it seems there is a bug
   // yielding max_shift > 100 * max_wasserstein_shift
   // which should logically not really happen...
@@ -13,7 +13,21 @@
 /// Proc. of IEEE VIS 2019.\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2019.
 ///
+/// When DistanceBackend is not the Wasserstein auction, diagrams are
+/// clustered with a Lloyd-like algorithm in an approximate metric: K-Medoids
+/// with the Sliced Wasserstein distance, or K-Means on persistence images. The
+/// output centroids are then the input diagrams closest to the cluster
+/// centers and no matchings are produced.
+///
+/// With the Wasserstein auction, the centroids can be updated from random
+/// subsets of the diagrams at each iteration (mini-batch k-means, see
+/// MiniBatchSize) and the clustering can be warm-started from the centroids
+/// (and the auction prices) of a previous run (see setInitialCentroids() and
+/// getCentroidPrices()).
+///
 /// \sa ttkPersistenceDiagramClustering
+/// \sa SlicedWassersteinDistance
+/// \sa PersistenceImage
 
 #pragma once
 
@@ -45,6 +59,12 @@
 //
 #include <PDClustering.h>
 //
+#include <PersistenceImage.h>
+#include <SlicedWassersteinDistance.h>
+//
+#include <array>
+#include <numeric>
+#include <random>
 
 using namespace std;
 using namespace ttk;
@@ -54,6 +74,21 @@ namespace ttk {
   class PersistenceDiagramClustering : virtual public Debug {
 
   public:
+    using diagramType = std::tuple<ttk::SimplexId,
+                                   ttk::CriticalType,
+                                   ttk::SimplexId,
+                                   ttk::CriticalType,
+                                   double,
+                                   ttk::SimplexId,
+                                   double,
+                                   float,
+                                   float,
+                                   float,
+                                   double,
+                                   float,
+                                   float,
+                                   float>;
+
     PersistenceDiagramClustering() {
       this->setDebugMsgPrefix("PersistenceDiagramClustering");
     };
@@ -71,7 +106,30 @@ namespace ttk {
       return (var >= 0) ? var : -var;
     }
 
+    /// Warm-start the clustering from previously computed centroids (and
+    /// optionally, the auction prices of their pairs, as returned by
+    /// getCentroidPrices()). Pass nullptr to initialize the centroids from
+    /// the input diagrams.
+    inline void
+      setInitialCentroids(std::vector<std::vector<diagramType>> *centroids,
+                          std::vector<std::vector<double>> *prices = nullptr) {
+      InitialCentroids = centroids;
+      InitialPrices = prices;
+    }
+
+    /// Average auction prices of the pairs of the last computed centroids
+    inline const std::vector<std::vector<double>> &getCentroidPrices() const {
+      return CentroidPrices;
+    }
+
   protected:
+    template <class dataType>
+    std::vector<int> executeApproximate(
+      const std::array<const std::vector<std::vector<diagramTuple>> *, 3>
+        &data,
+      const std::array<bool, 3> &dos,
+      std::vector<std::vector<diagramTuple>> &final_centroids);
+
     // Critical pairs used for clustering
     // 0:min-saddles ; 1:saddles-saddles ; 2:sad-max ; else : all
 
@@ -93,6 +151,18 @@ namespace ttk {
     int NumberOfClusters{1};
     bool UseAccelerated{false};
     bool UseKmeansppInit{false};
+    // number of diagrams per iteration for mini-batch k-means (0: all)
+    int MiniBatchSize{0};
+
+    std::vector<std::vector<diagramType>> *InitialCentroids{nullptr};
+    std::vector<std::vector<double>> *InitialPrices{nullptr};
+    std::vector<std::vector<double>> CentroidPrices{};
+
+    // 0: Wasserstein (auction), 1: Sliced Wasserstein, 2: persistence images
+    int DistanceBackend{0};
+    int NumberOfDirections{16};
+    int ImageResolution{32};
+    double ImageSigma{0.05};
 
     int points_added_;
     int points_deleted_;
@@ -108,6 +178,7 @@ namespace ttk {
     std::vector<std::vector<std::vector<matchingTuple>>> &all_matchings) {
 
     const int numberOfInputs_ = intermediateDiagrams.size();
+    CentroidPrices.clear();
     Timer tm;
     {
       printMsg("Clustering " + std::to_string(numberOfInputs_) + " diagrams in "
@@ -193,10 +264,25 @@ namespace ttk {
       printMsg(msg.str());
     }
 
+    if(DistanceBackend != 0) {
+      inv_clustering = this->executeApproximate<dataType>(
+        {&data_min, &data_sad, &data_max}, {do_min, do_sad, do_max},
+        final_centroids);
+      // no matchings with the approximate metrics, one entry per output
+      // centroid (there are fewer clusters than requested with few inputs)
+      all_matchings.resize(final_centroids.size());
+      for(size_t c = 0; c < all_matchings.size(); c++) {
+        all_matchings[c].resize(numberOfInputs_);
+      }
+      printMsg("Complete", 1, tm.getElapsedTime(), threadNumber_);
+      return inv_clustering;
+    }
+
     vector<vector<vector<vector<matchingTuple>>>>
       all_matchings_per_type_and_cluster;
     PDClustering<dataType> KMeans = PDClustering<dataType>();
     KMeans.setNumberOfInputs(numberOfInputs_);
+    KMeans.setThreadNumber(threadNumber_);
     KMeans.setWasserstein(WassersteinMetric);
     KMeans.setUseProgressive(UseProgressive);
     KMeans.setAccelerated(UseAccelerated);
@@ -212,12 +298,65 @@ namespace ttk {
     KMeans.setDistanceWritingOptions(DistanceWritingOptions);
     KMeans.setKMeanspp(UseKmeansppInit);
     KMeans.setK(NumberOfClusters);
+    KMeans.setMiniBatchSize(MiniBatchSize);
     KMeans.setDiagrams(&data_min, &data_sad, &data_max);
     KMeans.setDos(do_min, do_sad, do_max);
+
+    // Split the warm-start centroids by pair type, as the input diagrams
+    std::vector<std::vector<diagramTuple>> init_min(NumberOfClusters),
+      init_sad(NumberOfClusters), init_max(NumberOfClusters);
+    std::vector<std::vector<dataType>> price_min(NumberOfClusters),
+      price_sad(NumberOfClusters), price_max(NumberOfClusters);
+    if(InitialCentroids != nullptr) {
+      if((int)InitialCentroids->size() != NumberOfClusters) {
+        printWrn("Number of initial centroids ("
+                 + std::to_string(InitialCentroids->size())
+                 + ") differs from the number of clusters, ignoring them");
+      } else {
+        printMsg("Warm start from " + std::to_string(NumberOfClusters)
+                 + " initial centroid(s)");
+        for(int c = 0; c < NumberOfClusters; ++c) {
+          const auto &centroid = (*InitialCentroids)[c];
+          for(size_t j = 0; j < centroid.size(); ++j) {
+            const diagramTuple t = centroid[j];
+            const BNodeType nt1 = std::get<1>(t);
+            const BNodeType nt2 = std::get<3>(t);
+            const dataType price
+              = (InitialPrices != nullptr && c < (int)InitialPrices->size()
+                 && j < (*InitialPrices)[c].size())
+                  ? (*InitialPrices)[c][j]
+                  : 0;
+            if(std::get<4>(t) <= 0) {
+              continue;
+            }
+            if(nt1 == BLocalMax || nt2 == BLocalMax) {
+              init_max[c].push_back(t);
+              price_max[c].push_back(price);
+            } else if(nt1 == BLocalMin || nt2 == BLocalMin) {
+              init_min[c].push_back(t);
+              price_min[c].push_back(price);
+            } else {
+              init_sad[c].push_back(t);
+              price_sad[c].push_back(price);
+            }
+          }
+        }
+        KMeans.setInitialCentroids(&init_min, &init_sad, &init_max);
+        KMeans.setInitialPrices(&price_min, &price_sad, &price_max);
+      }
+    }
+
     inv_clustering
       = KMeans.execute(final_centroids, all_matchings_per_type_and_cluster);
     vector<vector<int>> centroids_sizes = KMeans.get_centroids_sizes();
 
+    const auto &centroidPrices = KMeans.getCentroidPrices();
+    CentroidPrices.resize(centroidPrices.size());
+    for(size_t c = 0; c < centroidPrices.size(); ++c) {
+      CentroidPrices[c].assign(
+        centroidPrices[c].begin(), centroidPrices[c].end());
+    }
+
     /// Reconstruct matchings
     //
     std::vector<int> cluster_size;
@@ -322,4 +461,274 @@ namespace ttk {
     printMsg("Complete", 1, tm.getElapsedTime(), threadNumber_);
     return inv_clustering;
   }
+  template <class dataType>
+  std::vector<int> PersistenceDiagramClustering::executeApproximate(
+    const std::array<const std::vector<std::vector<diagramTuple>> *, 3> &data,
+    const std::array<bool, 3> &dos,
+    std::vector<std::vector<diagramTuple>> &final_centroids) {
+
+    const int nDiags = data[0]->size();
+    const int k = std::max(1, std::min(NumberOfClusters, nDiags));
+    const bool useImages = (DistanceBackend == 2);
+    Timer tm;
+
+    if(nDiags == 0) {
+      final_centroids.clear();
+      final_centroids.resize(k);
+      return {};
+    }
+
+    if(useImages) {
+      printMsg("K-Means on " + std::to_string(ImageResolution) + "x"
+               + std::to_string(ImageResolution) + " persistence images");
+    } else {
+      printMsg("K-Medoids with the Sliced Wasserstein distance ("
+               + std::to_string(NumberOfDirections) + " directions)");
+    }
+
+    const auto getPairs = [](const std::vector<diagramTuple> &diag,
+                             std::vector<double> &births,
+                             std::vector<double> &deaths) {
+      births.resize(diag.size());
+      deaths.resize(diag.size());
+      for(size_t j = 0; j < diag.size(); ++j) {
+        births[j] = std::get<6>(diag[j]);
+        deaths[j] = std::get<10>(diag[j]);
+      }
+    };
+
+    // 1. diagram signatures: sorted projections per pair type, or
+    // persistence images concatenated over the pair types
+    SlicedWassersteinDistance sw{};
+    sw.setNumberOfDirections(NumberOfDirections);
+    PersistenceImage pi{};
+    pi.setResolution(ImageResolution);
+    pi.setSigma(ImageSigma);
+
+    std::array<std::vector<SlicedWassersteinDistance::Projections>, 3> projs{};
+    std::vector<std::vector<double>> images(useImages ? nDiags : 0);
+
+    for(size_t t = 0; t < 3; ++t) {
+      if(!dos[t]) {
+        continue;
+      }
+      const auto &tDiags = *data[t];
+
+      if(useImages) {
+        double minBirth{std::numeric_limits<double>::max()};
+        double maxBirth{std::numeric_limits<double>::lowest()};
+        double maxPers{};
+        for(const auto &diag : tDiags) {
+          for(const auto &pair : diag) {
+            minBirth = std::min(minBirth, (double)std::get<6>(pair));
+            maxBirth = std::max(maxBirth, (double)std::get<6>(pair));
+            maxPers = std::max(
+              maxPers, (double)(std::get<10>(pair) - std::get<6>(pair)));
+          }
+        }
+        if(minBirth > maxBirth) {
+          minBirth = maxBirth = 0.0;
+        }
+        pi.setBounds(minBirth, maxBirth, maxPers);
+      } else {
+        projs[t].resize(nDiags);
+      }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(int i = 0; i < nDiags; ++i) {
+        std::vector<double> births{}, deaths{};
+        getPairs(tDiags[i], births, deaths);
+        if(useImages) {
+          std::vector<double> image{};
+          pi.computeImage(births, deaths, image);
+          images[i].insert(images[i].end(), image.begin(), image.end());
+        } else {
+          sw.computeProjections(births, deaths, projs[t][i]);
+        }
+      }
+    }
+
+    // Sliced Wasserstein distance between two input diagrams
+    const auto swDist = [&](const int a, const int b) {
+      double dist{};
+      for(size_t t = 0; t < 3; ++t) {
+        if(dos[t]) {
+          dist += sw.computeDistance(projs[t][a], projs[t][b]);
+        }
+      }
+      return dist;
+    };
+    // squared L2 distance between persistence images
+    const auto l2Dist = [](const std::vector<double> &a,
+                           const std::vector<double> &b) {
+      const auto d = PersistenceImage::computeDistance(a, b);
+      return d * d;
+    };
+    const auto diagDist = [&](const int a, const int b) {
+      return useImages ? l2Dist(images[a], images[b]) : swDist(a, b);
+    };
+
+    // 2. seeding, same conventions as the auction-based clustering
+    std::mt19937 gen(Deterministic ? 0 : std::random_device{}());
+    std::vector<int> seeds{};
+    if(UseKmeansppInit) {
+      std::uniform_int_distribution<> first(0, nDiags - 1);
+      seeds.emplace_back(Deterministic ? 0 : first(gen));
+      std::vector<double> minDist(nDiags, std::numeric_limits<double>::max());
+      while((int)seeds.size() < k) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(int i = 0; i < nDiags; ++i) {
+          minDist[i] = std::min(minDist[i], diagDist(i, seeds.back()));
+        }
+        if(Deterministic) {
+          seeds.emplace_back(std::distance(
+            minDist.begin(), std::max_element(minDist.begin(), minDist.end())));
+        } else {
+          std::discrete_distribution<> dd(minDist.begin(), minDist.end());
+          seeds.emplace_back(dd(gen));
+        }
+      }
+    } else {
+      std::vector<int> idx(nDiags);
+      std::iota(idx.begin(), idx.end(), 0);
+      if(!Deterministic) {
+        std::shuffle(idx.begin(), idx.end(), gen);
+      }
+      seeds.assign(idx.begin(), idx.begin() + k);
+    }
+
+    // 3. Lloyd iterations
+    std::vector<int> inv_clustering(nDiags, -1);
+    std::vector<int> medoids{seeds};
+    std::vector<std::vector<double>> centers(useImages ? k : 0);
+    for(int c = 0; c < (int)centers.size(); ++c) {
+      centers[c] = images[seeds[c]];
+    }
+    const auto distToCenter = [&](const int i, const int c) {
+      return useImages ? l2Dist(images[i], centers[c]) : swDist(i, medoids[c]);
+    };
+
+    // maximum number of cluster members used to evaluate medoid candidates
+    const size_t maxSampleSize = 64;
+    const int maxIterations = 100;
+    int iter = 0;
+
+    for(; iter < maxIterations; ++iter) {
+      int changed = 0;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_) \
+  reduction(+ : changed)
+#endif // TTK_ENABLE_OPENMP
+      for(int i = 0; i < nDiags; ++i) {
+        int best = 0;
+        double bestDist = distToCenter(i, 0);
+        for(int c = 1; c < k; ++c) {
+          const auto dist = distToCenter(i, c);
+          if(dist < bestDist) {
+            bestDist = dist;
+            best = c;
+          }
+        }
+        if(best != inv_clustering[i]) {
+          inv_clustering[i] = best;
+          changed++;
+        }
+      }
+
+      if(changed == 0 || tm.getElapsedTime() > TimeLimit) {
+        break;
+      }
+
+      std::vector<std::vector<int>> clusters(k);
+      for(int i = 0; i < nDiags; ++i) {
+        clusters[inv_clustering[i]].emplace_back(i);
+      }
+
+      for(int c = 0; c < k; ++c) {
+        const auto &members = clusters[c];
+        if(members.empty()) {
+          // keep the previous center
+          continue;
+        }
+        if(useImages) {
+          auto &center = centers[c];
+          std::fill(center.begin(), center.end(), 0.0);
+          for(const auto m : members) {
+            for(size_t j = 0; j < center.size(); ++j) {
+              center[j] += images[m][j];
+            }
+          }
+          for(auto &v : center) {
+            v /= members.size();
+          }
+        } else {
+          // the medoid minimizes the distance to (a sample of) the members
+          std::vector<int> sample{members};
+          if(sample.size() > maxSampleSize) {
+            std::shuffle(sample.begin(), sample.end(), gen);
+            sample.resize(maxSampleSize);
+          }
+          std::vector<double> cost(members.size());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+          for(size_t i = 0; i < members.size(); ++i) {
+            for(const auto s : sample) {
+              cost[i] += swDist(members[i], s);
+            }
+          }
+          medoids[c] = members[std::distance(
+            cost.begin(), std::min_element(cost.begin(), cost.end()))];
+        }
+      }
+    }
+
+    this->printMsg("Converged in " + std::to_string(iter + 1) + " iteration(s)",
+                   debug::Priority::DETAIL);
+
+    // 4. output the input diagram closest to every cluster center
+    final_centroids.clear();
+    final_centroids.resize(k);
+    for(int c = 0; c < k; ++c) {
+      int rep = medoids[c];
+      if(useImages) {
+        double minDist = std::numeric_limits<double>::max();
+        for(int i = 0; i < nDiags; ++i) {
+          if(inv_clustering[i] != c) {
+            continue;
+          }
+          const auto dist = l2Dist(images[i], centers[c]);
+          if(dist < minDist) {
+            minDist = dist;
+            rep = i;
+          }
+        }
+      }
+      for(size_t t = 0; t < 3; ++t) {
+        if(dos[t]) {
+          const auto &diag = (*data[t])[rep];
+          final_centroids[c].insert(
+            final_centroids[c].end(), diag.begin(), diag.end());
+        }
+      }
+    }
+
+    if(k > 1) {
+      std::vector<int> sizes(k);
+      for(const auto c : inv_clustering) {
+        sizes[c]++;
+      }
+      std::string msg{"Cluster sizes:"};
+      for(const auto size : sizes) {
+        msg.append(" " + std::to_string(size));
+      }
+      this->printMsg(msg);
+    }
+
+    return inv_clustering;
+  }
 } // namespace ttk
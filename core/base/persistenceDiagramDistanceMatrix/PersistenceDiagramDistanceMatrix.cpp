@@ -111,10 +111,41 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       break;
   }
 
+  switch(this->Backend) {
+    case DistanceBackend::AUCTION:
+      break;
+    case DistanceBackend::SLICED_WASSERSTEIN:
+      this->printMsg("Using the Sliced Wasserstein distance ("
+                     + std::to_string(this->NumberOfDirections)
+                     + " directions)");
+      break;
+    case DistanceBackend::PERSISTENCE_IMAGES:
+      this->printMsg("Using the L2 distance between "
+                     + std::to_string(this->ImageResolution) + "x"
+                     + std::to_string(this->ImageResolution)
+                     + " persistence images");
+      break;
+  }
+
+  // auction-based or approximated distance matrix
+  const auto getDistMat
+    = [this, &nInputs](std::vector<std::vector<double>> &distanceMatrix,
+                       const std::vector<BidderDiagram<double>> &diags_min,
+                       const std::vector<BidderDiagram<double>> &diags_sad,
+                       const std::vector<BidderDiagram<double>> &diags_max) {
+        if(this->Backend == DistanceBackend::AUCTION) {
+          getDiagramsDistMat(
+            nInputs, distanceMatrix, diags_min, diags_sad, diags_max);
+        } else {
+          getApproximateDistMat(
+            nInputs, distanceMatrix, diags_min, diags_sad, diags_max);
+        }
+      };
+
   std::vector<std::vector<double>> distMat{};
   if(this->Constraint == ConstraintType::FULL_DIAGRAMS) {
-    getDiagramsDistMat(nInputs, distMat, bidder_diagrams_min,
-                       bidder_diagrams_sad, bidder_diagrams_max);
+    getDistMat(
+      distMat, bidder_diagrams_min, bidder_diagrams_sad, bidder_diagrams_max);
   } else {
     if(this->do_min_) {
       enrichCurrentBidderDiagrams(
@@ -128,9 +159,8 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       enrichCurrentBidderDiagrams(
         bidder_diagrams_max, current_bidder_diagrams_max, maxDiagPersistence);
     }
-    getDiagramsDistMat(nInputs, distMat, current_bidder_diagrams_min,
-                       current_bidder_diagrams_sad,
-                       current_bidder_diagrams_max);
+    getDistMat(distMat, current_bidder_diagrams_min,
+               current_bidder_diagrams_sad, current_bidder_diagrams_max);
   }
 
   this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
@@ -173,12 +203,11 @@ double PersistenceDiagramDistanceMatrix::computeDistance(
   return auction.run();
 }
 
-void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
+template <typename distFunc>
+void PersistenceDiagramDistanceMatrix::fillDistMat(
   const std::array<size_t, 2> &nInputs,
   std::vector<std::vector<double>> &distanceMatrix,
-  const std::vector<BidderDiagram<double>> &diags_min,
-  const std::vector<BidderDiagram<double>> &diags_sad,
-  const std::vector<BidderDiagram<double>> &diags_max) const {
+  const distFunc &getDist) const {
 
   distanceMatrix.resize(nInputs[0]);
 
@@ -195,26 +224,6 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
       distanceMatrix[i].resize(nInputs[1]);
     }
 
-    const auto getDist = [&](const size_t a, const size_t b) -> double {
-      double distance{};
-      if(this->do_min_) {
-        auto &dimin = diags_min[a];
-        auto &djmin = diags_min[b];
-        distance += computeDistance(dimin, djmin);
-      }
-      if(this->do_sad_) {
-        auto &disad = diags_sad[a];
-        auto &djsad = diags_sad[b];
-        distance += computeDistance(disad, djsad);
-      }
-      if(this->do_max_) {
-        auto &dimax = diags_max[a];
-        auto &djmax = diags_max[b];
-        distance += computeDistance(dimax, djmax);
-      }
-      return distance;
-    };
-
     if(nInputs[1] == 0) {
       // square matrix: only compute the upper triangle (i < j < nInputs[0])
       for(size_t j = i + 1; j < nInputs[0]; ++j) {
@@ -238,6 +247,130 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   }
 }
 
+void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
+  const std::array<size_t, 2> &nInputs,
+  std::vector<std::vector<double>> &distanceMatrix,
+  const std::vector<BidderDiagram<double>> &diags_min,
+  const std::vector<BidderDiagram<double>> &diags_sad,
+  const std::vector<BidderDiagram<double>> &diags_max) const {
+
+  const auto getDist = [&](const size_t a, const size_t b) -> double {
+    double distance{};
+    if(this->do_min_) {
+      auto &dimin = diags_min[a];
+      auto &djmin = diags_min[b];
+      distance += computeDistance(dimin, djmin);
+    }
+    if(this->do_sad_) {
+      auto &disad = diags_sad[a];
+      auto &djsad = diags_sad[b];
+      distance += computeDistance(disad, djsad);
+    }
+    if(this->do_max_) {
+      auto &dimax = diags_max[a];
+      auto &djmax = diags_max[b];
+      distance += computeDistance(dimax, djmax);
+    }
+    return distance;
+  };
+
+  fillDistMat(nInputs, distanceMatrix, getDist);
+}
+
+void PersistenceDiagramDistanceMatrix::getApproximateDistMat(
+  const std::array<size_t, 2> &nInputs,
+  std::vector<std::vector<double>> &distanceMatrix,
+  const std::vector<BidderDiagram<double>> &diags_min,
+  const std::vector<BidderDiagram<double>> &diags_sad,
+  const std::vector<BidderDiagram<double>> &diags_max) const {
+
+  const std::array<const std::vector<BidderDiagram<double>> *, 3> diags{
+    &diags_min, &diags_sad, &diags_max};
+  const std::array<bool, 3> dos{this->do_min_, this->do_sad_, this->do_max_};
+  const size_t nDiags = nInputs[0] + nInputs[1];
+
+  // diagram signatures (sorted projections or images), per pair type
+  std::array<std::vector<SlicedWassersteinDistance::Projections>, 3> projs{};
+  std::array<std::vector<std::vector<double>>, 3> images{};
+
+  SlicedWassersteinDistance sw{};
+  sw.setNumberOfDirections(this->NumberOfDirections);
+  PersistenceImage pi{};
+  pi.setResolution(this->ImageResolution);
+  pi.setSigma(this->ImageSigma);
+
+  const auto getPairs = [](const BidderDiagram<double> &diag,
+                           std::vector<double> &births,
+                           std::vector<double> &deaths) {
+    births.resize(diag.size());
+    deaths.resize(diag.size());
+    for(int j = 0; j < diag.size(); ++j) {
+      births[j] = diag.get(j).x_;
+      deaths[j] = diag.get(j).y_;
+    }
+  };
+
+  for(size_t t = 0; t < 3; ++t) {
+    if(!dos[t]) {
+      continue;
+    }
+    const auto &tDiags = *diags[t];
+
+    if(this->Backend == DistanceBackend::PERSISTENCE_IMAGES) {
+      // images should share the same bounds to be comparable
+      double minBirth{std::numeric_limits<double>::max()};
+      double maxBirth{std::numeric_limits<double>::lowest()};
+      double maxPers{};
+      for(size_t i = 0; i < nDiags; ++i) {
+        for(int j = 0; j < tDiags[i].size(); ++j) {
+          const auto &b = tDiags[i].get(j);
+          minBirth = std::min(minBirth, b.x_);
+          maxBirth = std::max(maxBirth, b.x_);
+          maxPers = std::max(maxPers, b.getPersistence());
+        }
+      }
+      if(minBirth > maxBirth) {
+        minBirth = maxBirth = 0.0;
+      }
+      pi.setBounds(minBirth, maxBirth, maxPers);
+      images[t].resize(nDiags);
+    } else {
+      projs[t].resize(nDiags);
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nDiags; ++i) {
+      std::vector<double> births{}, deaths{};
+      getPairs(tDiags[i], births, deaths);
+      if(this->Backend == DistanceBackend::PERSISTENCE_IMAGES) {
+        pi.computeImage(births, deaths, images[t][i]);
+      } else {
+        sw.computeProjections(births, deaths, projs[t][i]);
+      }
+    }
+  }
+
+  const auto getDist = [&](const size_t a, const size_t b) -> double {
+    double distance{};
+    for(size_t t = 0; t < 3; ++t) {
+      if(!dos[t]) {
+        continue;
+      }
+      if(this->Backend == DistanceBackend::PERSISTENCE_IMAGES) {
+        distance
+          += PersistenceImage::computeDistance(images[t][a], images[t][b]);
+      } else {
+        distance += sw.computeDistance(projs[t][a], projs[t][b]);
+      }
+    }
+    return distance;
+  };
+
+  fillDistMat(nInputs, distanceMatrix, getDist);
+}
+
 void PersistenceDiagramDistanceMatrix::setBidderDiagrams(
   const size_t nInputs,
   std::vector<Diagram> &inputDiagrams,
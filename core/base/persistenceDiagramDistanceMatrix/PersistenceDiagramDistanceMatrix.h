@@ -10,7 +10,13 @@
 /// Proc. of IEEE VIS 2019.\n
 /// IEEE Transactions on Visualization and Computer Graphics, 2019.
 ///
+/// Besides the (exact) auction-based Wasserstein distance, two faster
+/// approximations are available through setDistanceBackend(): the Sliced
+/// Wasserstein distance and the L2 distance between persistence images.
+///
 /// \sa PersistenceDiagramClustering
+/// \sa SlicedWassersteinDistance
+/// \sa PersistenceImage
 
 #pragma once
 
@@ -18,6 +24,8 @@
 #include <limits>
 
 #include <Auction.h>
+#include <PersistenceImage.h>
+#include <SlicedWassersteinDistance.h>
 #include <Wrapper.h>
 
 namespace ttk {
@@ -99,6 +107,24 @@ namespace ttk {
         this->Constraint = ConstraintType::RELATIVE_PERSISTENCE_GLOBAL;
       }
     }
+    inline void setDistanceBackend(const int data) {
+      if(data == 0) {
+        this->Backend = DistanceBackend::AUCTION;
+      } else if(data == 1) {
+        this->Backend = DistanceBackend::SLICED_WASSERSTEIN;
+      } else if(data == 2) {
+        this->Backend = DistanceBackend::PERSISTENCE_IMAGES;
+      }
+    }
+    inline void setNumberOfDirections(const int data) {
+      NumberOfDirections = data;
+    }
+    inline void setImageResolution(const int data) {
+      ImageResolution = data;
+    }
+    inline void setImageSigma(const double data) {
+      ImageSigma = data;
+    }
 
   protected:
     double getMostPersistent(
@@ -111,6 +137,16 @@ namespace ttk {
       const std::vector<BidderDiagram<double>> &diags_min,
       const std::vector<BidderDiagram<double>> &diags_sad,
       const std::vector<BidderDiagram<double>> &diags_max) const;
+    void getApproximateDistMat(
+      const std::array<size_t, 2> &nInputs,
+      std::vector<std::vector<double>> &distanceMatrix,
+      const std::vector<BidderDiagram<double>> &diags_min,
+      const std::vector<BidderDiagram<double>> &diags_sad,
+      const std::vector<BidderDiagram<double>> &diags_max) const;
+    template <typename distFunc>
+    void fillDistMat(const std::array<size_t, 2> &nInputs,
+                     std::vector<std::vector<double>> &distanceMatrix,
+                     const distFunc &getDist) const;
     void
       setBidderDiagrams(const size_t nInputs,
                         std::vector<Diagram> &inputDiagrams,
@@ -141,5 +177,17 @@ namespace ttk {
       RELATIVE_PERSISTENCE_GLOBAL,
     };
     ConstraintType Constraint{ConstraintType::RELATIVE_PERSISTENCE_GLOBAL};
+
+    enum class DistanceBackend {
+      AUCTION,
+      SLICED_WASSERSTEIN,
+      PERSISTENCE_IMAGES,
+    };
+    DistanceBackend Backend{DistanceBackend::AUCTION};
+    // Sliced Wasserstein: number of slicing directions
+    int NumberOfDirections{16};
+    // persistence images: resolution and relative Gaussian bandwidth
+    int ImageResolution{32};
+    double ImageSigma{0.05};
   };
 } // namespace ttk
@@ -0,0 +1,192 @@
+#include <PersistenceDiagramFile.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+  const char magic[8] = {'T', 'T', 'K', 'P', 'D', 'I', 'A', 'G'};
+  const uint32_t byteOrderMark{0x01020304};
+
+  // size of one value of each column
+  const std::array<size_t, 9> valueSizes{
+    sizeof(double),      sizeof(double),  sizeof(int64_t),
+    sizeof(int64_t),     3 * sizeof(float), 3 * sizeof(float),
+    sizeof(int32_t),     sizeof(int8_t),  sizeof(int8_t)};
+
+  inline size_t align8(const size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+  }
+} // namespace
+
+ttk::PersistenceDiagramFile::PersistenceDiagramFile() {
+  this->setDebugMsgPrefix("PersistenceDiagramFile");
+}
+
+std::array<size_t, ttk::PersistenceDiagramFile::nColumns_ + 1>
+  ttk::PersistenceDiagramFile::getColumnOffsets(const size_t nPairs) {
+
+  std::array<size_t, nColumns_ + 1> offsets{};
+  offsets[0] = headerSize_;
+  for(size_t i = 0; i < nColumns_; ++i) {
+    offsets[i + 1] = align8(offsets[i] + nPairs * valueSizes[i]);
+  }
+  return offsets;
+}
+
+int ttk::PersistenceDiagramFile::writeDiagram(const std::string &fileName,
+                                              const Columns &diagram) const {
+
+  Timer t;
+
+  const size_t nPairs = diagram.size();
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(diagram.death.size() != nPairs || diagram.vertexId1.size() != nPairs
+     || diagram.vertexId2.size() != nPairs
+     || diagram.coords1.size() != 3 * nPairs
+     || diagram.coords2.size() != 3 * nPairs
+     || diagram.pairType.size() != nPairs
+     || diagram.criticalType1.size() != nPairs
+     || diagram.criticalType2.size() != nPairs) {
+    this->printErr("Inconsistent column sizes");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  const auto offsets = getColumnOffsets(nPairs);
+  std::vector<char> buffer(offsets[nColumns_], 0);
+
+  // header
+  const uint32_t version{formatVersion_};
+  const uint64_t n{nPairs};
+  std::memcpy(buffer.data(), magic, sizeof(magic));
+  std::memcpy(buffer.data() + 8, &version, sizeof(version));
+  std::memcpy(buffer.data() + 12, &diagram.flags, sizeof(diagram.flags));
+  std::memcpy(buffer.data() + 16, &n, sizeof(n));
+  std::memcpy(buffer.data() + 24, &byteOrderMark, sizeof(byteOrderMark));
+
+  // columns
+  const std::array<const void *, nColumns_> columns{
+    diagram.birth.data(),         diagram.death.data(),
+    diagram.vertexId1.data(),     diagram.vertexId2.data(),
+    diagram.coords1.data(),       diagram.coords2.data(),
+    diagram.pairType.data(),      diagram.criticalType1.data(),
+    diagram.criticalType2.data()};
+  const std::array<size_t, nColumns_> columnSizes{
+    diagram.birth.size() * sizeof(double),
+    diagram.death.size() * sizeof(double),
+    diagram.vertexId1.size() * sizeof(int64_t),
+    diagram.vertexId2.size() * sizeof(int64_t),
+    diagram.coords1.size() * sizeof(float),
+    diagram.coords2.size() * sizeof(float),
+    diagram.pairType.size() * sizeof(int32_t),
+    diagram.criticalType1.size() * sizeof(int8_t),
+    diagram.criticalType2.size() * sizeof(int8_t)};
+  for(size_t i = 0; i < nColumns_; ++i) {
+    if(columnSizes[i] > 0) {
+      std::memcpy(buffer.data() + offsets[i], columns[i], columnSizes[i]);
+    }
+  }
+
+  FILE *fp = fopen(fileName.data(), "wb");
+  if(fp == nullptr) {
+    this->printErr("Unable to open '" + fileName + "'");
+    return -1;
+  }
+  const auto written = fwrite(buffer.data(), 1, buffer.size(), fp);
+  if(fclose(fp) != 0 || written != buffer.size()) {
+    this->printErr("Unable to write '" + fileName + "'");
+    return -1;
+  }
+
+  this->printMsg(
+    "Wrote " + std::to_string(nPairs) + " pairs", 1, t.getElapsedTime());
+
+  return 0;
+}
+
+int ttk::PersistenceDiagramFile::openDiagram(const std::string &fileName) {
+
+  this->closeDiagram();
+
+  if(this->file_.open(fileName) != 0) {
+    this->printErr("Unable to open '" + fileName + "'");
+    return -1;
+  }
+
+  const auto data = this->file_.data();
+  uint32_t version{}, flags{}, bom{};
+  uint64_t nPairs{};
+  if(this->file_.size() < headerSize_
+     || std::memcmp(data, magic, sizeof(magic)) != 0) {
+    this->printErr("'" + fileName + "' is not a persistence diagram file");
+    this->file_.close();
+    return -1;
+  }
+  std::memcpy(&version, data + 8, sizeof(version));
+  std::memcpy(&flags, data + 12, sizeof(flags));
+  std::memcpy(&nPairs, data + 16, sizeof(nPairs));
+  std::memcpy(&bom, data + 24, sizeof(bom));
+
+  if(version > formatVersion_) {
+    this->printErr("Unsupported format version "
+                   + std::to_string(version));
+    this->file_.close();
+    return -1;
+  }
+  if(bom != byteOrderMark) {
+    this->printErr("Unsupported byte order");
+    this->file_.close();
+    return -1;
+  }
+
+  // (checked before computing the offsets, which could overflow)
+  size_t pairSize{};
+  for(const auto size : valueSizes) {
+    pairSize += size;
+  }
+  if(nPairs > (this->file_.size() - headerSize_) / pairSize) {
+    this->printErr("Truncated file '" + fileName + "'");
+    this->file_.close();
+    return -1;
+  }
+
+  const auto offsets = getColumnOffsets(nPairs);
+  if(this->file_.size() < offsets[nColumns_]) {
+    this->printErr("Truncated file '" + fileName + "'");
+    this->file_.close();
+    return -1;
+  }
+
+  this->nPairs_ = nPairs;
+  this->flags_ = flags;
+  this->offsets_ = offsets;
+
+  return 0;
+}
+
+int ttk::PersistenceDiagramFile::readDiagram(Columns &diagram) const {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!this->file_.isOpen()) {
+    this->printErr("No diagram file opened");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  const auto n = this->nPairs_;
+  diagram.flags = this->flags_;
+  diagram.birth.assign(this->getBirth(), this->getBirth() + n);
+  diagram.death.assign(this->getDeath(), this->getDeath() + n);
+  diagram.vertexId1.assign(this->getVertexId1(), this->getVertexId1() + n);
+  diagram.vertexId2.assign(this->getVertexId2(), this->getVertexId2() + n);
+  diagram.coords1.assign(this->getCoords1(), this->getCoords1() + 3 * n);
+  diagram.coords2.assign(this->getCoords2(), this->getCoords2() + 3 * n);
+  diagram.pairType.assign(this->getPairType(), this->getPairType() + n);
+  diagram.criticalType1.assign(
+    this->getCriticalType1(), this->getCriticalType1() + n);
+  diagram.criticalType2.assign(
+    this->getCriticalType2(), this->getCriticalType2() + n);
+
+  return 0;
+}
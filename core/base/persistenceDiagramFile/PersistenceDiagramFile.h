@@ -0,0 +1,251 @@
+/// \ingroup base
+/// \class ttk::PersistenceDiagramFile
+///
+/// \brief TTK %persistenceDiagramFile processing package.
+///
+/// %PersistenceDiagramFile reads and writes persistence diagrams in a
+/// compact binary format (.tpd), instead of the generic VTK XML format.
+///
+/// The pairs are stored in a columnar layout (one array per attribute,
+/// aligned on 8 bytes), after a 32 bytes header:
+/// - magic number "TTKPDIAG", version (uint32), flags (uint32), number of
+/// pairs (uint64), byte order mark (uint32), padding (uint32),
+/// - birth and death values (double),
+/// - vertex identifiers of the critical points (int64),
+/// - coordinates of the critical points (3 float per pair and point),
+/// - pair types (int32),
+/// - critical types of the critical points (int8).
+///
+/// The files are memory-mapped on reading: the columns are directly
+/// accessed in the mapping, and can be converted into the diagramTuple
+/// vectors of BottleneckDistance and PersistenceDiagramClustering without
+/// going through VTK arrays.
+///
+/// \sa ttkPersistenceDiagramReader
+/// \sa ttkPersistenceDiagramWriter
+
+#pragma once
+
+#ifndef diagramTuple
+#define diagramTuple                                                       \
+  std::tuple<ttk::SimplexId, ttk::CriticalType, ttk::SimplexId,            \
+             ttk::CriticalType, dataType, ttk::SimplexId, dataType, float, \
+             float, float, dataType, float, float, float>
+#endif
+
+// base code includes
+#include <Debug.h>
+#include <MappedFile.h>
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace ttk {
+
+  class PersistenceDiagramFile : virtual public Debug {
+
+  public:
+    enum Flags : uint32_t {
+      /// the diagram is embedded in the domain (Birth and Death arrays)
+      EMBEDDED_IN_DOMAIN = 1,
+    };
+
+    /// Columns of a persistence diagram (one value per pair)
+    struct Columns {
+      std::vector<double> birth{};
+      std::vector<double> death{};
+      std::vector<int64_t> vertexId1{};
+      std::vector<int64_t> vertexId2{};
+      std::vector<float> coords1{}; // 3 per pair
+      std::vector<float> coords2{}; // 3 per pair
+      std::vector<int32_t> pairType{};
+      std::vector<int8_t> criticalType1{};
+      std::vector<int8_t> criticalType2{};
+      uint32_t flags{};
+
+      void resize(const size_t nPairs) {
+        birth.resize(nPairs);
+        death.resize(nPairs);
+        vertexId1.resize(nPairs);
+        vertexId2.resize(nPairs);
+        coords1.resize(3 * nPairs);
+        coords2.resize(3 * nPairs);
+        pairType.resize(nPairs);
+        criticalType1.resize(nPairs);
+        criticalType2.resize(nPairs);
+      }
+
+      size_t size() const {
+        return birth.size();
+      }
+    };
+
+    static const unsigned int formatVersion_{1};
+
+    PersistenceDiagramFile();
+
+    /**
+     * @brief Write a diagram to a file
+     * @return 0 on success, -1 otherwise
+     */
+    int writeDiagram(const std::string &fileName,
+                     const Columns &diagram) const;
+
+    /**
+     * @brief Write a diagram given as diagramTuple to a file
+     */
+    template <typename dataType>
+    int writeDiagram(const std::string &fileName,
+                     const std::vector<diagramTuple> &diagram,
+                     const uint32_t flags = 0) const;
+
+    /**
+     * @brief Map a diagram file in memory and check its header
+     * @return 0 on success, -1 otherwise
+     */
+    int openDiagram(const std::string &fileName);
+
+    void closeDiagram() {
+      this->file_.close();
+      this->nPairs_ = 0;
+      this->flags_ = 0;
+    }
+
+    /// Columns of the mapped diagram
+    inline size_t getNumberOfPairs() const {
+      return this->nPairs_;
+    }
+    inline uint32_t getFlags() const {
+      return this->flags_;
+    }
+    inline const double *getBirth() const {
+      return this->column<double>(0);
+    }
+    inline const double *getDeath() const {
+      return this->column<double>(1);
+    }
+    inline const int64_t *getVertexId1() const {
+      return this->column<int64_t>(2);
+    }
+    inline const int64_t *getVertexId2() const {
+      return this->column<int64_t>(3);
+    }
+    inline const float *getCoords1() const {
+      return this->column<float>(4);
+    }
+    inline const float *getCoords2() const {
+      return this->column<float>(5);
+    }
+    inline const int32_t *getPairType() const {
+      return this->column<int32_t>(6);
+    }
+    inline const int8_t *getCriticalType1() const {
+      return this->column<int8_t>(7);
+    }
+    inline const int8_t *getCriticalType2() const {
+      return this->column<int8_t>(8);
+    }
+
+    /**
+     * @brief Copy the mapped diagram
+     */
+    int readDiagram(Columns &diagram) const;
+
+    /**
+     * @brief Convert the mapped diagram into diagramTuple (the coordinates
+     * are the ones of the critical points)
+     */
+    template <typename dataType>
+    int readDiagram(std::vector<diagramTuple> &diagram) const;
+
+  protected:
+    static constexpr size_t nColumns_{9};
+    static constexpr size_t headerSize_{32};
+
+    /// Offsets of the columns in a file of nPairs pairs (and file size)
+    static std::array<size_t, nColumns_ + 1>
+      getColumnOffsets(const size_t nPairs);
+
+    template <typename T>
+    inline const T *column(const size_t i) const {
+      return reinterpret_cast<const T *>(this->file_.data()
+                                         + this->offsets_[i]);
+    }
+
+    MappedFile file_{};
+    size_t nPairs_{};
+    uint32_t flags_{};
+    std::array<size_t, nColumns_ + 1> offsets_{};
+  };
+
+} // namespace ttk
+
+template <typename dataType>
+int ttk::PersistenceDiagramFile::writeDiagram(
+  const std::string &fileName,
+  const std::vector<diagramTuple> &diagram,
+  const uint32_t flags) const {
+
+  Columns columns{};
+  columns.flags = flags;
+  columns.resize(diagram.size());
+
+  for(size_t i = 0; i < diagram.size(); ++i) {
+    const auto &t = diagram[i];
+    columns.vertexId1[i] = std::get<0>(t);
+    columns.criticalType1[i] = static_cast<int8_t>(std::get<1>(t));
+    columns.vertexId2[i] = std::get<2>(t);
+    columns.criticalType2[i] = static_cast<int8_t>(std::get<3>(t));
+    columns.pairType[i] = std::get<5>(t);
+    columns.birth[i] = std::get<6>(t);
+    columns.coords1[3 * i] = std::get<7>(t);
+    columns.coords1[3 * i + 1] = std::get<8>(t);
+    columns.coords1[3 * i + 2] = std::get<9>(t);
+    columns.death[i] = std::get<10>(t);
+    columns.coords2[3 * i] = std::get<11>(t);
+    columns.coords2[3 * i + 1] = std::get<12>(t);
+    columns.coords2[3 * i + 2] = std::get<13>(t);
+  }
+
+  return this->writeDiagram(fileName, columns);
+}
+
+template <typename dataType>
+int ttk::PersistenceDiagramFile::readDiagram(
+  std::vector<diagramTuple> &diagram) const {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!this->file_.isOpen()) {
+    this->printErr("No diagram file opened");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  const auto birth = this->getBirth();
+  const auto death = this->getDeath();
+  const auto vertexId1 = this->getVertexId1();
+  const auto vertexId2 = this->getVertexId2();
+  const auto coords1 = this->getCoords1();
+  const auto coords2 = this->getCoords2();
+  const auto pairType = this->getPairType();
+  const auto criticalType1 = this->getCriticalType1();
+  const auto criticalType2 = this->getCriticalType2();
+
+  diagram.resize(this->nPairs_);
+  for(size_t i = 0; i < this->nPairs_; ++i) {
+    const auto b = static_cast<dataType>(birth[i]);
+    const auto d = static_cast<dataType>(death[i]);
+    diagram[i] = std::make_tuple(
+      static_cast<SimplexId>(vertexId1[i]),
+      static_cast<CriticalType>(criticalType1[i]),
+      static_cast<SimplexId>(vertexId2[i]),
+      static_cast<CriticalType>(criticalType2[i]),
+      static_cast<dataType>(d - b), static_cast<SimplexId>(pairType[i]), b,
+      coords1[3 * i], coords1[3 * i + 1], coords1[3 * i + 2], d,
+      coords2[3 * i], coords2[3 * i + 1], coords2[3 * i + 2]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,511 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <Auction.h>
+#include <PersistenceDiagramIndex.h>
+#include <PersistenceImage.h>
+
+namespace {
+  // index file header
+  const char indexMagic[] = "TTKPDIDX";
+  const int32_t indexVersion = 1;
+
+  template <typename T>
+  inline void writeValue(std::ofstream &stream, const T &value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  inline void readValue(std::ifstream &stream, T &value) {
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+  }
+} // namespace
+
+ttk::PersistenceDiagramIndex::PersistenceDiagramIndex() {
+  this->setDebugMsgPrefix("PersistenceDiagramIndex");
+}
+
+void ttk::PersistenceDiagramIndex::clear() {
+  this->entries_.clear();
+  this->keys_.clear();
+  this->tree_.clear();
+  this->treeEntries_.clear();
+  this->hasBounds_ = false;
+}
+
+void ttk::PersistenceDiagramIndex::computeBounds(
+  const std::vector<PairDiagram> &diagrams) {
+
+  for(size_t t = 0; t < 3; ++t) {
+    double minBirth{std::numeric_limits<double>::max()};
+    double maxBirth{std::numeric_limits<double>::lowest()};
+    double maxPers{};
+    for(const auto &diag : diagrams) {
+      for(const auto &p : diag[t]) {
+        minBirth = std::min(minBirth, p.first);
+        maxBirth = std::max(maxBirth, p.first);
+        maxPers = std::max(maxPers, p.second - p.first);
+      }
+    }
+    if(minBirth > maxBirth) {
+      minBirth = maxBirth = 0.0;
+    }
+    this->bounds_[t] = {minBirth, maxBirth, maxPers};
+  }
+  this->hasBounds_ = true;
+}
+
+void ttk::PersistenceDiagramIndex::computeSignature(
+  const PairDiagram &diagram, std::vector<float> &signature) const {
+
+  const size_t res = std::max(this->Resolution, 1);
+  signature.resize(3 * res * res);
+
+  PersistenceImage pi{};
+  pi.setResolution(res);
+  pi.setSigma(this->Sigma);
+
+  std::vector<double> births{}, deaths{}, image{};
+  for(size_t t = 0; t < 3; ++t) {
+    births.resize(diagram[t].size());
+    deaths.resize(diagram[t].size());
+    for(size_t i = 0; i < diagram[t].size(); ++i) {
+      births[i] = diagram[t][i].first;
+      deaths[i] = diagram[t][i].second;
+    }
+    pi.setBounds(this->bounds_[t][0], this->bounds_[t][1], this->bounds_[t][2]);
+    pi.computeImage(births, deaths, image);
+    std::copy(image.begin(), image.end(), &signature[t * res * res]);
+  }
+}
+
+double ttk::PersistenceDiagramIndex::signatureDistance(
+  const std::vector<float> &sig1, const std::vector<float> &sig2) const {
+
+  // one persistence image per pair type
+  const size_t len = sig1.size() / 3;
+  double res{};
+  for(size_t t = 0; t < 3; ++t) {
+    if(!this->dos_[t]) {
+      continue;
+    }
+    const float *const a = &sig1[t * len];
+    const float *const b = &sig2[t * len];
+    for(size_t i = 0; i < len; ++i) {
+      const double diff = a[i] - b[i];
+      res += diff * diff;
+    }
+  }
+  return std::sqrt(res);
+}
+
+double ttk::PersistenceDiagramIndex::exactDistance(
+  const PairDiagram &diag1, const PairDiagram &diag2) const {
+
+  double distance{};
+
+  for(size_t t = 0; t < 3; ++t) {
+    if(!this->dos_[t] || (diag1[t].empty() && diag2[t].empty())) {
+      continue;
+    }
+
+    BidderDiagram<double> bidders{};
+    for(const auto &p : diag1[t]) {
+      Bidder<double> b(p.first, p.second, false, bidders.size());
+      b.setPositionInAuction(bidders.size());
+      bidders.addBidder(b);
+    }
+    GoodDiagram<double> goods{};
+    for(const auto &p : diag2[t]) {
+      Good<double> g(p.first, p.second, false, goods.size());
+      g.setPrice(0);
+      goods.addGood(g);
+    }
+
+    // only compare the persistence pairs (no geometrical lifting)
+    Auction<double> auction(this->Wasserstein, 1.0, 0.5, this->DeltaLim, true);
+    auction.BuildAuctionDiagrams(&bidders, &goods);
+    distance += auction.run();
+  }
+
+  return distance;
+}
+
+size_t ttk::PersistenceDiagramIndex::insert(const std::string &key,
+                                            const long long timestamp,
+                                            PairDiagram &&diagram) {
+
+  if(!this->hasBounds_) {
+    this->computeBounds({diagram});
+  }
+
+  size_t id{};
+  const auto it = this->keys_.find(key);
+  if(it != this->keys_.end()) {
+    id = it->second;
+  } else {
+    id = this->entries_.size();
+    this->entries_.emplace_back();
+    this->keys_[key] = id;
+  }
+
+  auto &entry = this->entries_[id];
+  entry.key = key;
+  entry.timestamp = timestamp;
+  entry.diagram = std::move(diagram);
+  this->computeSignature(entry.diagram, entry.signature);
+
+  return id;
+}
+
+int ttk::PersistenceDiagramIndex::find(const std::string &key) const {
+  const auto it = this->keys_.find(key);
+  if(it == this->keys_.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+int ttk::PersistenceDiagramIndex::buildTree(
+  const std::vector<size_t> &entries) {
+
+  Timer tm{};
+
+  this->tree_.clear();
+  this->tree_.reserve(entries.size());
+  this->treeEntries_ = entries;
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  for(const auto e : entries) {
+    if(e >= this->entries_.size()) {
+      this->printErr("Invalid entry " + std::to_string(e));
+      this->treeEntries_.clear();
+      return -1;
+    }
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  this->buildSubTree(0, this->treeEntries_.size());
+
+  this->printMsg("Built metric tree (" + std::to_string(entries.size())
+                   + " diagrams)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+int ttk::PersistenceDiagramIndex::buildSubTree(const size_t begin,
+                                               const size_t end) {
+  if(begin >= end) {
+    return -1;
+  }
+
+  const int id = this->tree_.size();
+  this->tree_.emplace_back();
+
+  // the middle entry is as good a vantage point as any other
+  std::swap(this->treeEntries_[begin], this->treeEntries_[(begin + end) / 2]);
+  const size_t vp = this->treeEntries_[begin];
+  this->tree_[id].entry = vp;
+
+  const size_t n = end - begin - 1;
+  if(n == 0) {
+    return id;
+  }
+
+  const auto &vpSig = this->entries_[vp].signature;
+  std::vector<std::pair<double, size_t>> dists(n);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) if(n > 1024)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    const auto e = this->treeEntries_[begin + 1 + i];
+    const auto &sig = this->entries_[e].signature;
+    dists[i] = std::make_pair(signatureDistance(vpSig, sig), e);
+  }
+
+  // entries closer than the median go inside, the others outside
+  const size_t half = n / 2;
+  std::nth_element(dists.begin(), dists.begin() + half, dists.end());
+  for(size_t i = 0; i < n; ++i) {
+    this->treeEntries_[begin + 1 + i] = dists[i].second;
+  }
+  const double radius = dists[half].first;
+
+  const int inside = this->buildSubTree(begin + 1, begin + 1 + half);
+  const int outside = this->buildSubTree(begin + 1 + half, end);
+
+  auto &node = this->tree_[id];
+  node.radius = radius;
+  node.inside = inside;
+  node.outside = outside;
+
+  return id;
+}
+
+void ttk::PersistenceDiagramIndex::searchSubTree(
+  const int node,
+  const std::vector<float> &signature,
+  const size_t nCandidates,
+  std::vector<std::pair<double, size_t>> &heap) const {
+
+  if(node < 0) {
+    return;
+  }
+
+  const auto &n = this->tree_[node];
+  const double d
+    = signatureDistance(signature, this->entries_[n.entry].signature);
+
+  // max-heap of the best candidates found so far
+  if(heap.size() < nCandidates) {
+    heap.emplace_back(d, n.entry);
+    std::push_heap(heap.begin(), heap.end());
+  } else if(d < heap.front().first) {
+    std::pop_heap(heap.begin(), heap.end());
+    heap.back() = std::make_pair(d, n.entry);
+    std::push_heap(heap.begin(), heap.end());
+  }
+
+  const auto tau = [&heap, nCandidates]() {
+    return heap.size() < nCandidates ? std::numeric_limits<double>::max()
+                                     : heap.front().first;
+  };
+
+  // visit first the sub-tree most likely to contain the query
+  if(d <= n.radius) {
+    if(d - tau() <= n.radius) {
+      this->searchSubTree(n.inside, signature, nCandidates, heap);
+    }
+    if(d + tau() >= n.radius) {
+      this->searchSubTree(n.outside, signature, nCandidates, heap);
+    }
+  } else {
+    if(d + tau() >= n.radius) {
+      this->searchSubTree(n.outside, signature, nCandidates, heap);
+    }
+    if(d - tau() <= n.radius) {
+      this->searchSubTree(n.inside, signature, nCandidates, heap);
+    }
+  }
+}
+
+int ttk::PersistenceDiagramIndex::query(
+  const PairDiagram &query,
+  const size_t k,
+  std::vector<Neighbor> &neighbors) const {
+
+  Timer tm{};
+
+  neighbors.clear();
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!this->hasBounds_) {
+    this->printErr("Empty index");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  if(k == 0 || this->tree_.empty()) {
+    return 0;
+  }
+
+  // 1. coarse search of the closest signatures in the metric tree
+  std::vector<float> signature{};
+  this->computeSignature(query, signature);
+
+  const size_t nCandidates
+    = std::max<size_t>(k, k * std::max(this->CandidateFactor, 1));
+  std::vector<std::pair<double, size_t>> heap{};
+  heap.reserve(nCandidates);
+  this->searchSubTree(0, signature, nCandidates, heap);
+
+  this->printMsg("Selected " + std::to_string(heap.size()) + " candidates", 0.5,
+                 tm.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
+  // 2. exact re-ranking of the candidates
+  neighbors.resize(heap.size());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < heap.size(); ++i) {
+    auto &nb = neighbors[i];
+    nb.entry = heap[i].second;
+    nb.signatureDistance = heap[i].first;
+    nb.distance = this->exactDistance(query, this->entries_[nb.entry].diagram);
+  }
+
+  std::sort(neighbors.begin(), neighbors.end(),
+            [](const Neighbor &a, const Neighbor &b) {
+              return a.distance < b.distance
+                     || (a.distance == b.distance && a.entry < b.entry);
+            });
+  if(neighbors.size() > k) {
+    neighbors.resize(k);
+  }
+
+  this->printMsg("Retrieved " + std::to_string(neighbors.size())
+                   + " nearest diagrams (" + std::to_string(heap.size())
+                   + " candidates)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+int ttk::PersistenceDiagramIndex::write(const std::string &fileName) const {
+
+  Timer tm{};
+
+  std::ofstream stream(fileName, std::ios::binary);
+  if(!stream.is_open()) {
+    this->printErr("Cannot write index file " + fileName);
+    return -1;
+  }
+
+  stream.write(indexMagic, std::strlen(indexMagic));
+  writeValue(stream, indexVersion);
+  writeValue(stream, static_cast<int32_t>(this->Resolution));
+  writeValue(stream, this->Sigma);
+  for(const auto &b : this->bounds_) {
+    for(const auto v : b) {
+      writeValue(stream, v);
+    }
+  }
+
+  writeValue(stream, static_cast<uint64_t>(this->entries_.size()));
+  for(const auto &entry : this->entries_) {
+    writeValue(stream, static_cast<uint64_t>(entry.key.size()));
+    stream.write(entry.key.data(), entry.key.size());
+    writeValue(stream, static_cast<int64_t>(entry.timestamp));
+    for(const auto &pairs : entry.diagram) {
+      writeValue(stream, static_cast<uint64_t>(pairs.size()));
+      for(const auto &p : pairs) {
+        writeValue(stream, p.first);
+        writeValue(stream, p.second);
+      }
+    }
+    writeValue(stream, static_cast<uint64_t>(entry.signature.size()));
+    stream.write(reinterpret_cast<const char *>(entry.signature.data()),
+                 entry.signature.size() * sizeof(float));
+  }
+
+  if(!stream.good()) {
+    this->printErr("Error while writing index file " + fileName);
+    return -2;
+  }
+
+  this->printMsg("Wrote " + std::to_string(this->entries_.size())
+                   + " diagrams to " + fileName,
+                 1.0, tm.getElapsedTime());
+
+  return 0;
+}
+
+int ttk::PersistenceDiagramIndex::read(const std::string &fileName) {
+
+  Timer tm{};
+
+  this->clear();
+
+  std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+  if(!stream.is_open()) {
+    return -1;
+  }
+  const auto fileSize = static_cast<uint64_t>(stream.tellg());
+  stream.seekg(0);
+
+  // counts read from the file are checked against the remaining bytes
+  // before any allocation
+  const auto fits = [&stream, fileSize](const uint64_t count,
+                                        const uint64_t itemSize) {
+    const auto pos = stream.tellg();
+    if(!stream.good() || pos < 0
+       || count > (fileSize - static_cast<uint64_t>(pos)) / itemSize) {
+      stream.setstate(std::ios::failbit);
+      return false;
+    }
+    return true;
+  };
+
+  char magic[sizeof(indexMagic)]{};
+  stream.read(magic, std::strlen(indexMagic));
+  int32_t version{};
+  readValue(stream, version);
+  if(std::strcmp(magic, indexMagic) != 0 || version != indexVersion) {
+    this->printWrn("Unsupported index file " + fileName);
+    return -2;
+  }
+
+  int32_t resolution{};
+  readValue(stream, resolution);
+  this->Resolution = resolution;
+  readValue(stream, this->Sigma);
+  for(auto &b : this->bounds_) {
+    for(auto &v : b) {
+      readValue(stream, v);
+    }
+  }
+
+  uint64_t nEntries{};
+  readValue(stream, nEntries);
+  // smallest entry: key length, timestamp, three pair counts and signature
+  // length
+  if(!fits(nEntries, 6 * sizeof(uint64_t))) {
+    this->printWrn("Truncated index file " + fileName);
+    return -3;
+  }
+  this->entries_.resize(nEntries);
+  for(size_t i = 0; i < nEntries && stream.good(); ++i) {
+    auto &entry = this->entries_[i];
+    uint64_t len{};
+    readValue(stream, len);
+    if(!fits(len, 1)) {
+      break;
+    }
+    entry.key.resize(len);
+    stream.read(&entry.key[0], len);
+    int64_t timestamp{};
+    readValue(stream, timestamp);
+    entry.timestamp = timestamp;
+    for(auto &pairs : entry.diagram) {
+      readValue(stream, len);
+      if(!fits(len, 2 * sizeof(double))) {
+        break;
+      }
+      pairs.resize(len);
+      for(auto &p : pairs) {
+        readValue(stream, p.first);
+        readValue(stream, p.second);
+      }
+    }
+    readValue(stream, len);
+    if(!fits(len, sizeof(float))) {
+      break;
+    }
+    entry.signature.resize(len);
+    stream.read(reinterpret_cast<char *>(entry.signature.data()),
+                len * sizeof(float));
+    this->keys_[entry.key] = i;
+  }
+
+  if(!stream.good()) {
+    this->printWrn("Truncated index file " + fileName);
+    this->clear();
+    return -3;
+  }
+
+  this->hasBounds_ = true;
+
+  this->printMsg("Read " + std::to_string(this->entries_.size())
+                   + " diagrams from " + fileName,
+                 1.0, tm.getElapsedTime());
+
+  return 0;
+}
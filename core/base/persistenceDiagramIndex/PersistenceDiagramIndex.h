@@ -0,0 +1,192 @@
+/// \ingroup base
+/// \class ttk::PersistenceDiagramIndex
+///
+/// \brief TTK processing package for the similarity search of persistence
+/// diagrams in large ensembles.
+///
+/// Every indexed diagram is vectorized into a fixed-size signature, the
+/// concatenation of the persistence images of its min-saddle, saddle-saddle
+/// and saddle-max pairs. The signatures are organized in a vantage-point tree
+/// (a metric tree for the L2 distance) that quickly retrieves the closest
+/// candidates to a query diagram. These candidates are then re-ranked with
+/// the exact (auction-based) Wasserstein distance.
+///
+/// The indexed diagrams, their signatures and the image bounds can be saved
+/// to and loaded from a binary file with write() and read(), so that only
+/// new or modified diagrams need to be vectorized again. The metric tree is
+/// built in memory, over the subset of entries to search (see buildTree()).
+///
+/// \sa PersistenceImage
+/// \sa PersistenceDiagramDistanceMatrix
+/// \sa ttkPersistenceDiagramIndex
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Debug.h>
+
+namespace ttk {
+
+  class PersistenceDiagramIndex : virtual public Debug {
+
+  public:
+    /// (birth, death) values of the persistence pairs of a diagram, per pair
+    /// type (min-saddle, saddle-saddle, saddle-max)
+    using PairDiagram = std::array<std::vector<std::pair<double, double>>, 3>;
+
+    /// Indexed diagram
+    struct Entry {
+      /// diagram identifier (e.g. its file path)
+      std::string key{};
+      /// modification time of the diagram source when it was indexed
+      long long timestamp{};
+      PairDiagram diagram{};
+      std::vector<float> signature{};
+    };
+
+    /// Result of a query
+    struct Neighbor {
+      /// index of the entry
+      size_t entry{};
+      /// L2 distance between the signatures
+      double signatureDistance{};
+      /// exact Wasserstein distance
+      double distance{};
+    };
+
+    PersistenceDiagramIndex();
+
+    /// Remove every entry and reset the signature bounds
+    void clear();
+
+    /**
+     * @brief Set the persistence image bounds from a set of diagrams
+     *
+     * Signatures computed with different bounds cannot be compared: this
+     * should be called once, before the first insertion.
+     */
+    void computeBounds(const std::vector<PairDiagram> &diagrams);
+
+    /**
+     * @brief Index a diagram, replacing any previous entry with the same key
+     *
+     * @return Index of the entry
+     */
+    size_t insert(const std::string &key,
+                  const long long timestamp,
+                  PairDiagram &&diagram);
+
+    /// Index of the entry with the given key, -1 if not indexed
+    int find(const std::string &key) const;
+
+    /**
+     * @brief Build the metric tree over a subset of the entries
+     *
+     * Only these entries will be returned by query().
+     */
+    int buildTree(const std::vector<size_t> &entries);
+
+    /**
+     * @brief Retrieve the k indexed diagrams closest to a query diagram
+     *
+     * The k * CandidateFactor nearest signatures are re-ranked with the
+     * exact Wasserstein distance.
+     *
+     * @param[in] query Query diagram
+     * @param[in] k Number of neighbors
+     * @param[out] neighbors Neighbors, sorted by increasing distance
+     */
+    int query(const PairDiagram &query,
+              const size_t k,
+              std::vector<Neighbor> &neighbors) const;
+
+    /// Save the entries and the signature parameters to a binary file
+    int write(const std::string &fileName) const;
+    /// Load the entries and the signature parameters from a binary file
+    int read(const std::string &fileName);
+
+    inline size_t size() const {
+      return this->entries_.size();
+    }
+    inline const Entry &getEntry(const size_t i) const {
+      return this->entries_[i];
+    }
+    inline bool hasBounds() const {
+      return this->hasBounds_;
+    }
+
+    inline void setResolution(const int data) {
+      this->Resolution = data;
+    }
+    inline int getResolution() const {
+      return this->Resolution;
+    }
+    inline void setSigma(const double data) {
+      this->Sigma = data;
+    }
+    inline double getSigma() const {
+      return this->Sigma;
+    }
+    inline void setWasserstein(const int data) {
+      this->Wasserstein = data;
+    }
+    inline void setDeltaLim(const double data) {
+      this->DeltaLim = data;
+    }
+    inline void setCandidateFactor(const int data) {
+      this->CandidateFactor = data;
+    }
+    inline void setDos(const bool min, const bool sad, const bool max) {
+      this->dos_ = {min, sad, max};
+    }
+
+  protected:
+    void computeSignature(const PairDiagram &diagram,
+                          std::vector<float> &signature) const;
+    double signatureDistance(const std::vector<float> &sig1,
+                             const std::vector<float> &sig2) const;
+    double exactDistance(const PairDiagram &diag1,
+                         const PairDiagram &diag2) const;
+    int buildSubTree(const size_t begin, const size_t end);
+    void searchSubTree(const int node,
+                       const std::vector<float> &signature,
+                       const size_t nCandidates,
+                       std::vector<std::pair<double, size_t>> &heap) const;
+
+    // signature parameters
+    int Resolution{8};
+    double Sigma{0.1};
+    // exact distance parameters
+    int Wasserstein{2};
+    double DeltaLim{0.01};
+    int CandidateFactor{4};
+    std::array<bool, 3> dos_{true, true, true};
+
+    // persistence image bounds (min birth, max birth, max persistence), per
+    // pair type
+    std::array<std::array<double, 3>, 3> bounds_{};
+    bool hasBounds_{false};
+
+    std::vector<Entry> entries_{};
+    std::unordered_map<std::string, size_t> keys_{};
+
+    /// Vantage-point tree node
+    struct Node {
+      /// vantage point entry
+      size_t entry{};
+      /// median distance of the sub-tree entries to the vantage point
+      double radius{};
+      /// sub-trees of the entries inside and outside the radius
+      int inside{-1}, outside{-1};
+    };
+    std::vector<Node> tree_{};
+    // entries ordered during the tree construction
+    std::vector<size_t> treeEntries_{};
+  };
+
+} // namespace ttk
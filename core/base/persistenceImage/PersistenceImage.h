@@ -0,0 +1,78 @@
+/// \ingroup base
+/// \class ttk::PersistenceImage
+///
+/// \brief TTK processing package for the vectorization of persistence
+/// diagrams into persistence images.
+///
+/// Every persistence pair is mapped to the (birth, persistence) plane and
+/// splatted as a Gaussian weighted by its persistence onto a regular grid. The
+/// grid bounds should be shared by all the diagrams to compare (see
+/// setBounds()), so that the resulting images can be compared with a L2
+/// metric.
+///
+/// \b Related \b publication \n
+/// "Persistence Images: A Stable Vector Representation of Persistent
+/// Homology" \n
+/// Henry Adams et al. \n
+/// Journal of Machine Learning Research, 2017.
+///
+/// \sa PersistenceDiagramDistanceMatrix
+/// \sa PersistenceDiagramClustering
+
+#pragma once
+
+#include <vector>
+
+#include <Debug.h>
+
+namespace ttk {
+
+  class PersistenceImage : virtual public Debug {
+
+  public:
+    PersistenceImage();
+
+    /**
+     * @brief Compute the persistence image of a diagram
+     *
+     * @param[in] births Birth values of the diagram pairs
+     * @param[in] deaths Death values of the diagram pairs
+     * @param[out] image Row-major image of size Resolution * Resolution
+     */
+    void computeImage(const std::vector<double> &births,
+                      const std::vector<double> &deaths,
+                      std::vector<double> &image) const;
+
+    /**
+     * @brief L2 distance between two persistence images
+     */
+    static double computeDistance(const std::vector<double> &image1,
+                                  const std::vector<double> &image2);
+
+    inline void setResolution(const int resolution) {
+      this->Resolution = resolution;
+    }
+    inline int getResolution() const {
+      return this->Resolution;
+    }
+    /// Gaussian standard deviation, relative to the image extent
+    inline void setSigma(const double sigma) {
+      this->Sigma = sigma;
+    }
+    inline void setBounds(const double minBirth,
+                          const double maxBirth,
+                          const double maxPersistence) {
+      this->MinBirth = minBirth;
+      this->MaxBirth = maxBirth;
+      this->MaxPersistence = maxPersistence;
+    }
+
+  protected:
+    int Resolution{32};
+    double Sigma{0.05};
+    double MinBirth{0.0};
+    double MaxBirth{1.0};
+    double MaxPersistence{1.0};
+  };
+
+} // namespace ttk
@@ -316,6 +316,8 @@ namespace ttk {
     std::vector<SimplexId> nearestVertexIdentifier_{};
     // holds geodesic distance to every other quad vertex sharing a quad
     std::vector<std::vector<float>> vertexDistance_{};
+    // edge lengths of the input triangulation, for the Dijkstra propagations
+    Dijkstra::WeightedGraph<float> dijkstraGraph_{};
 
     // array of output quadrangle vertex valences
     std::vector<SimplexId> outputValences_{};
@@ -710,6 +712,9 @@ int ttk::QuadrangulationSubdivision::subdivise(
   quadNeighbors_.resize(outputPoints_.size());
   getQuadNeighbors(outputQuads_, quadNeighbors_, true);
 
+  // Dijkstra buffers, one per thread
+  std::vector<Dijkstra::Workspace<float>> workspaces(threadNumber_);
+
   // compute shortest distance from every vertex to all other that share a quad
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
@@ -725,8 +730,14 @@ int ttk::QuadrangulationSubdivision::subdivise(
         bounds.emplace_back(nearestVertexIdentifier_[p]);
       }
 
-      Dijkstra::shortestPath(
-        nearestVertexIdentifier_[i], triangulation, vertexDistance_[i], bounds);
+#ifdef TTK_ENABLE_OPENMP
+      auto &workspace = workspaces[omp_get_thread_num()];
+#else
+      auto &workspace = workspaces[0];
+#endif // TTK_ENABLE_OPENMP
+      Dijkstra::shortestPath(nearestVertexIdentifier_[i], triangulation,
+                             vertexDistance_[i], bounds, std::vector<bool>(),
+                             &dijkstraGraph_, &workspace);
     }
   }
 
@@ -1004,6 +1015,11 @@ int ttk::QuadrangulationSubdivision::execute(
     }
   }
 
+  // edge lengths shared by the Dijkstra propagations of all the levels
+  if(SubdivisionLevel > 0) {
+    dijkstraGraph_.build(triangulation, threadNumber_);
+  }
+
   // main loop
   for(size_t i = 0; i < SubdivisionLevel; i++) {
     // subdivise each quadrangle by creating five new points, at the
@@ -1012,6 +1028,8 @@ int ttk::QuadrangulationSubdivision::execute(
     subdivise(triangulation);
   }
 
+  dijkstraGraph_.clear();
+
   // retrieve mapping between every vertex and its neighbors
   quadNeighbors_.clear();
   quadNeighbors_.resize(outputPoints_.size());
@@ -1,7 +1,3 @@
-// NOTE
-// this class has been implemented recursively. this is bad programming.
-// a non-recursive version will be implemented asap.
-
 #include <RangeDrivenOctree.h>
 
 using namespace ttk;
@@ -12,10 +8,258 @@ RangeDrivenOctree::RangeDrivenOctree() {
 
 void RangeDrivenOctree::flush() {
   nodeList_.clear();
-  cellDomainBox_.clear();
+  nodeUMin_.clear();
+  nodeUMax_.clear();
+  nodeVMin_.clear();
+  nodeVMax_.clear();
+  nodeDomainBox_.clear();
+  cellIds_.clear();
+  cellDomainMin_.clear();
   cellRangeBox_.clear();
 }
 
+int RangeDrivenOctree::buildNodes(const std::array<float, 6> &domainBox,
+                                  const std::array<double, 4> &rangeBox) {
+
+  rootId_ = 0;
+  nodeList_.resize(1);
+  nodeList_[rootId_].firstChild_ = -1;
+  nodeList_[rootId_].cellBegin_ = 0;
+  nodeList_[rootId_].cellEnd_ = cellNumber_;
+  nodeUMin_.assign(1, rangeBox[0]);
+  nodeUMax_.assign(1, rangeBox[1]);
+  nodeVMin_.assign(1, rangeBox[2]);
+  nodeVMax_.assign(1, rangeBox[3]);
+  nodeDomainBox_.assign(1, domainBox);
+
+  cellIds_.resize(cellNumber_);
+  for(SimplexId i = 0; i < cellNumber_; i++)
+    cellIds_[i] = i;
+
+  std::vector<SimplexId> buffer(cellNumber_);
+  std::vector<SimplexId> largeNodes, smallNodes;
+
+  // breadth-first construction: the nodes of a level own disjoint ranges of
+  // cellIds_ and can be split concurrently
+  SimplexId levelBegin = rootId_, levelEnd = rootId_ + 1;
+  while(levelBegin < levelEnd) {
+
+    largeNodes.clear();
+    smallNodes.clear();
+    for(SimplexId i = levelBegin; i < levelEnd; i++) {
+      if(isSplit(i)) {
+        const SimplexId cellNumber
+          = nodeList_[i].cellEnd_ - nodeList_[i].cellBegin_;
+        if((threadNumber_ > 1) && (cellNumber >= parallelSplitCellNumber_))
+          largeNodes.push_back(i);
+        else
+          smallNodes.push_back(i);
+        nodeList_[i].firstChild_ = nodeList_.size();
+        nodeList_.resize(nodeList_.size() + 8);
+      }
+    }
+    nodeUMin_.resize(nodeList_.size());
+    nodeUMax_.resize(nodeList_.size());
+    nodeVMin_.resize(nodeList_.size());
+    nodeVMax_.resize(nodeList_.size());
+    nodeDomainBox_.resize(nodeList_.size());
+
+    for(const auto nodeId : largeNodes) {
+      splitNode(nodeId, threadNumber_, buffer);
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < smallNodes.size(); i++) {
+      splitNode(smallNodes[i], 1, buffer);
+    }
+
+    levelBegin = levelEnd;
+    levelEnd = nodeList_.size();
+  }
+
+  return 0;
+}
+
+bool RangeDrivenOctree::isSplit(const SimplexId &nodeId) const {
+
+  const auto &domainBox = nodeDomainBox_[nodeId];
+
+  float rangeArea = (nodeUMax_[nodeId] - nodeUMin_[nodeId])
+                    * (nodeVMax_[nodeId] - nodeVMin_[nodeId]);
+
+  float domainVolume = (domainBox[1] - domainBox[0])
+                       * (domainBox[3] - domainBox[2])
+                       * (domainBox[5] - domainBox[4]);
+
+  return (nodeList_[nodeId].cellEnd_ - nodeList_[nodeId].cellBegin_
+          > leafMinimumCellNumber_)
+         && (rangeArea > leafMinimumRangeAreaRatio_ * rangeArea_)
+         && (domainVolume > leafMinimumDomainVolumeRatio_ * domainVolume_);
+}
+
+void RangeDrivenOctree::classifyCells(const SimplexId &begin,
+                                      const SimplexId &end,
+                                      const std::array<float, 6> &domainBox,
+                                      const std::array<float, 3> &mid,
+                                      NodeSplit &split) const {
+
+  for(SimplexId i = begin; i < end; i++) {
+    const SimplexId cellId = cellIds_[i];
+    const int childId = getChildId(cellId, domainBox, mid);
+    const auto &cellBox = cellRangeBox_[cellId];
+    auto &childBox = split.rangeBox_[childId];
+
+    if(!split.cellNumber_[childId]) {
+      childBox = cellBox;
+    } else {
+      if(cellBox[0] < childBox[0])
+        childBox[0] = cellBox[0];
+      if(cellBox[1] > childBox[1])
+        childBox[1] = cellBox[1];
+      if(cellBox[2] < childBox[2])
+        childBox[2] = cellBox[2];
+      if(cellBox[3] > childBox[3])
+        childBox[3] = cellBox[3];
+    }
+    split.cellNumber_[childId]++;
+  }
+}
+
+void RangeDrivenOctree::scatterCells(const SimplexId &begin,
+                                     const SimplexId &end,
+                                     const std::array<float, 6> &domainBox,
+                                     const std::array<float, 3> &mid,
+                                     std::array<SimplexId, 8> &offsets,
+                                     std::vector<SimplexId> &buffer) const {
+
+  // stable: the cells of a child keep their relative order
+  for(SimplexId i = begin; i < end; i++) {
+    const SimplexId cellId = cellIds_[i];
+    buffer[offsets[getChildId(cellId, domainBox, mid)]++] = cellId;
+  }
+}
+
+void RangeDrivenOctree::setChildren(const SimplexId &nodeId,
+                                    const std::array<float, 3> &mid,
+                                    const NodeSplit &split) {
+
+  const auto &domainBox = nodeDomainBox_[nodeId];
+  SimplexId cellBegin = nodeList_[nodeId].cellBegin_;
+
+  // child bits: 4 for the upper half in x, 2 in y, 1 in z
+  for(int i = 0; i < 8; i++) {
+    const SimplexId childId = nodeList_[nodeId].firstChild_ + i;
+
+    nodeList_[childId].firstChild_ = -1;
+    nodeList_[childId].cellBegin_ = cellBegin;
+    cellBegin += split.cellNumber_[i];
+    nodeList_[childId].cellEnd_ = cellBegin;
+
+    // empty children get an empty range box at the origin
+    nodeUMin_[childId] = split.cellNumber_[i] ? split.rangeBox_[i][0] : 0;
+    nodeUMax_[childId] = split.cellNumber_[i] ? split.rangeBox_[i][1] : 0;
+    nodeVMin_[childId] = split.cellNumber_[i] ? split.rangeBox_[i][2] : 0;
+    nodeVMax_[childId] = split.cellNumber_[i] ? split.rangeBox_[i][3] : 0;
+
+    auto &childBox = nodeDomainBox_[childId];
+    for(int j = 0; j < 3; j++) {
+      if(i & (4 >> j)) {
+        childBox[2 * j] = mid[j];
+        childBox[2 * j + 1] = domainBox[2 * j + 1];
+      } else {
+        childBox[2 * j] = domainBox[2 * j];
+        childBox[2 * j + 1] = mid[j];
+      }
+    }
+  }
+}
+
+void RangeDrivenOctree::splitNode(const SimplexId &nodeId,
+                                  const int &chunkNumber,
+                                  std::vector<SimplexId> &buffer) {
+
+  const auto &domainBox = nodeDomainBox_[nodeId];
+  const SimplexId begin = nodeList_[nodeId].cellBegin_;
+  const SimplexId end = nodeList_[nodeId].cellEnd_;
+
+  std::array<float, 3> mid{};
+  for(int j = 0; j < 3; j++) {
+    mid[j] = domainBox[2 * j] + (domainBox[2 * j + 1] - domainBox[2 * j]) / 2.0;
+  }
+
+  NodeSplit split{};
+  std::array<SimplexId, 8> offsets{};
+
+  if(chunkNumber <= 1) {
+    classifyCells(begin, end, domainBox, mid, split);
+    offsets[0] = begin;
+    for(int i = 1; i < 8; i++)
+      offsets[i] = offsets[i - 1] + split.cellNumber_[i - 1];
+    scatterCells(begin, end, domainBox, mid, offsets, buffer);
+    std::copy(buffer.begin() + begin, buffer.begin() + end,
+              cellIds_.begin() + begin);
+    setChildren(nodeId, mid, split);
+    return;
+  }
+
+  // large node: contiguous chunks of cells, classified and scattered
+  // concurrently (the chunk offsets keep the partition stable)
+  const SimplexId cellNumber = end - begin;
+  std::vector<NodeSplit> chunkSplits(chunkNumber);
+  std::vector<std::array<SimplexId, 8>> chunkOffsets(chunkNumber);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < chunkNumber; i++) {
+    classifyCells(begin + cellNumber * i / chunkNumber,
+                  begin + cellNumber * (i + 1) / chunkNumber, domainBox, mid,
+                  chunkSplits[i]);
+  }
+
+  SimplexId offset = begin;
+  for(int j = 0; j < 8; j++) {
+    for(int i = 0; i < chunkNumber; i++) {
+      const auto &chunk = chunkSplits[i];
+      chunkOffsets[i][j] = offset;
+      offset += chunk.cellNumber_[j];
+
+      if(!chunk.cellNumber_[j])
+        continue;
+      auto &childBox = split.rangeBox_[j];
+      if(!split.cellNumber_[j]) {
+        childBox = chunk.rangeBox_[j];
+      } else {
+        childBox[0] = std::min(childBox[0], chunk.rangeBox_[j][0]);
+        childBox[1] = std::max(childBox[1], chunk.rangeBox_[j][1]);
+        childBox[2] = std::min(childBox[2], chunk.rangeBox_[j][2]);
+        childBox[3] = std::max(childBox[3], chunk.rangeBox_[j][3]);
+      }
+      split.cellNumber_[j] += chunk.cellNumber_[j];
+    }
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < chunkNumber; i++) {
+    scatterCells(begin + cellNumber * i / chunkNumber,
+                 begin + cellNumber * (i + 1) / chunkNumber, domainBox, mid,
+                 chunkOffsets[i], buffer);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = begin; i < end; i++) {
+    cellIds_[i] = buffer[i];
+  }
+
+  setChildren(nodeId, mid, split);
+}
+
 int RangeDrivenOctree::getTet2NodeMap(std::vector<SimplexId> &map,
                                       const bool &forSegmentation) const {
 
@@ -29,11 +273,14 @@ int RangeDrivenOctree::getTet2NodeMap(std::vector<SimplexId> &map,
 
   map.resize(cellNumber_);
   for(size_t i = 0; i < nodeList_.size(); i++) {
-    for(size_t j = 0; j < nodeList_[i].cellList_.size(); j++) {
+    if(nodeList_[i].firstChild_ != -1)
+      continue;
+    for(SimplexId j = nodeList_[i].cellBegin_; j < nodeList_[i].cellEnd_;
+        j++) {
       if(forSegmentation) {
-        map[nodeList_[i].cellList_[j]] = randomMap[i];
+        map[cellIds_[j]] = randomMap[i];
       } else {
-        map[nodeList_[i].cellList_[j]] = i;
+        map[cellIds_[j]] = i;
       }
     }
   }
@@ -41,238 +288,176 @@ int RangeDrivenOctree::getTet2NodeMap(std::vector<SimplexId> &map,
   return 0;
 }
 
-int RangeDrivenOctree::rangeSegmentQuery(
-  const std::pair<double, double> &p0,
-  const std::pair<double, double> &p1,
-  std::vector<SimplexId> &cellList) const {
-
-  Timer t;
-
-  queryResultNumber_ = 0;
-  cellList.clear();
+bool RangeDrivenOctree::nodeIntersection(const std::pair<double, double> &p0,
+                                         const std::pair<double, double> &p1,
+                                         const SimplexId &nodeId) const {
 
-  SimplexId ret = rangeSegmentQuery(p0, p1, rootId_, cellList);
+  const double uMin = nodeUMin_[nodeId], uMax = nodeUMax_[nodeId];
+  const double vMin = nodeVMin_[nodeId], vMax = nodeVMax_[nodeId];
 
-  this->printMsg("Query done", 1.0, t.getElapsedTime(), this->threadNumber_,
-                 debug::LineMode::NEW, debug::Priority::DETAIL);
-  this->printMsg(
-    std::vector<std::vector<std::string>>{
-      {"#Non empty leaves", std::to_string(cellList.size())}},
-    debug::Priority::DETAIL);
+  // check for intersection for each segment of the range bounding box
+  // (bottom, right, top, left)
+  if(segmentIntersection(p0, p1, {uMin, vMin}, {uMax, vMin})
+     || segmentIntersection(p0, p1, {uMax, vMin}, {uMax, vMax})
+     || segmentIntersection(p0, p1, {uMin, vMax}, {uMax, vMax})
+     || segmentIntersection(p0, p1, {uMin, vMin}, {uMin, vMax})) {
+    return true;
+  }
 
-  return ret;
+  // is the segment completely included in the range bounding box?
+  return ((p0.first >= uMin) && (p0.first < uMax) && (p0.second >= vMin)
+          && (p0.second < vMax))
+         || ((p1.first >= uMin) && (p1.first < uMax) && (p1.second >= vMin)
+             && (p1.second < vMax));
 }
 
 int RangeDrivenOctree::rangeSegmentQuery(
   const std::pair<double, double> &p0,
   const std::pair<double, double> &p1,
-  const SimplexId &nodeId,
   std::vector<SimplexId> &cellList) const {
 
-  // check for intersection for each segment of the range bounding box
-  std::pair<double, double> q0, q1;
-
-  // bottom range segment (min, min) (max, min)
-  q0.first = nodeList_[nodeId].rangeBox_.first.first;
-  q0.second = nodeList_[nodeId].rangeBox_.second.first;
-
-  q1.first = nodeList_[nodeId].rangeBox_.first.second;
-  q1.second = q0.second;
-
-  if(segmentIntersection(p0, p1, q0, q1)) {
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
-      this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
-                       + " cells(s).",
-                     debug::Priority::VERBOSE);
+  Timer t;
 
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
-    }
-  }
+  queryResultNumber_ = 0;
+  cellList.clear();
 
-  // right segment (max, min) (max, max)
-  q0.first = nodeList_[nodeId].rangeBox_.first.second;
-  q0.second = nodeList_[nodeId].rangeBox_.second.first;
+  if(nodeList_.empty())
+    return -1;
 
-  q1.first = nodeList_[nodeId].rangeBox_.first.second;
-  q1.second = nodeList_[nodeId].rangeBox_.second.second;
+  // depth-first traversal, children visited in order
+  std::vector<SimplexId> stack{rootId_};
+  while(!stack.empty()) {
+    const SimplexId nodeId = stack.back();
+    stack.pop_back();
 
-  if(segmentIntersection(p0, p1, q0, q1)) {
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
-      this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
-                       + " cells(s).",
-                     debug::Priority::VERBOSE);
+    if(!nodeIntersection(p0, p1, nodeId))
+      continue;
 
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
+    const auto &node = nodeList_[nodeId];
+    if(node.firstChild_ != -1) {
+      for(int i = 7; i >= 0; i--)
+        stack.push_back(node.firstChild_ + i);
+      continue;
     }
-  }
 
-  // top segment (min, max) (max, max)
-  q0.first = nodeList_[nodeId].rangeBox_.first.first;
-  q0.second = nodeList_[nodeId].rangeBox_.second.second;
-
-  q1.first = nodeList_[nodeId].rangeBox_.first.second;
-  q1.second = nodeList_[nodeId].rangeBox_.second.second;
-
-  if(segmentIntersection(p0, p1, q0, q1)) {
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
+    // terminal leaf
+    // return our cells
+    if(debugLevel_ >= (int)(debug::Priority::VERBOSE)) {
       this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
+                       + std::to_string(node.cellEnd_ - node.cellBegin_)
                        + " cells(s).",
                      debug::Priority::VERBOSE);
-
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
     }
+
+    cellList.insert(cellList.end(), cellIds_.begin() + node.cellBegin_,
+                    cellIds_.begin() + node.cellEnd_);
+    queryResultNumber_++;
   }
 
-  // left segment (min, min) (min, max)
-  q0.first = nodeList_[nodeId].rangeBox_.first.first;
-  q0.second = nodeList_[nodeId].rangeBox_.second.first;
+  this->printMsg("Query done", 1.0, t.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+  this->printMsg(
+    std::vector<std::vector<std::string>>{
+      {"#Non empty leaves", std::to_string(cellList.size())}},
+    debug::Priority::DETAIL);
+
+  return 0;
+}
 
-  q1.first = nodeList_[nodeId].rangeBox_.first.first;
-  q1.second = nodeList_[nodeId].rangeBox_.second.second;
+int RangeDrivenOctree::rangeSegmentQuery(
+  const std::vector<std::pair<std::pair<double, double>,
+                              std::pair<double, double>>> &segments,
+  std::vector<std::vector<SimplexId>> &cellLists) const {
 
-  if(segmentIntersection(p0, p1, q0, q1)) {
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
-      this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
-                       + " cells(s).",
-                     debug::Priority::VERBOSE);
+  Timer t;
 
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
+  queryResultNumber_ = 0;
+  cellLists.resize(segments.size());
+  for(auto &cellList : cellLists)
+    cellList.clear();
+
+  if(nodeList_.empty())
+    return -1;
+
+  // each stack item refers to the segments hitting its parent, stored in
+  // activeSegments[begin, end)
+  struct StackItem {
+    SimplexId nodeId;
+    size_t begin, end;
+  };
+
+  std::vector<SimplexId> activeSegments(segments.size());
+  for(size_t i = 0; i < segments.size(); i++)
+    activeSegments[i] = i;
+
+  std::vector<StackItem> stack{{rootId_, 0, segments.size()}};
+  while(!stack.empty()) {
+    const StackItem item = stack.back();
+    stack.pop_back();
+
+    // the lists after item.end belong to already processed subtrees
+    activeSegments.resize(item.end);
+
+    const size_t begin = activeSegments.size();
+    for(size_t i = item.begin; i < item.end; i++) {
+      const auto &segment = segments[activeSegments[i]];
+      if(nodeIntersection(segment.first, segment.second, item.nodeId))
+        activeSegments.push_back(activeSegments[i]);
     }
-  }
+    const size_t end = activeSegments.size();
 
-  // is the segment completely included in the range bounding box?
-  if((p0.first >= nodeList_[nodeId].rangeBox_.first.first)
-     && (p0.first < nodeList_[nodeId].rangeBox_.first.second)
-     && (p0.second >= nodeList_[nodeId].rangeBox_.second.first)
-     && (p0.second < nodeList_[nodeId].rangeBox_.second.second)) {
-
-    // p0 is in there
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
-      this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
-                       + " cells(s).",
-                     debug::Priority::VERBOSE);
+    if(begin == end)
+      continue;
 
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
+    const auto &node = nodeList_[item.nodeId];
+    if(node.firstChild_ != -1) {
+      for(int i = 7; i >= 0; i--)
+        stack.push_back({node.firstChild_ + i, begin, end});
+      continue;
     }
-  }
-  if((p1.first >= nodeList_[nodeId].rangeBox_.first.first)
-     && (p1.first < nodeList_[nodeId].rangeBox_.first.second)
-     && (p1.second >= nodeList_[nodeId].rangeBox_.second.first)
-     && (p1.second < nodeList_[nodeId].rangeBox_.second.second)) {
-
-    // p1 is in there
-    if(nodeList_[nodeId].childList_.size()) {
-      for(size_t i = 0; i < nodeList_[nodeId].childList_.size(); i++) {
-        rangeSegmentQuery(p0, p1, nodeList_[nodeId].childList_[i], cellList);
-      }
-      return 0;
-    } else {
-      // terminal leaf
-      // return our cells
-      this->printMsg("Node #" + std::to_string(nodeId) + " returns its "
-                       + std::to_string(nodeList_[nodeId].cellList_.size())
-                       + " cells(s).",
-                     debug::Priority::VERBOSE);
 
-      cellList.insert(cellList.end(), nodeList_[nodeId].cellList_.begin(),
-                      nodeList_[nodeId].cellList_.end());
-      queryResultNumber_++;
-      return 0;
+    for(size_t i = begin; i < end; i++) {
+      auto &cellList = cellLists[activeSegments[i]];
+      cellList.insert(cellList.end(), cellIds_.begin() + node.cellBegin_,
+                      cellIds_.begin() + node.cellEnd_);
     }
+    queryResultNumber_++;
   }
 
+  this->printMsg("Queries done (" + std::to_string(segments.size())
+                   + " segments)",
+                 1.0, t.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
   return 0;
 }
 
 int RangeDrivenOctree::statNode(const SimplexId &nodeId, std::ostream &stream) {
 
+  const auto &domainBox = nodeDomainBox_[nodeId];
+  const auto &node = nodeList_[nodeId];
+
   stream << "[RangeDrivenOctree]" << std::endl;
   stream << "[RangeDrivenOctree] Node #" << nodeId << std::endl;
-  stream << "[RangeDrivenOctree]   Domain box: ["
-         << nodeList_[nodeId].domainBox_[0].first << " "
-         << nodeList_[nodeId].domainBox_[0].second << "] ["
-         << nodeList_[nodeId].domainBox_[1].first << " "
-         << nodeList_[nodeId].domainBox_[1].second << "] ["
-         << nodeList_[nodeId].domainBox_[2].first << " "
-         << nodeList_[nodeId].domainBox_[2].second << "] "
+  stream << "[RangeDrivenOctree]   Domain box: [" << domainBox[0] << " "
+         << domainBox[1] << "] [" << domainBox[2] << " " << domainBox[3]
+         << "] [" << domainBox[4] << " " << domainBox[5] << "] "
          << " volume="
-         << (nodeList_[nodeId].domainBox_[0].second
-             - nodeList_[nodeId].domainBox_[0].first)
-              * (nodeList_[nodeId].domainBox_[1].second
-                 - nodeList_[nodeId].domainBox_[1].first)
-              * (nodeList_[nodeId].domainBox_[2].second
-                 - nodeList_[nodeId].domainBox_[2].first)
+         << (domainBox[1] - domainBox[0]) * (domainBox[3] - domainBox[2])
+              * (domainBox[5] - domainBox[4])
          << " threshold=" << leafMinimumDomainVolumeRatio_ * domainVolume_
          << std::endl;
-  stream << "[RangeDrivenOctree]   Range box: ["
-         << nodeList_[nodeId].rangeBox_.first.first << " "
-         << nodeList_[nodeId].rangeBox_.first.second << "] ["
-         << nodeList_[nodeId].rangeBox_.second.first << " "
-         << nodeList_[nodeId].rangeBox_.second.second << "] "
+  stream << "[RangeDrivenOctree]   Range box: [" << nodeUMin_[nodeId] << " "
+         << nodeUMax_[nodeId] << "] [" << nodeVMin_[nodeId] << " "
+         << nodeVMax_[nodeId] << "] "
          << " area="
-         << (nodeList_[nodeId].rangeBox_.first.second
-             - nodeList_[nodeId].rangeBox_.first.first)
-              * (nodeList_[nodeId].rangeBox_.second.second
-                 - nodeList_[nodeId].rangeBox_.second.first)
+         << (nodeUMax_[nodeId] - nodeUMin_[nodeId])
+              * (nodeVMax_[nodeId] - nodeVMin_[nodeId])
          << " threshold=" << leafMinimumRangeAreaRatio_ * rangeArea_
          << std::endl;
   stream << "[RangeDrivenOctree] Number of cells: "
-         << nodeList_[nodeId].cellList_.size() << std::endl;
+         << (node.firstChild_ == -1 ? node.cellEnd_ - node.cellBegin_ : 0)
+         << std::endl;
 
   return 0;
 }
@@ -285,22 +470,20 @@ int RangeDrivenOctree::stats(std::ostream &stream) {
   SimplexId maxCellId = 0;
 
   for(size_t i = 0; i < nodeList_.size(); i++) {
-    if(!nodeList_[i].childList_.size()) {
+    if(nodeList_[i].firstChild_ == -1) {
       // leaf
       leafNumber++;
-      if(nodeList_[i].cellList_.size()) {
+      const SimplexId cellNumber
+        = nodeList_[i].cellEnd_ - nodeList_[i].cellBegin_;
+      if(cellNumber) {
         nonEmptyLeafNumber++;
-        storedCellNumber += nodeList_[i].cellList_.size();
-
-        averageCellNumber += nodeList_[i].cellList_.size();
-        if((minCellNumber == -1)
-           || (nodeList_[i].cellList_.size()
-               < static_cast<size_t>(minCellNumber)))
-          minCellNumber = nodeList_[i].cellList_.size();
-        if((maxCellNumber == -1)
-           || (nodeList_[i].cellList_.size()
-               > static_cast<size_t>(maxCellNumber))) {
-          maxCellNumber = nodeList_[i].cellList_.size();
+        storedCellNumber += cellNumber;
+
+        averageCellNumber += cellNumber;
+        if((minCellNumber == -1) || (cellNumber < minCellNumber))
+          minCellNumber = cellNumber;
+        if((maxCellNumber == -1) || (cellNumber > maxCellNumber)) {
+          maxCellNumber = cellNumber;
           maxCellId = i;
         }
       }
@@ -326,7 +509,8 @@ int RangeDrivenOctree::stats(std::ostream &stream) {
 
   if(debugLevel_ > 5) {
     for(size_t i = 0; i < nodeList_.size(); i++) {
-      if(nodeList_[i].cellList_.size())
+      if((nodeList_[i].firstChild_ == -1)
+         && (nodeList_[i].cellEnd_ > nodeList_[i].cellBegin_))
         statNode(i, stream);
     }
   }
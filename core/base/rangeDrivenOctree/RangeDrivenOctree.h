@@ -22,6 +22,8 @@
 #include <Debug.h>
 #include <Triangulation.h>
 
+#include <array>
+
 namespace ttk {
 
   class RangeDrivenOctree : virtual public Debug {
@@ -44,6 +46,18 @@ namespace ttk {
                           const std::pair<double, double> &p1,
                           std::vector<SimplexId> &cellList) const;
 
+    /**
+     * @brief Answer several range segment queries in one traversal
+     *
+     * @param[in] segments Range segments (typically the edges of a polygon)
+     * @param[out] cellLists Cells of the leaves hit by each segment, in the
+     * same order as with the single segment query
+     */
+    int rangeSegmentQuery(
+      const std::vector<std::pair<std::pair<double, double>,
+                                  std::pair<double, double>>> &segments,
+      std::vector<std::vector<SimplexId>> &cellLists) const;
+
     inline void setCellList(const SimplexId *cellList) {
       cellList_ = cellList;
     }
@@ -82,25 +96,64 @@ namespace ttk {
     int statNode(const SimplexId &nodeId, std::ostream &stream);
 
   protected:
+    // the 8 children of a node are consecutive in nodeList_ and the cells of
+    // its subtree are cellIds_[cellBegin_, cellEnd_)
     struct OctreeNode {
-      std::pair<std::pair<double, double>, std::pair<double, double>>
-        rangeBox_{};
-      std::vector<SimplexId> cellList_{};
-      std::vector<SimplexId> childList_{};
-      std::vector<std::pair<float, float>> domainBox_{};
+      SimplexId firstChild_{-1};
+      SimplexId cellBegin_{}, cellEnd_{};
     };
 
-    template <class dataTypeU, class dataTypeV>
-    int buildNode(const std::vector<SimplexId> &cellList,
-                  const std::vector<std::pair<float, float>> &domainBox,
-                  const std::pair<std::pair<double, double>,
-                                  std::pair<double, double>> &rangeBox,
-                  SimplexId &nodeId);
+    // cell numbers and range boxes of the children of a node
+    struct NodeSplit {
+      std::array<SimplexId, 8> cellNumber_{};
+      std::array<std::array<double, 4>, 8> rangeBox_{};
+    };
 
-    int rangeSegmentQuery(const std::pair<double, double> &p0,
+    int buildNodes(const std::array<float, 6> &domainBox,
+                   const std::array<double, 4> &rangeBox);
+
+    bool isSplit(const SimplexId &nodeId) const;
+
+    inline int getChildId(const SimplexId &cellId,
+                          const std::array<float, 6> &domainBox,
+                          const std::array<float, 3> &mid) const {
+      int childId = 0;
+      for(int j = 0; j < 3; j++) {
+        const float p = cellDomainMin_[cellId][j];
+        if((p >= mid[j]) && (p < domainBox[2 * j + 1])) {
+          childId |= 4 >> j;
+        } else if((p < domainBox[2 * j]) || (p >= mid[j])) {
+          // outside of the node, fall back to the first child
+          return 0;
+        }
+      }
+      return childId;
+    }
+
+    void classifyCells(const SimplexId &begin,
+                       const SimplexId &end,
+                       const std::array<float, 6> &domainBox,
+                       const std::array<float, 3> &mid,
+                       NodeSplit &split) const;
+
+    void scatterCells(const SimplexId &begin,
+                      const SimplexId &end,
+                      const std::array<float, 6> &domainBox,
+                      const std::array<float, 3> &mid,
+                      std::array<SimplexId, 8> &offsets,
+                      std::vector<SimplexId> &buffer) const;
+
+    void setChildren(const SimplexId &nodeId,
+                     const std::array<float, 3> &mid,
+                     const NodeSplit &split);
+
+    void splitNode(const SimplexId &nodeId,
+                   const int &chunkNumber,
+                   std::vector<SimplexId> &buffer);
+
+    bool nodeIntersection(const std::pair<double, double> &p0,
                           const std::pair<double, double> &p1,
-                          const SimplexId &nodeId,
-                          std::vector<SimplexId> &cellList) const;
+                          const SimplexId &nodeId) const;
 
     bool segmentIntersection(const std::pair<double, double> &p0,
                              const std::pair<double, double> &p1,
@@ -115,11 +168,20 @@ namespace ttk {
       leafMinimumRangeAreaRatio_{0.01F}, rangeArea_{};
     SimplexId cellNumber_{}, vertexNumber_{}, leafMinimumCellNumber_{6},
       rootId_{};
+    // nodes above this size are split with all the threads
+    SimplexId parallelSplitCellNumber_{65536};
     mutable SimplexId queryResultNumber_{};
     std::vector<OctreeNode> nodeList_{};
-    std::vector<std::vector<std::pair<float, float>>> cellDomainBox_{};
-    std::vector<std::pair<std::pair<double, double>, std::pair<double, double>>>
-      cellRangeBox_{};
+    // range boxes of the nodes
+    std::vector<double> nodeUMin_{}, nodeUMax_{}, nodeVMin_{}, nodeVMax_{};
+    // domain boxes of the nodes (xMin, xMax, yMin, yMax, zMin, zMax)
+    std::vector<std::array<float, 6>> nodeDomainBox_{};
+    // cell identifiers, grouped by node
+    std::vector<SimplexId> cellIds_{};
+    // minimum corner of the domain box of each cell
+    std::vector<std::array<float, 3>> cellDomainMin_{};
+    // range box of each cell (uMin, uMax, vMin, vMax)
+    std::vector<std::array<double, 4>> cellRangeBox_{};
   };
 } // namespace ttk
 
@@ -143,8 +205,7 @@ int ttk::RangeDrivenOctree::build(
     vertexNumber_ = triangulation->getNumberOfVertices();
   }
 
-  cellDomainBox_.resize(cellNumber_, std::vector<std::pair<float, float>>(3));
-
+  cellDomainMin_.resize(cellNumber_);
   cellRangeBox_.resize(cellNumber_);
 
   // WARNING: assuming tets only here
@@ -153,10 +214,10 @@ int ttk::RangeDrivenOctree::build(
 #endif
   for(SimplexId i = 0; i < cellNumber_; i++) {
 
-    for(int j = 0; j < 3; j++) {
-      cellDomainBox_[i][j].first = FLT_MAX;
-      cellDomainBox_[i][j].second = -FLT_MAX;
-    }
+    // only the minimum corner of the domain box is used for the splits
+    auto &domainMin = cellDomainMin_[i];
+    auto &rangeBox = cellRangeBox_[i];
+    domainMin.fill(FLT_MAX);
 
     const SimplexId *cell = NULL;
     if(!triangulation) {
@@ -165,7 +226,6 @@ int ttk::RangeDrivenOctree::build(
 
     for(int j = 0; j < 4; j++) {
 
-      // update the domain bounding box for that tet
       SimplexId vertexId = 0;
 
       if(triangulation) {
@@ -183,55 +243,32 @@ int ttk::RangeDrivenOctree::build(
         p[2] = pointList_[3 * vertexId + 2];
       }
 
-      // update x-range
-      if(p[0] < cellDomainBox_[i][0].first)
-        cellDomainBox_[i][0].first = p[0];
-      if(p[0] > cellDomainBox_[i][0].second)
-        cellDomainBox_[i][0].second = p[0];
-
-      // update y-range
-      if(p[1] < cellDomainBox_[i][1].first)
-        cellDomainBox_[i][1].first = p[1];
-      if(p[1] > cellDomainBox_[i][1].second)
-        cellDomainBox_[i][1].second = p[1];
-
-      // update z-range
-      if(p[2] < cellDomainBox_[i][2].first)
-        cellDomainBox_[i][2].first = p[2];
-      if(p[2] > cellDomainBox_[i][2].second)
-        cellDomainBox_[i][2].second = p[2];
+      for(int k = 0; k < 3; k++) {
+        if(p[k] < domainMin[k])
+          domainMin[k] = p[k];
+      }
 
       // update the range bounding box
+      const double uValue = u[vertexId];
+      const double vValue = v[vertexId];
       if(!j) {
-        cellRangeBox_[i].first.first = u[vertexId];
-        cellRangeBox_[i].first.second = u[vertexId];
-
-        cellRangeBox_[i].second.first = v[vertexId];
-        cellRangeBox_[i].second.second = v[vertexId];
+        rangeBox = {uValue, uValue, vValue, vValue};
       } else {
-
-        // update u
-        if(u[vertexId] < cellRangeBox_[i].first.first)
-          cellRangeBox_[i].first.first = u[vertexId];
-        if(u[vertexId] > cellRangeBox_[i].first.second)
-          cellRangeBox_[i].first.second = u[vertexId];
-
-        // update v
-        if(v[vertexId] < cellRangeBox_[i].second.first)
-          cellRangeBox_[i].second.first = v[vertexId];
-        if(v[vertexId] > cellRangeBox_[i].second.second)
-          cellRangeBox_[i].second.second = v[vertexId];
+        if(uValue < rangeBox[0])
+          rangeBox[0] = uValue;
+        if(uValue > rangeBox[1])
+          rangeBox[1] = uValue;
+        if(vValue < rangeBox[2])
+          rangeBox[2] = vValue;
+        if(vValue > rangeBox[3])
+          rangeBox[3] = vValue;
       }
     }
   }
 
-  std::vector<SimplexId> domain(cellNumber_);
-  for(SimplexId i = 0; i < cellNumber_; i++)
-    domain[i] = i;
-
   // get global bBoxes
-  std::vector<std::pair<float, float>> domainBox(3);
-  std::pair<std::pair<double, double>, std::pair<double, double>> rangeBox;
+  std::array<float, 6> domainBox{};
+  std::array<double, 4> rangeBox{};
 
   for(SimplexId i = 0; i < vertexNumber_; i++) {
 
@@ -247,36 +284,34 @@ int ttk::RangeDrivenOctree::build(
 
     for(int j = 0; j < 3; j++) {
       if(!i) {
-        domainBox[j].first = domainBox[j].second = p[j];
+        domainBox[2 * j] = domainBox[2 * j + 1] = p[j];
       } else {
-        if(p[j] < domainBox[j].first)
-          domainBox[j].first = p[j];
-        if(p[j] > domainBox[j].second)
-          domainBox[j].second = p[j];
+        if(p[j] < domainBox[2 * j])
+          domainBox[2 * j] = p[j];
+        if(p[j] > domainBox[2 * j + 1])
+          domainBox[2 * j + 1] = p[j];
       }
     }
 
+    const double uValue = u[i];
+    const double vValue = v[i];
     if(!i) {
-      rangeBox.first.first = rangeBox.first.second = u[i];
-      rangeBox.second.first = rangeBox.second.second = v[i];
+      rangeBox = {uValue, uValue, vValue, vValue};
     } else {
-      if(u[i] < rangeBox.first.first)
-        rangeBox.first.first = u[i];
-      if(u[i] > rangeBox.first.second)
-        rangeBox.first.second = u[i];
-
-      if(v[i] < rangeBox.second.first)
-        rangeBox.second.first = v[i];
-      if(v[i] > rangeBox.second.second)
-        rangeBox.second.second = v[i];
+      if(uValue < rangeBox[0])
+        rangeBox[0] = uValue;
+      if(uValue > rangeBox[1])
+        rangeBox[1] = uValue;
+      if(vValue < rangeBox[2])
+        rangeBox[2] = vValue;
+      if(vValue > rangeBox[3])
+        rangeBox[3] = vValue;
     }
   }
 
-  rangeArea_ = (rangeBox.first.second - rangeBox.first.first)
-               * (rangeBox.second.second - rangeBox.second.first);
-  domainVolume_ = (domainBox[0].second - domainBox[0].first)
-                  * (domainBox[1].second - domainBox[1].first)
-                  * (domainBox[2].second - domainBox[2].first);
+  rangeArea_ = (rangeBox[1] - rangeBox[0]) * (rangeBox[3] - rangeBox[2]);
+  domainVolume_ = (domainBox[1] - domainBox[0]) * (domainBox[3] - domainBox[2])
+                  * (domainBox[5] - domainBox[4]);
 
   // special case for tets obtained from regular grid subdivision (assuming 6)
   if(leafMinimumCellNumber_ < 6)
@@ -288,7 +323,7 @@ int ttk::RangeDrivenOctree::build(
     "Range area ratio: " + std::to_string(leafMinimumRangeAreaRatio_),
     debug::Priority::DETAIL);
 
-  buildNode<dataTypeU, dataTypeV>(domain, domainBox, rangeBox, rootId_);
+  buildNodes(domainBox, rangeBox);
 
   this->printMsg("Octree built", 1.0, t.getElapsedTime(), this->threadNumber_);
 
@@ -298,184 +333,3 @@ int ttk::RangeDrivenOctree::build(
 
   return 0;
 }
-
-template <class dataTypeU, class dataTypeV>
-int ttk::RangeDrivenOctree::buildNode(
-  const std::vector<SimplexId> &cellList,
-  const std::vector<std::pair<float, float>> &domainBox,
-  const std::pair<std::pair<double, double>, std::pair<double, double>>
-    &rangeBox,
-  SimplexId &nodeId) {
-
-  nodeId = nodeList_.size();
-
-  nodeList_.resize(nodeList_.size() + 1);
-
-  nodeList_.back().rangeBox_ = rangeBox;
-  nodeList_.back().domainBox_ = domainBox;
-
-  float rangeArea = (rangeBox.first.second - rangeBox.first.first)
-                    * (rangeBox.second.second - rangeBox.second.first);
-
-  float domainVolume = (domainBox[0].second - domainBox[0].first)
-                       * (domainBox[1].second - domainBox[1].first)
-                       * (domainBox[2].second - domainBox[2].first);
-
-  if(((SimplexId)cellList.size() > leafMinimumCellNumber_)
-     && (rangeArea > leafMinimumRangeAreaRatio_ * rangeArea_)
-     && (domainVolume > leafMinimumDomainVolumeRatio_ * domainVolume_)) {
-
-    nodeList_.back().childList_.resize(8);
-
-    std::vector<std::vector<std::pair<float, float>>> childDomainBox(8);
-    for(SimplexId i = 0; i < (SimplexId)childDomainBox.size(); i++) {
-      childDomainBox[i].resize(3);
-    }
-    std::vector<std::pair<std::pair<dataTypeU, dataTypeU>,
-                          std::pair<dataTypeV, dataTypeV>>>
-      childRangeBox(8);
-    std::vector<std::vector<SimplexId>> childCellList(8);
-
-    float midX
-      = domainBox[0].first + (domainBox[0].second - domainBox[0].first) / 2.0;
-    float midY
-      = domainBox[1].first + (domainBox[1].second - domainBox[1].first) / 2.0;
-    float midZ
-      = domainBox[2].first + (domainBox[2].second - domainBox[2].first) / 2.0;
-
-    // 0 - - -
-    childDomainBox[0][0].first = domainBox[0].first;
-    childDomainBox[0][0].second = midX;
-    childDomainBox[0][1].first = domainBox[1].first;
-    childDomainBox[0][1].second = midY;
-    childDomainBox[0][2].first = domainBox[2].first;
-    childDomainBox[0][2].second = midZ;
-
-    // 1 - - +
-    childDomainBox[1][0].first = domainBox[0].first;
-    childDomainBox[1][0].second = midX;
-    childDomainBox[1][1].first = domainBox[1].first;
-    childDomainBox[1][1].second = midY;
-    childDomainBox[1][2].first = midZ;
-    childDomainBox[1][2].second = domainBox[2].second;
-
-    // 2 - + -
-    childDomainBox[2][0].first = domainBox[0].first;
-    childDomainBox[2][0].second = midX;
-    childDomainBox[2][1].first = midY;
-    childDomainBox[2][1].second = domainBox[1].second;
-    childDomainBox[2][2].first = domainBox[2].first;
-    childDomainBox[2][2].second = midZ;
-
-    // 3 - + +
-    childDomainBox[3][0].first = domainBox[0].first;
-    childDomainBox[3][0].second = midX;
-    childDomainBox[3][1].first = midY;
-    childDomainBox[3][1].second = domainBox[1].second;
-    childDomainBox[3][2].first = midZ;
-    childDomainBox[3][2].second = domainBox[2].second;
-
-    // 4 + - -
-    childDomainBox[4][0].first = midX;
-    childDomainBox[4][0].second = domainBox[0].second;
-    childDomainBox[4][1].first = domainBox[1].first;
-    childDomainBox[4][1].second = midY;
-    childDomainBox[4][2].first = domainBox[2].first;
-    childDomainBox[4][2].second = midZ;
-
-    // 5 + - +
-    childDomainBox[5][0].first = midX;
-    childDomainBox[5][0].second = domainBox[0].second;
-    childDomainBox[5][1].first = domainBox[1].first;
-    childDomainBox[5][1].second = midY;
-    childDomainBox[5][2].first = midZ;
-    childDomainBox[5][2].second = domainBox[2].second;
-
-    // 6 + + -
-    childDomainBox[6][0].first = midX;
-    childDomainBox[6][0].second = domainBox[0].second;
-    childDomainBox[6][1].first = midY;
-    childDomainBox[6][1].second = domainBox[1].second;
-    childDomainBox[6][2].first = domainBox[2].first;
-    childDomainBox[6][2].second = midZ;
-
-    // 7 + + +
-    childDomainBox[7][0].first = midX;
-    childDomainBox[7][0].second = domainBox[0].second;
-    childDomainBox[7][1].first = midY;
-    childDomainBox[7][1].second = domainBox[1].second;
-    childDomainBox[7][2].first = midZ;
-    childDomainBox[7][2].second = domainBox[2].second;
-
-    for(SimplexId i = 0; i < (SimplexId)cellList.size(); i++) {
-
-      SimplexId childId = 0;
-
-      for(int j = 0; j < 8; j++) {
-        if((cellDomainBox_[cellList[i]][0].first >= childDomainBox[j][0].first)
-           && (cellDomainBox_[cellList[i]][0].first
-               < childDomainBox[j][0].second)
-           && (cellDomainBox_[cellList[i]][1].first
-               >= childDomainBox[j][1].first)
-           && (cellDomainBox_[cellList[i]][1].first
-               < childDomainBox[j][1].second)
-           && (cellDomainBox_[cellList[i]][2].first
-               >= childDomainBox[j][2].first)
-           && (cellDomainBox_[cellList[i]][2].first
-               < childDomainBox[j][2].second)) {
-
-          childId = j;
-          break;
-        }
-      }
-
-      // update child's range box
-      if(childCellList[childId].empty()) {
-        childRangeBox[childId].first.first
-          = cellRangeBox_[cellList[i]].first.first;
-        childRangeBox[childId].first.second
-          = cellRangeBox_[cellList[i]].first.second;
-
-        childRangeBox[childId].second.first
-          = cellRangeBox_[cellList[i]].second.first;
-        childRangeBox[childId].second.second
-          = cellRangeBox_[cellList[i]].second.second;
-      } else {
-        if(cellRangeBox_[cellList[i]].first.first
-           < childRangeBox[childId].first.first) {
-          childRangeBox[childId].first.first
-            = cellRangeBox_[cellList[i]].first.first;
-        }
-        if(cellRangeBox_[cellList[i]].first.second
-           > childRangeBox[childId].first.second) {
-          childRangeBox[childId].first.second
-            = cellRangeBox_[cellList[i]].first.second;
-        }
-
-        if(cellRangeBox_[cellList[i]].second.first
-           < childRangeBox[childId].second.first) {
-          childRangeBox[childId].second.first
-            = cellRangeBox_[cellList[i]].second.first;
-        }
-        if(cellRangeBox_[cellList[i]].second.second
-           > childRangeBox[childId].second.second) {
-          childRangeBox[childId].second.second
-            = cellRangeBox_[cellList[i]].second.second;
-        }
-      }
-
-      childCellList[childId].push_back(cellList[i]);
-    }
-
-    for(int i = 0; i < 8; i++) {
-      buildNode<dataTypeU, dataTypeV>(childCellList[i], childDomainBox[i],
-                                      childRangeBox[i],
-                                      nodeList_[nodeId].childList_[i]);
-    }
-  } else {
-    // leaf
-    nodeList_[nodeId].cellList_ = cellList;
-  }
-
-  return 0;
-}
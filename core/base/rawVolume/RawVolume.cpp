@@ -0,0 +1,327 @@
+#include <RawVolume.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+  std::string trim(const std::string &str) {
+    const auto begin = str.find_first_not_of(" \t\r");
+    if(begin == std::string::npos) {
+      return {};
+    }
+    const auto end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+  }
+
+  ttk::RawVolume::ScalarType getNrrdType(const std::string &name) {
+    using ST = ttk::RawVolume::ScalarType;
+    // all the spellings allowed by the NRRD format
+    static const std::vector<std::pair<std::vector<std::string>, ST>> types{
+      {{"signed char", "int8", "int8_t"}, ST::INT8},
+      {{"uchar", "unsigned char", "uint8", "uint8_t"}, ST::UINT8},
+      {{"short", "short int", "signed short", "signed short int", "int16",
+        "int16_t"},
+       ST::INT16},
+      {{"ushort", "unsigned short", "unsigned short int", "uint16",
+        "uint16_t"},
+       ST::UINT16},
+      {{"int", "signed int", "int32", "int32_t"}, ST::INT32},
+      {{"uint", "unsigned int", "uint32", "uint32_t"}, ST::UINT32},
+      {{"longlong", "long long", "long long int", "signed long long",
+        "signed long long int", "int64", "int64_t"},
+       ST::INT64},
+      {{"ulonglong", "unsigned long long", "unsigned long long int", "uint64",
+        "uint64_t"},
+       ST::UINT64},
+      {{"float"}, ST::FLOAT},
+      {{"double"}, ST::DOUBLE},
+    };
+    for(const auto &type : types) {
+      if(std::find(type.first.begin(), type.first.end(), name)
+         != type.first.end()) {
+        return type.second;
+      }
+    }
+    return ST::UNKNOWN;
+  }
+
+  /// Vectors of a NRRD field, e.g. "(1,0,0) none (0,0,1)" (empty for none)
+  std::vector<std::vector<double>> parseVectors(const std::string &value) {
+    std::vector<std::vector<double>> res{};
+    size_t pos = 0;
+    while(pos < value.size()) {
+      if(value[pos] == '(') {
+        const auto end = value.find(')', pos);
+        if(end == std::string::npos) {
+          break;
+        }
+        std::stringstream ss(value.substr(pos + 1, end - pos - 1));
+        std::vector<double> vec{};
+        std::string item;
+        while(std::getline(ss, item, ',')) {
+          vec.emplace_back(std::atof(item.data()));
+        }
+        res.emplace_back(vec);
+        pos = end + 1;
+      } else if(value.compare(pos, 4, "none") == 0) {
+        res.emplace_back();
+        pos += 4;
+      } else {
+        pos++;
+      }
+    }
+    return res;
+  }
+} // namespace
+
+ttk::RawVolume::RawVolume() {
+  this->setDebugMsgPrefix("RawVolume");
+}
+
+size_t ttk::RawVolume::getScalarSize(const ScalarType type) {
+  switch(type) {
+    case ScalarType::INT8:
+    case ScalarType::UINT8:
+      return 1;
+    case ScalarType::INT16:
+    case ScalarType::UINT16:
+      return 2;
+    case ScalarType::INT32:
+    case ScalarType::UINT32:
+    case ScalarType::FLOAT:
+      return 4;
+    case ScalarType::INT64:
+    case ScalarType::UINT64:
+    case ScalarType::DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+bool ttk::RawVolume::isHostLittleEndian() {
+  const uint16_t one{1};
+  char first{};
+  std::memcpy(&first, &one, 1);
+  return first == 1;
+}
+
+bool ttk::RawVolume::isNrrdFile(const std::string &fileName) {
+  std::ifstream file(fileName.data(), std::ios::binary);
+  char magic[4]{};
+  return file.read(magic, 4) && std::strncmp(magic, "NRRD", 4) == 0;
+}
+
+int ttk::RawVolume::readNrrdHeader(const std::string &fileName,
+                                   Header &header) const {
+
+  std::ifstream file(fileName.data(), std::ios::binary);
+  if(!file.is_open()) {
+    this->printErr("Unable to open '" + fileName + "'");
+    return -1;
+  }
+
+  std::string line;
+  if(!std::getline(file, line) || line.compare(0, 4, "NRRD") != 0) {
+    this->printErr("'" + fileName + "' is not a NRRD file");
+    return -1;
+  }
+
+  header = Header{};
+  int dimension{};
+  std::vector<int> sizes{};
+  std::vector<std::string> kinds{};
+  std::vector<std::vector<double>> directions{};
+  std::vector<double> spacings{};
+  std::string encoding{"raw"}, dataFile{};
+  long long byteSkip{}, lineSkip{};
+
+  // fields until the first empty line (or the end of a detached header)
+  while(std::getline(file, line)) {
+    line = trim(line);
+    if(line.empty()) {
+      break;
+    }
+    if(line[0] == '#' || line.find(":=") != std::string::npos) {
+      // comments and key/value pairs
+      continue;
+    }
+    const auto sep = line.find(':');
+    if(sep == std::string::npos) {
+      this->printErr("Invalid NRRD field '" + line + "'");
+      return -1;
+    }
+    const auto field = trim(line.substr(0, sep));
+    const auto value = trim(line.substr(sep + 1));
+    std::stringstream values(value);
+
+    if(field == "type") {
+      header.scalarType = getNrrdType(value);
+    } else if(field == "dimension") {
+      values >> dimension;
+    } else if(field == "sizes") {
+      int size;
+      while(values >> size) {
+        sizes.emplace_back(size);
+      }
+    } else if(field == "kinds") {
+      std::string kind;
+      while(values >> kind) {
+        kinds.emplace_back(kind);
+      }
+    } else if(field == "spacings") {
+      std::string spacing;
+      while(values >> spacing) {
+        spacings.emplace_back(std::atof(spacing.data()));
+      }
+    } else if(field == "space directions") {
+      directions = parseVectors(value);
+    } else if(field == "space origin") {
+      const auto origin = parseVectors(value);
+      if(!origin.empty()) {
+        for(size_t i = 0; i < std::min<size_t>(3, origin[0].size()); ++i) {
+          header.origin[i] = origin[0][i];
+        }
+      }
+    } else if(field == "encoding") {
+      encoding = value;
+    } else if(field == "endian") {
+      header.littleEndian = value != "big";
+    } else if(field == "data file" || field == "datafile") {
+      dataFile = value;
+    } else if(field == "byte skip" || field == "byteskip") {
+      values >> byteSkip;
+    } else if(field == "line skip" || field == "lineskip") {
+      values >> lineSkip;
+    }
+  }
+
+  if(header.scalarType == ScalarType::UNKNOWN) {
+    this->printErr("Unsupported NRRD type");
+    return -1;
+  }
+  if(encoding != "raw") {
+    this->printErr("Unsupported NRRD encoding '" + encoding
+                   + "' (only raw data can be mapped)");
+    return -1;
+  }
+  if(lineSkip != 0) {
+    this->printErr("Unsupported NRRD line skip");
+    return -1;
+  }
+  if(dimension < 1 || static_cast<int>(sizes.size()) != dimension) {
+    this->printErr("Invalid NRRD dimension");
+    return -1;
+  }
+
+  // the first axis holds the components of non-scalar fields
+  const bool hasComponents
+    = dimension == 4
+      || (dimension > 1 && !kinds.empty() && kinds[0] != "domain"
+          && kinds[0] != "space" && kinds[0] != "time" && kinds[0] != "???");
+  const int firstAxis = hasComponents ? 1 : 0;
+  if(dimension - firstAxis > 3) {
+    this->printErr("Unsupported NRRD dimension");
+    return -1;
+  }
+  header.nComponents = hasComponents ? sizes[0] : 1;
+
+  for(int i = firstAxis; i < dimension; ++i) {
+    const int d = i - firstAxis;
+    header.dimensions[d] = sizes[i];
+    if(i < static_cast<int>(directions.size()) && !directions[i].empty()) {
+      double norm{};
+      for(const auto c : directions[i]) {
+        norm += c * c;
+      }
+      header.spacing[d] = std::sqrt(norm);
+    } else if(i < static_cast<int>(spacings.size())
+              && std::isfinite(spacings[i])) {
+      header.spacing[d] = spacings[i];
+    }
+  }
+
+  if(dataFile.empty()) {
+    // attached data, right after the header
+    header.dataFile = fileName;
+    header.dataOffset = static_cast<long long>(file.tellg()) + byteSkip;
+  } else {
+    if(dataFile.find(' ') != std::string::npos || dataFile == "LIST") {
+      this->printErr("Unsupported NRRD data file list");
+      return -1;
+    }
+    // relative to the header
+    const auto sep = fileName.find_last_of("/\\");
+    if(dataFile[0] != '/' && sep != std::string::npos) {
+      dataFile = fileName.substr(0, sep + 1) + dataFile;
+    }
+    header.dataFile = dataFile;
+    header.dataOffset = byteSkip;
+  }
+
+  return 0;
+}
+
+int ttk::RawVolume::mapVolume(const Header &header,
+                              MappedFile &file,
+                              char *&data,
+                              bool &inPlace) const {
+
+  const auto scalarSize = getScalarSize(header.scalarType);
+  const auto nBytes = getNumberOfValues(header) * scalarSize;
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(scalarSize == 0 || nBytes == 0) {
+    this->printErr("Invalid volume description");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  if(file.open(header.dataFile, true) != 0) {
+    this->printErr("Unable to open '" + header.dataFile + "'");
+    return -1;
+  }
+
+  // negative offsets: the values are at the end of the file
+  const long long offset = header.dataOffset >= 0
+                             ? header.dataOffset
+                             : static_cast<long long>(file.size())
+                                 - static_cast<long long>(nBytes);
+  if(offset < 0 || offset + nBytes > file.size()) {
+    this->printErr("'" + header.dataFile + "' is too small ("
+                   + std::to_string(file.size()) + " bytes, "
+                   + std::to_string(nBytes + std::max(0LL, offset))
+                   + " expected)");
+    file.close();
+    return -1;
+  }
+
+  data = file.writableData() + offset;
+  inPlace = (scalarSize == 1 || header.littleEndian == isHostLittleEndian())
+            && reinterpret_cast<uintptr_t>(data) % scalarSize == 0;
+
+  return 0;
+}
+
+void ttk::RawVolume::copyValues(const Header &header,
+                                const char *data,
+                                char *buffer) const {
+
+  const auto scalarSize = getScalarSize(header.scalarType);
+  const auto nValues = getNumberOfValues(header);
+  std::memcpy(buffer, data, nValues * scalarSize);
+
+  if(scalarSize > 1 && header.littleEndian != isHostLittleEndian()) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nValues; ++i) {
+      std::reverse(buffer + i * scalarSize, buffer + (i + 1) * scalarSize);
+    }
+  }
+}
@@ -0,0 +1,103 @@
+/// \ingroup base
+/// \class ttk::RawVolume
+///
+/// \brief TTK %rawVolume processing package.
+///
+/// %RawVolume describes regular grids stored as raw binary arrays, either
+/// with a NRRD header (attached .nrrd files or detached .nhdr files, raw
+/// encoding only) or with a fixed-size header described by the user.
+///
+/// The data is memory-mapped (copy-on-write): when the byte order matches
+/// the one of the host and the data is aligned, the values are accessed in
+/// place and only the pages actually read are loaded from disk.
+///
+/// \sa ttkRawVolumeReader
+
+#pragma once
+
+// base code includes
+#include <Debug.h>
+#include <MappedFile.h>
+
+#include <array>
+#include <string>
+
+namespace ttk {
+
+  class RawVolume : virtual public Debug {
+
+  public:
+    enum class ScalarType {
+      UNKNOWN,
+      INT8,
+      UINT8,
+      INT16,
+      UINT16,
+      INT32,
+      UINT32,
+      INT64,
+      UINT64,
+      FLOAT,
+      DOUBLE,
+    };
+
+    /// Description of a volume file
+    struct Header {
+      std::array<int, 3> dimensions{1, 1, 1};
+      std::array<double, 3> spacing{1.0, 1.0, 1.0};
+      std::array<double, 3> origin{0.0, 0.0, 0.0};
+      ScalarType scalarType{ScalarType::UNKNOWN};
+      int nComponents{1};
+      bool littleEndian{true};
+      /// file holding the values
+      std::string dataFile{};
+      /// offset of the values in dataFile (-1: at the end of the file)
+      long long dataOffset{};
+    };
+
+    RawVolume();
+
+    static size_t getScalarSize(const ScalarType type);
+    static bool isHostLittleEndian();
+
+    /**
+     * @brief Check whether a file starts with the NRRD magic number
+     */
+    static bool isNrrdFile(const std::string &fileName);
+
+    /**
+     * @brief Parse the header of a NRRD file
+     * @return 0 on success, -1 otherwise
+     */
+    int readNrrdHeader(const std::string &fileName, Header &header) const;
+
+    /**
+     * @brief Map the values of a volume
+     *
+     * @param[in] header Description of the volume
+     * @param[out] file Copy-on-write mapping of the data file
+     * @param[out] data First value of the volume in the mapping
+     * @param[out] inPlace Whether the values can be used in place (same
+     * byte order as the host and aligned), otherwise they have to be copied
+     * with copyValues()
+     * @return 0 on success, -1 otherwise
+     */
+    int mapVolume(const Header &header,
+                  MappedFile &file,
+                  char *&data,
+                  bool &inPlace) const;
+
+    /**
+     * @brief Copy (and byte-swap if needed) mapped values in a buffer
+     */
+    void copyValues(const Header &header,
+                    const char *data,
+                    char *buffer) const;
+
+    static inline size_t getNumberOfValues(const Header &header) {
+      return static_cast<size_t>(header.dimensions[0]) * header.dimensions[1]
+             * header.dimensions[2] * header.nComponents;
+    }
+  };
+
+} // namespace ttk
@@ -4,6 +4,38 @@ ttk::ReebSpace::ReebSpace() {
   this->setDebugMsgPrefix("ReebSpace");
 }
 
+bool ttk::ReebSpace::isCutEdge(
+  const SimplexId &vertexId0,
+  const SimplexId &vertexId1,
+  const std::vector<std::array<SimplexId, 3>> &triangles) const {
+
+  for(const auto &triangle : triangles) {
+    const auto &sheet = originalData_.sheet2List_[triangle[0]];
+    const auto &fiberTriangle = sheet.triangleList_[triangle[1]][triangle[2]];
+
+    for(int i = 0; i < 3; i++) {
+      std::pair<SimplexId, SimplexId> meshEdge;
+
+      if(fiberSurfaceVertexList_.size()) {
+        // the fiber surfaces have been merged
+        meshEdge
+          = fiberSurfaceVertexList_[fiberTriangle.vertexIds_[i]].meshEdge_;
+      } else {
+        // the fiber surfaces have not been merged
+        meshEdge = sheet.vertexList_[triangle[1]][fiberTriangle.vertexIds_[i]]
+                     .meshEdge_;
+      }
+
+      if(((meshEdge.first == vertexId0) && (meshEdge.second == vertexId1))
+         || ((meshEdge.second == vertexId0) && (meshEdge.first == vertexId1))) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 int ttk::ReebSpace::connect3sheetTo0sheet(ReebSpaceData &data,
                                           const SimplexId &sheet3Id,
                                           const SimplexId &sheet0Id) {
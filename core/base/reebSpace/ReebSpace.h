@@ -34,6 +34,7 @@
 #include <JacobiSet.h>
 #include <Triangulation.h>
 
+#include <atomic>
 #include <map>
 #include <set>
 
@@ -306,17 +307,50 @@ namespace ttk {
                                      const dataTypeV *const vField,
                                      const triangulationType &triangulation);
 
-    template <typename triangulationType>
-    int compute3sheet(
-      const SimplexId &vertexId,
-      const std::vector<std::vector<std::vector<SimplexId>>> &tetTriangles,
-      const triangulationType &triangulation);
-
     template <typename triangulationType>
     int compute3sheets(
-      std::vector<std::vector<std::vector<SimplexId>>> &tetTriangles,
+      std::vector<std::vector<std::array<SimplexId, 3>>> &tetTriangles,
       const triangulationType &triangulation);
 
+    /// Whether the edge (vertexId0, vertexId1) of a tetrahedron is cut by
+    /// one of its fiber surface triangles
+    bool
+      isCutEdge(const SimplexId &vertexId0,
+                const SimplexId &vertexId1,
+                const std::vector<std::array<SimplexId, 3>> &triangles) const;
+
+    // concurrent union-find (the root of a set is its smallest element)
+    static inline SimplexId
+      findRoot(std::vector<std::atomic<SimplexId>> &parents, SimplexId id) {
+      SimplexId parent = parents[id].load();
+      while(parent != id) {
+        // path halving
+        const SimplexId grandParent = parents[parent].load();
+        if(grandParent != parent)
+          parents[id].compare_exchange_weak(parent, grandParent);
+        id = grandParent;
+        parent = parents[id].load();
+      }
+      return id;
+    }
+
+    static inline void unionRoots(std::vector<std::atomic<SimplexId>> &parents,
+                                  SimplexId id0,
+                                  SimplexId id1) {
+      while(true) {
+        id0 = findRoot(parents, id0);
+        id1 = findRoot(parents, id1);
+        if(id0 == id1)
+          return;
+        if(id0 < id1)
+          std::swap(id0, id1);
+        // link the larger root, fails if it is not a root anymore
+        SimplexId expected = id0;
+        if(parents[id0].compare_exchange_strong(expected, id1))
+          return;
+      }
+    }
+
     template <class dataTypeU, class dataTypeV, typename triangulationType>
     inline int
       computeGeometricalMeasures(Sheet3 &sheet,
@@ -437,10 +471,21 @@ inline int ttk::ReebSpace::execute(const dataTypeU *const uField,
 
   Timer t;
 
+  // wall-clock time of each stage, reported at the end
+  Timer stageTimer;
+  std::vector<std::vector<std::string>> stageTimings{{"Stage", "Time"}};
+  const auto addStageTiming = [&stageTimings, &stageTimer](
+                                const std::string &stage) {
+    stageTimings.push_back({stage, std::to_string(stageTimer.getElapsedTime())
+                                     + " s"});
+    stageTimer.reStart();
+  };
+
   // 1) compute the jacobi set
   jacobiSet_.setSosOffsetsU(sosOffsetsU_);
   jacobiSet_.setSosOffsetsV(sosOffsetsV_);
   jacobiSet_.execute(jacobiSetEdges_, uField, vField, triangulation);
+  addStageTiming("Jacobi set");
 
   // 2) compute the list saddle 1-sheets
   // + list of saddle 0-sheets
@@ -448,13 +493,17 @@ inline int ttk::ReebSpace::execute(const dataTypeU *const uField,
   compute1sheetsOnly(jacobiSetEdges_, jacobiSetClassification, triangulation);
   // at this stage, jacobiSetClassification contains the list of saddle edges
   // along with their 1-sheet Id.
+  addStageTiming("0- and 1-sheets");
 
   compute2sheets(jacobiSetClassification, uField, vField, triangulation);
   //   compute2sheetChambers<dataTypeU, dataTypeV>();
+  addStageTiming("2-sheets");
 
-  std::vector<std::vector<std::vector<SimplexId>>> tetTriangles;
+  std::vector<std::vector<std::array<SimplexId, 3>>> tetTriangles;
   compute3sheets(tetTriangles, triangulation);
+  addStageTiming("3-sheets");
 
+  this->printMsg(stageTimings);
   this->printMsg(
     "Data-set processed", 1.0, t.getElapsedTime(), this->threadNumber_);
 
@@ -1191,120 +1240,9 @@ int ttk::ReebSpace::compute1sheets(
   return 0;
 }
 
-template <typename triangulationType>
-int ttk::ReebSpace::compute3sheet(
-  const SimplexId &vertexId,
-  const std::vector<std::vector<std::vector<SimplexId>>> &tetTriangles,
-  const triangulationType &triangulation) {
-
-  SimplexId sheetId = originalData_.sheet3List_.size();
-  originalData_.sheet3List_.resize(originalData_.sheet3List_.size() + 1);
-  originalData_.sheet3List_.back().pruned_ = false;
-  originalData_.sheet3List_.back().preMerger_ = -1;
-  originalData_.sheet3List_.back().Id_ = sheetId;
-
-  std::queue<SimplexId> vertexQueue;
-  vertexQueue.push(vertexId);
-
-  do {
-
-    SimplexId localVertexId = vertexQueue.front();
-    vertexQueue.pop();
-
-    if(originalData_.vertex2sheet3_[localVertexId] == -1) {
-      // not visited yet
-
-      originalData_.sheet3List_.back().vertexList_.push_back(localVertexId);
-      originalData_.vertex2sheet3_[localVertexId] = sheetId;
-
-      SimplexId vertexStarNumber
-        = triangulation.getVertexStarNumber(localVertexId);
-
-      for(SimplexId i = 0; i < vertexStarNumber; i++) {
-        SimplexId tetId = -1;
-        triangulation.getVertexStar(localVertexId, i, tetId);
-
-        if(tetTriangles[tetId].empty()) {
-          //             if(originalData_.tet2sheet3_[tetId] == -1){
-          //               originalData_.tet2sheet3_[tetId] = sheetId;
-          //               originalData_.sheet3List_.back().tetList_.push_back(tetId);
-          //             }
-          for(int j = 0; j < 4; j++) {
-
-            SimplexId tetVertexId = -1;
-            triangulation.getCellVertex(tetId, j, tetVertexId);
-
-            if(originalData_.vertex2sheet3_[tetVertexId] == -1) {
-              vertexQueue.push(tetVertexId);
-            }
-          }
-        } else {
-          // fiber surface in there
-          for(int j = 0; j < 4; j++) {
-            SimplexId otherVertexId = -1;
-            triangulation.getCellVertex(tetId, j, otherVertexId);
-            if((otherVertexId != localVertexId)
-               && (originalData_.vertex2sheet3_[otherVertexId] == -1)) {
-              // we need to see if the edge <localVertexId, otherVertexId> is
-              // cut by a fiber surface triangle or not.
-
-              bool isCut = false;
-              for(size_t k = 0; k < tetTriangles[tetId].size(); k++) {
-                SimplexId l = 0, m = 0, n = 0;
-                l = tetTriangles[tetId][k][0];
-                m = tetTriangles[tetId][k][1];
-                n = tetTriangles[tetId][k][2];
-
-                for(int p = 0; p < 3; p++) {
-                  std::pair<SimplexId, SimplexId> meshEdge;
-
-                  if(fiberSurfaceVertexList_.size()) {
-                    // the fiber surfaces have been merged
-                    meshEdge
-                      = fiberSurfaceVertexList_[originalData_.sheet2List_[l]
-                                                  .triangleList_[m][n]
-                                                  .vertexIds_[p]]
-                          .meshEdge_;
-                  } else {
-                    // the fiber surfaces have not been merged
-                    meshEdge = originalData_.sheet2List_[l]
-                                 .vertexList_[m][originalData_.sheet2List_[l]
-                                                   .triangleList_[m][n]
-                                                   .vertexIds_[p]]
-                                 .meshEdge_;
-                  }
-
-                  if(((meshEdge.first == localVertexId)
-                      && (meshEdge.second == otherVertexId))
-                     || ((meshEdge.second == localVertexId)
-                         && (meshEdge.first == otherVertexId))) {
-                    isCut = true;
-                    break;
-                  }
-                }
-
-                if(isCut)
-                  break;
-              }
-
-              if(!isCut) {
-                // add the vertex to the queue
-                vertexQueue.push(otherVertexId);
-              }
-            }
-          }
-        }
-      }
-    }
-
-  } while(vertexQueue.size());
-
-  return 0;
-}
-
 template <typename triangulationType>
 int ttk::ReebSpace::compute3sheets(
-  std::vector<std::vector<std::vector<SimplexId>>> &tetTriangles,
+  std::vector<std::vector<std::array<SimplexId, 3>>> &tetTriangles,
   const triangulationType &triangulation) {
 
   Timer t;
@@ -1320,12 +1258,8 @@ int ttk::ReebSpace::compute3sheets(
         SimplexId tetId
           = originalData_.sheet2List_[i].triangleList_[j][k].tetId_;
 
-        std::vector<SimplexId> triangle(3);
-        triangle[0] = i;
-        triangle[1] = j;
-        triangle[2] = k;
-
-        tetTriangles[tetId].push_back(triangle);
+        tetTriangles[tetId].push_back(
+          {{(SimplexId)i, (SimplexId)j, (SimplexId)k}});
       }
     }
   }
@@ -1345,9 +1279,95 @@ int ttk::ReebSpace::compute3sheets(
     }
   }
 
+  // the 3-sheets are the connected components of the other vertices, where
+  // two vertices of a tetrahedron are connected if their edge is not cut by
+  // a fiber surface triangle: one concurrent union-find over the tetrahedra
+  std::vector<std::atomic<SimplexId>> parents(vertexNumber_);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < vertexNumber_; i++) {
+    parents[i].store(i);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 1024)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < tetNumber_; i++) {
+
+    std::array<SimplexId, 4> vertexIds{};
+    for(int j = 0; j < 4; j++) {
+      triangulation.getCellVertex(i, j, vertexIds[j]);
+    }
+
+    for(int j = 0; j < 4; j++) {
+      if(originalData_.vertex2sheet3_[vertexIds[j]] != -1)
+        continue;
+      for(int k = j + 1; k < 4; k++) {
+        if(originalData_.vertex2sheet3_[vertexIds[k]] != -1)
+          continue;
+        if(tetTriangles[i].empty()
+           || !isCutEdge(vertexIds[j], vertexIds[k], tetTriangles[i])) {
+          unionRoots(parents, vertexIds[j], vertexIds[k]);
+        }
+      }
+    }
+  }
+
+  std::vector<SimplexId> roots(vertexNumber_, -1);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber_; i++) {
     if(originalData_.vertex2sheet3_[i] == -1) {
-      compute3sheet(i, tetTriangles, triangulation);
+      roots[i] = findRoot(parents, i);
+    }
+  }
+
+  // the roots are the smallest vertices of their sheets: the sheets are
+  // numbered by increasing vertex identifier
+  for(SimplexId i = 0; i < vertexNumber_; i++) {
+    if(roots[i] == -1)
+      continue;
+
+    if(roots[i] == i) {
+      const SimplexId sheetId = originalData_.sheet3List_.size();
+      originalData_.sheet3List_.resize(originalData_.sheet3List_.size() + 1);
+      originalData_.sheet3List_.back().pruned_ = false;
+      originalData_.sheet3List_.back().preMerger_ = -1;
+      originalData_.sheet3List_.back().Id_ = sheetId;
+      originalData_.vertex2sheet3_[i] = sheetId;
+    } else {
+      originalData_.vertex2sheet3_[i]
+        = originalData_.vertex2sheet3_[roots[i]];
+    }
+    originalData_.sheet3List_[originalData_.vertex2sheet3_[i]]
+      .vertexList_.push_back(i);
+  }
+
+  // the tetrahedra without fiber surface belong to the sheet of their
+  // non-jacobi vertices
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < tetNumber_; i++) {
+    if(!tetTriangles[i].empty())
+      continue;
+    for(int j = 0; j < 4; j++) {
+      SimplexId vertexId = -1;
+      triangulation.getCellVertex(i, j, vertexId);
+      if(originalData_.vertex2sheet3_[vertexId] >= 0) {
+        originalData_.tet2sheet3_[i] = originalData_.vertex2sheet3_[vertexId];
+        break;
+      }
+    }
+  }
+  for(SimplexId i = 0; i < tetNumber_; i++) {
+    if(originalData_.tet2sheet3_[i] >= 0) {
+      originalData_.sheet3List_[originalData_.tet2sheet3_[i]]
+        .tetList_.push_back(i);
     }
   }
 
@@ -1356,31 +1376,25 @@ int ttk::ReebSpace::compute3sheets(
     originalData_.sheet3List_.size());
   // end of 3-sheet expansion
 
-  // add the tets in parallel
+  if(expand3sheets_) {
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
 #endif
-  for(size_t i = 0; i < originalData_.sheet3List_.size(); i++) {
-    for(size_t j = 0; j < originalData_.sheet3List_[i].vertexList_.size();
-        j++) {
+    for(size_t i = 0; i < originalData_.sheet3List_.size(); i++) {
+      for(size_t j = 0; j < originalData_.sheet3List_[i].vertexList_.size();
+          j++) {
 
-      SimplexId vertexId = originalData_.sheet3List_[i].vertexList_[j];
-      SimplexId sheetId = originalData_.vertex2sheet3_[vertexId];
+        SimplexId vertexId = originalData_.sheet3List_[i].vertexList_[j];
+        SimplexId sheetId = originalData_.vertex2sheet3_[vertexId];
 
-      SimplexId vertexStarNumber = triangulation.getVertexStarNumber(vertexId);
+        SimplexId vertexStarNumber
+          = triangulation.getVertexStarNumber(vertexId);
 
-      for(SimplexId k = 0; k < vertexStarNumber; k++) {
-        SimplexId tetId = -1;
-        triangulation.getVertexStar(vertexId, k, tetId);
-        if(tetTriangles[tetId].empty()) {
-          if(originalData_.tet2sheet3_[tetId] == -1) {
-            originalData_.tet2sheet3_[tetId] = i;
-            originalData_.sheet3List_[i].tetList_.push_back(tetId);
-          }
-        } else {
-
-          // expending here 3-sheets.
-          if(expand3sheets_) {
+        for(SimplexId k = 0; k < vertexStarNumber; k++) {
+          SimplexId tetId = -1;
+          triangulation.getVertexStar(vertexId, k, tetId);
+          if(!tetTriangles[tetId].empty()) {
+            // expending here 3-sheets.
             for(int l = 0; l < 4; l++) {
               SimplexId otherVertexId = -1;
 
@@ -1463,11 +1477,11 @@ int ttk::ReebSpace::compute3sheets(
               }
             }
           }
-          // end of the 3-sheet expansion
         }
       }
     }
   }
+  // end of the 3-sheet expansion
 
   SimplexId totalSheetNumber = 0;
 
@@ -1565,33 +1579,67 @@ int ttk::ReebSpace::connectSheets(const triangulationType &triangulation) {
 
   Timer t;
 
+  // the adjacencies are gathered per thread as (dimension of the other
+  // sheet, 3-sheet, other sheet), then connected sequentially
+  std::vector<std::vector<std::array<SimplexId, 3>>> threadConnections(
+    threadNumber_);
+  const auto addConnection
+    = [&threadConnections](const SimplexId &dimension,
+                           const SimplexId &sheet3Id,
+                           const SimplexId &otherSheetId) {
+        int threadId = 0;
+#ifdef TTK_ENABLE_OPENMP
+        threadId = omp_get_thread_num();
+#endif // TTK_ENABLE_OPENMP
+        auto &connections = threadConnections[threadId];
+        const std::array<SimplexId, 3> connection{
+          {dimension, sheet3Id, otherSheetId}};
+        if(connections.empty() || (connections.back() != connection)) {
+          connections.push_back(connection);
+        }
+      };
+
+  std::vector<std::pair<size_t, size_t>> triangleLists;
   for(size_t i = 0; i < originalData_.sheet2List_.size(); i++) {
     for(size_t j = 0; j < originalData_.sheet2List_[i].triangleList_.size();
         j++) {
+      triangleLists.emplace_back(i, j);
+    }
+  }
 
-      for(size_t k = 0;
-          k < originalData_.sheet2List_[i].triangleList_[j].size(); k++) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < triangleLists.size(); i++) {
+    const SimplexId sheet2Id = triangleLists[i].first;
+    const auto &triangleList
+      = originalData_.sheet2List_[sheet2Id].triangleList_[triangleLists[i]
+                                                            .second];
 
-        SimplexId tetId
-          = originalData_.sheet2List_[i].triangleList_[j][k].tetId_;
+    for(size_t k = 0; k < triangleList.size(); k++) {
 
-        for(int l = 0; l < 4; l++) {
-          SimplexId vertexId = -1;
-          triangulation.getCellVertex(tetId, l, vertexId);
+      SimplexId tetId = triangleList[k].tetId_;
 
-          SimplexId sheet3Id = originalData_.vertex2sheet3_[vertexId];
+      for(int l = 0; l < 4; l++) {
+        SimplexId vertexId = -1;
+        triangulation.getCellVertex(tetId, l, vertexId);
 
-          if(sheet3Id >= 0) {
-            connect3sheetTo2sheet(originalData_, sheet3Id, i);
-          }
+        SimplexId sheet3Id = originalData_.vertex2sheet3_[vertexId];
+
+        if(sheet3Id >= 0) {
+          addConnection(2, sheet3Id, sheet2Id);
         }
       }
     }
   }
 
   // connect 3-sheets together
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 1024)
+#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber_; i++) {
-    if(originalData_.vertex2sheet3_[i] >= 0) {
+    const SimplexId sheet3Id = originalData_.vertex2sheet3_[i];
+    if(sheet3Id >= 0) {
 
       SimplexId vertexEdgeNumber = triangulation.getVertexEdgeNumber(i);
 
@@ -1604,31 +1652,52 @@ int ttk::ReebSpace::connectSheets(const triangulationType &triangulation) {
           triangulation.getEdgeVertex(edgeId, 1, otherVertexId);
         }
 
-        if(originalData_.vertex2sheet3_[otherVertexId] >= 0) {
-          if(originalData_.vertex2sheet3_[otherVertexId]
-             != originalData_.vertex2sheet3_[i]) {
+        const SimplexId otherSheet3Id
+          = originalData_.vertex2sheet3_[otherVertexId];
 
-            connect3sheetTo3sheet(originalData_,
-                                  originalData_.vertex2sheet3_[i],
-                                  originalData_.vertex2sheet3_[otherVertexId]);
-          }
+        if((otherSheet3Id >= 0) && (otherSheet3Id != sheet3Id)) {
+          addConnection(3, sheet3Id, otherSheet3Id);
         }
 
         if(originalData_.vertex2sheet0_[otherVertexId] != -1) {
-          connect3sheetTo0sheet(originalData_, originalData_.vertex2sheet3_[i],
-                                originalData_.vertex2sheet0_[otherVertexId]);
+          addConnection(
+            0, sheet3Id, originalData_.vertex2sheet0_[otherVertexId]);
         }
 
-        if(originalData_.vertex2sheet3_[otherVertexId] < -1) {
-          SimplexId sheet1Id = -2 - originalData_.vertex2sheet3_[otherVertexId];
-          connect3sheetTo1sheet(
-            originalData_, originalData_.vertex2sheet3_[i], sheet1Id);
+        if(otherSheet3Id < -1) {
+          addConnection(1, sheet3Id, -2 - otherSheet3Id);
         }
       }
     }
   }
 
-  this->printMsg("Sheet connectivity established.");
+  std::vector<std::array<SimplexId, 3>> connections;
+  for(const auto &c : threadConnections) {
+    connections.insert(connections.end(), c.begin(), c.end());
+  }
+  std::sort(connections.begin(), connections.end());
+  connections.erase(
+    std::unique(connections.begin(), connections.end()), connections.end());
+
+  for(const auto &c : connections) {
+    switch(c[0]) {
+      case 0:
+        connect3sheetTo0sheet(originalData_, c[1], c[2]);
+        break;
+      case 1:
+        connect3sheetTo1sheet(originalData_, c[1], c[2]);
+        break;
+      case 2:
+        connect3sheetTo2sheet(originalData_, c[1], c[2]);
+        break;
+      default:
+        connect3sheetTo3sheet(originalData_, c[1], c[2]);
+        break;
+    }
+  }
+
+  this->printMsg("Sheet connectivity established", 1.0, t.getElapsedTime(),
+                 this->threadNumber_);
 
   printConnectivity(std::cout, originalData_);
 
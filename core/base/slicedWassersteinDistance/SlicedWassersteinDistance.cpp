@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cmath>
+
+#include <SlicedWassersteinDistance.h>
+
+ttk::SlicedWassersteinDistance::SlicedWassersteinDistance() {
+  this->setDebugMsgPrefix("SlicedWasserstein");
+}
+
+void ttk::SlicedWassersteinDistance::computeProjections(
+  const std::vector<double> &births,
+  const std::vector<double> &deaths,
+  Projections &projections) const {
+
+  const size_t n = births.size();
+  const size_t nDirs = std::max(this->NumberOfDirections, 1);
+
+  projections.size = n;
+  projections.pairs.resize(nDirs * n);
+  projections.diagonal.resize(nDirs * n);
+
+  // the projections of the pairs onto the diagonal are ordered by their
+  // mid-point, whatever the slicing direction: sort them once
+  std::vector<double> mid(n);
+  for(size_t i = 0; i < n; ++i) {
+    mid[i] = 0.5 * (births[i] + deaths[i]);
+  }
+  std::sort(mid.begin(), mid.end());
+
+  for(size_t k = 0; k < nDirs; ++k) {
+    // directions are evenly spaced in [-pi/2, pi/2]
+    const double theta = M_PI * ((k + 0.5) / nDirs - 0.5);
+    const double c = std::cos(theta);
+    const double s = std::sin(theta);
+
+    double *const pp = projections.pairs.data() + k * n;
+    for(size_t i = 0; i < n; ++i) {
+      pp[i] = c * births[i] + s * deaths[i];
+    }
+    std::sort(pp, pp + n);
+
+    double *const dp = projections.diagonal.data() + k * n;
+    const double cs = c + s;
+    if(cs >= 0) {
+      for(size_t i = 0; i < n; ++i) {
+        dp[i] = cs * mid[i];
+      }
+    } else {
+      for(size_t i = 0; i < n; ++i) {
+        dp[i] = cs * mid[n - 1 - i];
+      }
+    }
+  }
+}
+
+double ttk::SlicedWassersteinDistance::computeDistance(
+  const Projections &proj1, const Projections &proj2) const {
+
+  const size_t n1 = proj1.size;
+  const size_t n2 = proj2.size;
+  const size_t nDirs = std::max(this->NumberOfDirections, 1);
+
+  if(n1 + n2 == 0) {
+    return 0.0;
+  }
+
+  double res{};
+
+  for(size_t k = 0; k < nDirs; ++k) {
+    // first diagram augmented with the diagonal projections of the second
+    const double *const a = proj1.pairs.data() + k * n1;
+    const double *const ad = proj2.diagonal.data() + k * n2;
+    // second diagram augmented with the diagonal projections of the first
+    const double *const b = proj2.pairs.data() + k * n2;
+    const double *const bd = proj1.diagonal.data() + k * n1;
+
+    // merge the sorted sequences on the fly and match them by rank
+    size_t ia{}, iad{}, ib{}, ibd{};
+    double dist{};
+    for(size_t i = 0; i < n1 + n2; ++i) {
+      double va, vb;
+      if(iad >= n2 || (ia < n1 && a[ia] <= ad[iad])) {
+        va = a[ia++];
+      } else {
+        va = ad[iad++];
+      }
+      if(ibd >= n1 || (ib < n2 && b[ib] <= bd[ibd])) {
+        vb = b[ib++];
+      } else {
+        vb = bd[ibd++];
+      }
+      dist += std::abs(va - vb);
+    }
+    res += dist;
+  }
+
+  return res / nDirs;
+}
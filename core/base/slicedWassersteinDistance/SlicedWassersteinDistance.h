@@ -0,0 +1,80 @@
+/// \ingroup base
+/// \class ttk::SlicedWassersteinDistance
+///
+/// \brief TTK processing package for the approximation of the Wasserstein
+/// distance between persistence diagrams with the Sliced Wasserstein distance.
+///
+/// The persistence pairs (and their projections onto the diagonal) are
+/// projected onto a fixed set of lines through the origin. On each line, the
+/// optimal transport between the two resulting point sets reduces to matching
+/// sorted values, which is linear once the projections are sorted.
+///
+/// Projections only depend on one diagram: they are computed (and sorted) once
+/// per diagram with computeProjections() and then re-used for every distance
+/// evaluation.
+///
+/// \b Related \b publication \n
+/// "Sliced Wasserstein Kernel for Persistence Diagrams" \n
+/// Mathieu Carriere, Marco Cuturi and Steve Oudot \n
+/// Proc. of ICML 2017.
+///
+/// \sa PersistenceDiagramDistanceMatrix
+/// \sa PersistenceDiagramClustering
+
+#pragma once
+
+#include <vector>
+
+#include <Debug.h>
+
+namespace ttk {
+
+  class SlicedWassersteinDistance : virtual public Debug {
+
+  public:
+    /// Sorted projections of a persistence diagram onto the slicing
+    /// directions, stored direction after direction.
+    struct Projections {
+      /// number of persistence pairs in the diagram
+      size_t size{};
+      /// sorted projections of the persistence pairs
+      std::vector<double> pairs{};
+      /// sorted projections of the pairs orthogonal projections onto the
+      /// diagonal
+      std::vector<double> diagonal{};
+    };
+
+    SlicedWassersteinDistance();
+
+    /**
+     * @brief Project a persistence diagram onto the slicing directions
+     *
+     * @param[in] births Birth values of the diagram pairs
+     * @param[in] deaths Death values of the diagram pairs
+     * @param[out] projections Sorted projections, per direction
+     */
+    void computeProjections(const std::vector<double> &births,
+                            const std::vector<double> &deaths,
+                            Projections &projections) const;
+
+    /**
+     * @brief Sliced Wasserstein distance between two projected diagrams
+     *
+     * Both projections should have been computed with the same number of
+     * directions.
+     */
+    double computeDistance(const Projections &proj1,
+                           const Projections &proj2) const;
+
+    inline void setNumberOfDirections(const int nDirections) {
+      this->NumberOfDirections = nDirections;
+    }
+    inline int getNumberOfDirections() const {
+      return this->NumberOfDirections;
+    }
+
+  protected:
+    int NumberOfDirections{16};
+  };
+
+} // namespace ttk
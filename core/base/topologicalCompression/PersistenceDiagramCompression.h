@@ -229,6 +229,200 @@ int ttk::TopologicalCompression::ReadPersistenceGeometry(
   return 0;
 }
 
+template <typename dataType, typename triangulationType>
+int ttk::TopologicalCompression::ReadPersistenceBricks(
+  FILE *fm, bool useZlib, const triangulationType &triangulation) {
+
+  int sqMethod = SQMethodInt;
+
+  // 1. Global section: brick size, compressor, temporal reference, segment
+  // values and constraints.
+  const int brickSize = Read<int>(fm);
+  auto codec = useZlib ? LosslessCodec::Zlib : LosslessCodec::None;
+  if(fileFormatVersion_ >= 4) {
+    codec = static_cast<LosslessCodec>(Read<int>(fm));
+  }
+  auto frame = TemporalFrame::None;
+  std::string reference{};
+  if(fileFormatVersion_ >= 5) {
+    frame = static_cast<TemporalFrame>(Read<int>(fm));
+  }
+  if(frame == TemporalFrame::Predicted) {
+    reference.resize(Read<unsigned long>(fm));
+    ReadByteArray(fm, &reference[0], reference.size());
+  }
+  NbSegments = Read<int>(fm);
+
+  std::vector<std::tuple<double, int>> mappingsSortedPerValue;
+
+  double min = 0;
+  double max = 0;
+  int nbConstraints = 0;
+
+  if(!ZFPOnly) {
+    ReadPersistenceIndex(fm, mapping_, mappingsSortedPerValue,
+                         criticalConstraints_, min, max, nbConstraints);
+    this->printMsg("Successfully read geomap.");
+  }
+
+  // 2. Quantized field of the previous timestep, in the region of interest.
+  const bool predicted = frame == TemporalFrame::Predicted;
+  if(predicted) {
+    initDecompressedExtent();
+    const int status = ReadReference(reference, triangulation);
+    if(status != 0) {
+      return status;
+    }
+  }
+
+  // 3. Brick index and payloads intersecting the region of interest.
+  const int status = ReadBricks(fm, codec, brickSize, predicted);
+  if(status != 0) {
+    return status;
+  }
+
+  int dims[3], roiDims[3], roiOrigin[3];
+  for(int i = 0; i < 3; ++i) {
+    dims[i] = 1 + dataExtent_[2 * i + 1] - dataExtent_[2 * i];
+    roiDims[i]
+      = 1 + decompressedExtent_[2 * i + 1] - decompressedExtent_[2 * i];
+    roiOrigin[i] = decompressedExtent_[2 * i] - dataExtent_[2 * i];
+  }
+
+  // reference of the next timestep, indexed on the whole grid as when
+  // writing
+  if(frame != TemporalFrame::None) {
+    referenceData_.assign((size_t)dims[0] * dims[1] * dims[2], 0.0);
+    for(int k = 0; k < roiDims[2]; ++k) {
+      for(int j = 0; j < roiDims[1]; ++j) {
+        const size_t src = (size_t)roiDims[0] * (j + (size_t)roiDims[1] * k);
+        const size_t dst
+          = roiOrigin[0]
+            + (size_t)dims[0]
+                * ((j + roiOrigin[1]) + (size_t)dims[1] * (k + roiOrigin[2]));
+        std::copy(decompressedData_.begin() + src,
+                  decompressedData_.begin() + src + roiDims[0],
+                  referenceData_.begin() + dst);
+      }
+    }
+    referenceFile_ = fileName != nullptr ? fileName : "";
+    referenceExtent_ = decompressedExtent_;
+  }
+  if(referenceOnly_) {
+    return 0;
+  }
+  const int vertexNumber = roiDims[0] * roiDims[1] * roiDims[2];
+  const bool isWholeGrid
+    = vertexNumber == dims[0] * dims[1] * dims[2];
+
+  // 4. Critical constraints inside the region of interest.
+  std::vector<std::tuple<int, double, int>> constraints{};
+  for(const auto &c : criticalConstraints_) {
+    int id = std::get<0>(c);
+    const int x = id % dims[0] - roiOrigin[0];
+    const int y = (id / dims[0]) % dims[1] - roiOrigin[1];
+    const int z = id / (dims[0] * dims[1]) - roiOrigin[2];
+    if(x < 0 || y < 0 || z < 0 || x >= roiDims[0] || y >= roiDims[1]
+       || z >= roiDims[2]) {
+      continue;
+    }
+    id = x + roiDims[0] * (y + roiDims[1] * z);
+    constraints.emplace_back(id, std::get<1>(c), std::get<2>(c));
+  }
+
+  // No SQ.
+  if(sqMethod == 0 || sqMethod == 3) {
+    for(const auto &c : constraints) {
+      decompressedData_[std::get<0>(c)] = std::get<1>(c);
+    }
+  }
+
+  if(min == max) {
+    this->printWrn("Empty scalar field range.");
+  }
+
+  if(sqMethod == 1 || sqMethod == 2)
+    return 0;
+
+  if(ZFPOnly)
+    return 0;
+
+  // 5. Crop whatever doesn't fit in topological intervals.
+  CropIntervals(mapping_, mappingsSortedPerValue, min, max, vertexNumber,
+                decompressedData_.data(), segmentation_);
+  this->printMsg("Successfully cropped bad intervals.");
+
+  // 6. The topological simplification couples the whole domain: it is only
+  // performed when the whole grid is decompressed.
+  if(isWholeGrid) {
+    PerformSimplification<double>(constraints, constraints.size(),
+                                  vertexNumber, decompressedData_.data(),
+                                  triangulation);
+    this->printMsg("Successfully performed simplification.");
+  } else {
+    decompressedOffsets_.clear();
+    this->printMsg("Region of interest, skipped simplification.");
+  }
+
+  return 0;
+}
+
+template <typename triangulationType>
+int ttk::TopologicalCompression::ReadReference(
+  const std::string &name, const triangulationType &triangulation) {
+
+  // the previous timestep is stored in the same directory
+  std::string path = fileName != nullptr ? fileName : "";
+  const auto sep = path.find_last_of("/\\");
+  path = (sep == std::string::npos ? "" : path.substr(0, sep + 1)) + name;
+
+  // already decompressed (sequential read)
+  if(path == referenceFile_ && referenceExtent_ == decompressedExtent_
+     && !referenceData_.empty()) {
+    return 0;
+  }
+  if(fileName != nullptr && path == fileName) {
+    this->printErr("Invalid temporal reference.");
+    return -1;
+  }
+
+  FILE *fp = fopen(path.data(), "rb");
+  if(fp == nullptr) {
+    this->printErr("Could not open the previous timestep " + path + ".");
+    return -1;
+  }
+
+  TopologicalCompression reference{};
+  reference.setThreadNumber(this->threadNumber_);
+  reference.setDebugLevel(this->debugLevel_);
+  reference.setFileName(&path[0]);
+  reference.setRegionOfInterest(decompressedExtent_.data());
+  reference.referenceOnly_ = true;
+  // (the current reference may be the one of the previous timestep)
+  reference.referenceData_ = std::move(referenceData_);
+  reference.referenceFile_ = referenceFile_;
+  reference.referenceExtent_ = referenceExtent_;
+
+  reference.ReadMetaData<double>(fp);
+  const int status = reference.ReadFromFile<double>(fp, triangulation);
+  referenceData_ = std::move(reference.referenceData_);
+  referenceFile_ = reference.referenceFile_;
+  referenceExtent_ = reference.referenceExtent_;
+
+  bool isValid = status == 0 && referenceFile_ == path
+                 && referenceExtent_ == decompressedExtent_;
+  for(int i = 0; i < 6; ++i) {
+    isValid = isValid && reference.dataExtent_[i] == dataExtent_[i];
+  }
+  if(!isValid) {
+    this->printErr("Could not decompress the previous timestep " + path + ".");
+    referenceData_.clear();
+    return -1;
+  }
+
+  return 0;
+}
+
 template <typename dataType, typename triangulationType>
 int ttk::TopologicalCompression::PerformSimplification(
   const std::vector<std::tuple<int, double, int>> &constraints,
@@ -407,6 +601,10 @@ int ttk::TopologicalCompression::compressForPersistenceDiagram(
   ttk::Timer t;
   ttk::Timer t1;
 
+  // (the same object may compress several timesteps)
+  mapping_.clear();
+  criticalConstraints_.clear();
+
   std::vector<SimplexId> inputOffsets(vertexNumber);
   for(int i = 0; i < vertexNumber; ++i)
     inputOffsets[i] = i;
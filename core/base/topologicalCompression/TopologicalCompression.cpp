@@ -6,7 +6,8 @@ ttk::TopologicalCompression::TopologicalCompression() {
 }
 
 const char *ttk::TopologicalCompression::magicBytes_{"TTKCompressedFileFormat"};
-const unsigned long ttk::TopologicalCompression::formatVersion_{1};
+const unsigned long ttk::TopologicalCompression::formatVersion_{5};
+const size_t ttk::TopologicalCompression::ChunkSize;
 
 // Dependencies.
 
@@ -102,6 +103,59 @@ int ttk::TopologicalCompression::CompressWithZFP(FILE *file,
   return (int)zfpsize;
 }
 
+
+int ttk::TopologicalCompression::CompressWithZFP(
+  bool decompress,
+  std::vector<double> &array,
+  int nx,
+  int ny,
+  int nz,
+  double rate,
+  std::vector<unsigned char> &buffer) {
+
+  // bricks may be flat: drop the dimensions of size 1
+  unsigned int n[3] = {1, 1, 1};
+  unsigned int dims = 0;
+  for(const int d : {nx, ny, nz}) {
+    if(d > 1) {
+      n[dims++] = d;
+    }
+  }
+  if(dims == 0) {
+    dims = 1;
+  }
+
+  const zfp_type type = zfp_type_double;
+  zfp_field *field
+    = dims == 1   ? zfp_field_1d(array.data(), type, n[0])
+      : dims == 2 ? zfp_field_2d(array.data(), type, n[0], n[1])
+                  : zfp_field_3d(array.data(), type, n[0], n[1], n[2]);
+
+  zfp_stream *zfp = zfp_stream_open(nullptr);
+  zfp_stream_set_rate(zfp, rate, type, dims, 0);
+
+  if(!decompress) {
+    buffer.resize(zfp_stream_maximum_size(zfp, field));
+  }
+  bitstream *stream = stream_open(buffer.data(), buffer.size());
+  zfp_stream_set_bit_stream(zfp, stream);
+  zfp_stream_rewind(zfp);
+
+  const size_t zfpsize = decompress ? zfp_decompress(zfp, field)
+                                    : zfp_compress(zfp, field);
+  if(!zfpsize) {
+    this->printErr(decompress ? "Decompression failed" : "Compression failed");
+  } else if(!decompress) {
+    buffer.resize(zfpsize);
+  }
+
+  zfp_field_free(field);
+  zfp_stream_close(zfp);
+  stream_close(stream);
+
+  return (int)zfpsize;
+}
+
 #endif
 
 #ifdef TTK_ENABLE_ZLIB
@@ -331,6 +385,11 @@ int ttk::TopologicalCompression::ReadPersistenceIndex(
   int &nbConstraints) {
   int numberOfBytesRead = 0;
 
+  // a reader may be re-used over several files
+  mappings.clear();
+  mappingsSortedPerValue.clear();
+  constraints.clear();
+
   // 1.a. Read mapping.
   int mappingSize;
   numberOfBytesRead += sizeof(int);
@@ -432,3 +491,1114 @@ int ttk::TopologicalCompression::WritePersistenceIndex(
 
   return numberOfBytesWritten;
 }
+
+// Bricked format.
+
+namespace {
+  // copy the sub-extent of a grid (extents relative to the grid)
+  template <typename T>
+  void cropGrid(std::vector<T> &values,
+                const int *dimensions,
+                const std::array<int, 6> &extent) {
+    const int nx = 1 + extent[1] - extent[0];
+    const int ny = 1 + extent[3] - extent[2];
+    const int nz = 1 + extent[5] - extent[4];
+    std::vector<T> cropped((size_t)nx * ny * nz);
+    size_t l = 0;
+    for(int k = extent[4]; k <= extent[5]; ++k) {
+      for(int j = extent[2]; j <= extent[3]; ++j) {
+        const auto row
+          = values.begin()
+            + (extent[0] + (size_t)dimensions[0] * (j + dimensions[1] * k));
+        std::copy(row, row + nx, cropped.begin() + l);
+        l += nx;
+      }
+    }
+    values = std::move(cropped);
+  }
+
+  // Adaptive binary range coder (LZMA style), with 11-bit probabilities.
+  constexpr unsigned int probabilityBits{11};
+  constexpr uint16_t initialProbability{1 << (probabilityBits - 1)};
+  constexpr unsigned int adaptationShift{5};
+  constexpr uint32_t topValue{1 << 24};
+
+  class RangeEncoder {
+  public:
+    explicit RangeEncoder(std::vector<unsigned char> &buffer)
+      : buffer_{buffer} {
+    }
+
+    void encode(uint16_t &probability, const int bit) {
+      const uint32_t bound = (range_ >> probabilityBits) * probability;
+      if(bit == 0) {
+        range_ = bound;
+        probability
+          += ((1 << probabilityBits) - probability) >> adaptationShift;
+      } else {
+        low_ += bound;
+        range_ -= bound;
+        probability -= probability >> adaptationShift;
+      }
+      while(range_ < topValue) {
+        range_ <<= 8;
+        shiftLow();
+      }
+    }
+
+    void flush() {
+      for(int i = 0; i < 5; ++i) {
+        shiftLow();
+      }
+    }
+
+  private:
+    void shiftLow() {
+      // propagate the carry into the pending 0xff bytes
+      if((uint32_t)low_ < 0xff000000u || (low_ >> 32) != 0) {
+        unsigned char byte = cache_;
+        do {
+          buffer_.emplace_back(byte + (unsigned char)(low_ >> 32));
+          byte = 0xff;
+        } while(--cacheSize_ != 0);
+        cache_ = (unsigned char)(low_ >> 24);
+      }
+      cacheSize_++;
+      low_ = (low_ & 0x00ffffffu) << 8;
+    }
+
+    std::vector<unsigned char> &buffer_;
+    uint64_t low_{0};
+    uint32_t range_{0xffffffffu};
+    unsigned char cache_{0};
+    uint64_t cacheSize_{1};
+  };
+
+  class RangeDecoder {
+  public:
+    RangeDecoder(const unsigned char *buffer, const size_t size)
+      : current_{buffer}, end_{buffer + size} {
+      for(int i = 0; i < 5; ++i) {
+        code_ = (code_ << 8) | next();
+      }
+    }
+
+    int decode(uint16_t &probability) {
+      const uint32_t bound = (range_ >> probabilityBits) * probability;
+      int bit;
+      if(code_ < bound) {
+        range_ = bound;
+        probability
+          += ((1 << probabilityBits) - probability) >> adaptationShift;
+        bit = 0;
+      } else {
+        code_ -= bound;
+        range_ -= bound;
+        probability -= probability >> adaptationShift;
+        bit = 1;
+      }
+      while(range_ < topValue) {
+        range_ <<= 8;
+        code_ = (code_ << 8) | next();
+      }
+      return bit;
+    }
+
+    /// false if the decoder read past the end of the stream
+    bool isValid() const {
+      return !overrun_;
+    }
+
+  private:
+    uint32_t next() {
+      if(current_ < end_) {
+        return *current_++;
+      }
+      overrun_ = true;
+      return 0;
+    }
+
+    const unsigned char *current_;
+    const unsigned char *end_;
+    bool overrun_{false};
+    uint32_t range_{0xffffffffu};
+    uint32_t code_{0};
+  };
+
+  // Adaptive probabilities of the segmentation stream.
+  struct SegmentationModel {
+    SegmentationModel() {
+      for(auto &p : candidates) {
+        p.fill(initialProbability);
+      }
+      segmentBits.fill(initialProbability);
+    }
+
+    // segment equal to the first, second or third distinct causal neighbor,
+    // per neighborhood configuration
+    std::array<std::array<uint16_t, 3>, 64> candidates{};
+    // explicit segment bits, per position
+    std::array<uint16_t, 32> segmentBits{};
+  };
+
+  // Distinct segments of the causal neighbors (left, above and front) of a
+  // vertex, and the context of their configuration.
+  inline int getCandidates(const int *segmentation,
+                           const size_t p,
+                           const int x,
+                           const int y,
+                           const int z,
+                           const size_t rowLength,
+                           const size_t sliceLength,
+                           int *candidates,
+                           int &nCandidates) {
+    const bool hasLeft = x > 0, hasAbove = y > 0, hasFront = z > 0;
+    const int left = hasLeft ? segmentation[p - 1] : -1;
+    const int above = hasAbove ? segmentation[p - rowLength] : -1;
+    const int front = hasFront ? segmentation[p - sliceLength] : -1;
+
+    nCandidates = 0;
+    for(const int c : {left, above, front}) {
+      if(c >= 0 && std::find(candidates, candidates + nCandidates, c)
+                     == candidates + nCandidates) {
+        candidates[nCandidates++] = c;
+      }
+    }
+
+    return hasLeft | (hasAbove << 1) | (hasFront << 2)
+           | ((hasLeft && left == above) << 3)
+           | ((hasLeft && left == front) << 4)
+           | ((hasAbove && above == front) << 5);
+  }
+
+  // segment of the closest value, in a mapping sorted by value
+  inline int nearestSegment(const std::vector<std::tuple<double, int>> &mapping,
+                            const double value) {
+    const auto it = std::lower_bound(
+      mapping.begin(), mapping.end(), value,
+      [](const std::tuple<double, int> &a, const double b) {
+        return std::get<0>(a) < b;
+      });
+    if(it == mapping.end()) {
+      return std::get<1>(mapping.back());
+    }
+    if(it != mapping.begin()
+       && value - std::get<0>(*(it - 1)) < std::get<0>(*it) - value) {
+      return std::get<1>(*(it - 1));
+    }
+    return std::get<1>(*it);
+  }
+} // namespace
+
+void ttk::TopologicalCompression::computeBricks(const int *dimensions,
+                                                int brickSize,
+                                                std::vector<Brick> &bricks) {
+  int nb[3];
+  for(int i = 0; i < 3; ++i) {
+    nb[i] = (dimensions[i] + brickSize - 1) / brickSize;
+  }
+
+  bricks.clear();
+  bricks.resize((size_t)nb[0] * nb[1] * nb[2]);
+
+  for(int k = 0; k < nb[2]; ++k) {
+    for(int j = 0; j < nb[1]; ++j) {
+      for(int i = 0; i < nb[0]; ++i) {
+        auto &brick = bricks[i + (size_t)nb[0] * (j + nb[1] * k)];
+        const int b[3] = {i, j, k};
+        for(int d = 0; d < 3; ++d) {
+          brick.extent[2 * d] = b[d] * brickSize;
+          brick.extent[2 * d + 1]
+            = std::min(dimensions[d], (b[d] + 1) * brickSize) - 1;
+        }
+      }
+    }
+  }
+}
+
+size_t ttk::TopologicalCompression::getPackedSegmentationSize(
+  size_t numberOfVertices, int numberOfSegments) {
+  const size_t numberOfBitsPerSegment = log2(numberOfSegments) + 1;
+  return (numberOfVertices * numberOfBitsPerSegment + 7) / 8;
+}
+
+void ttk::TopologicalCompression::PackSegmentation(const int *segmentation,
+                                                   size_t numberOfVertices,
+                                                   int numberOfSegments,
+                                                   unsigned char *buffer) {
+  // same bit width as WriteCompactSegmentation, little-endian bit order
+  const unsigned int numberOfBitsPerSegment = log2(numberOfSegments) + 1;
+  const uint64_t mask = (uint64_t{1} << numberOfBitsPerSegment) - 1;
+
+  uint64_t container = 0;
+  unsigned int nBits = 0;
+  for(size_t i = 0; i < numberOfVertices; ++i) {
+    container |= ((uint64_t)segmentation[i] & mask) << nBits;
+    nBits += numberOfBitsPerSegment;
+    while(nBits >= 8) {
+      *buffer++ = container & 0xff;
+      container >>= 8;
+      nBits -= 8;
+    }
+  }
+  if(nBits > 0) {
+    *buffer = container & 0xff;
+  }
+}
+
+void ttk::TopologicalCompression::UnpackSegmentation(
+  const unsigned char *buffer,
+  size_t numberOfVertices,
+  int numberOfSegments,
+  int *segmentation) {
+  const unsigned int numberOfBitsPerSegment = log2(numberOfSegments) + 1;
+  const uint64_t mask = (uint64_t{1} << numberOfBitsPerSegment) - 1;
+
+  uint64_t container = 0;
+  unsigned int nBits = 0;
+  for(size_t i = 0; i < numberOfVertices; ++i) {
+    while(nBits < numberOfBitsPerSegment) {
+      container |= (uint64_t)(*buffer++) << nBits;
+      nBits += 8;
+    }
+    segmentation[i] = container & mask;
+    container >>= numberOfBitsPerSegment;
+    nBits -= numberOfBitsPerSegment;
+  }
+}
+
+void ttk::TopologicalCompression::EncodeSegmentation(
+  const int *segmentation,
+  const int *dimensions,
+  int numberOfSegments,
+  std::vector<unsigned char> &buffer) {
+
+  const unsigned int numberOfBitsPerSegment = log2(numberOfSegments) + 1;
+  const size_t rowLength = dimensions[0];
+  const size_t sliceLength = rowLength * dimensions[1];
+
+  SegmentationModel model{};
+  RangeEncoder encoder{buffer};
+
+  size_t p = 0;
+  int candidates[3];
+  int nCandidates;
+  for(int z = 0; z < dimensions[2]; ++z) {
+    for(int y = 0; y < dimensions[1]; ++y) {
+      for(int x = 0; x < dimensions[0]; ++x, ++p) {
+        const int segment = segmentation[p];
+        const int context
+          = getCandidates(segmentation, p, x, y, z, rowLength, sliceLength,
+                          candidates, nCandidates);
+        auto &probabilities = model.candidates[context];
+
+        bool predicted = false;
+        for(int i = 0; i < nCandidates && !predicted; ++i) {
+          predicted = segment == candidates[i];
+          encoder.encode(probabilities[i], predicted);
+        }
+        if(!predicted) {
+          for(int i = numberOfBitsPerSegment - 1; i >= 0; --i) {
+            encoder.encode(model.segmentBits[i], (segment >> i) & 1);
+          }
+        }
+      }
+    }
+  }
+
+  encoder.flush();
+}
+
+int ttk::TopologicalCompression::DecodeSegmentation(
+  const unsigned char *buffer,
+  size_t size,
+  const int *dimensions,
+  int numberOfSegments,
+  int *segmentation) {
+
+  const unsigned int numberOfBitsPerSegment = log2(numberOfSegments) + 1;
+  const size_t rowLength = dimensions[0];
+  const size_t sliceLength = rowLength * dimensions[1];
+
+  SegmentationModel model{};
+  RangeDecoder decoder{buffer, size};
+
+  size_t p = 0;
+  int candidates[3];
+  int nCandidates;
+  for(int z = 0; z < dimensions[2]; ++z) {
+    for(int y = 0; y < dimensions[1]; ++y) {
+      for(int x = 0; x < dimensions[0]; ++x, ++p) {
+        const int context
+          = getCandidates(segmentation, p, x, y, z, rowLength, sliceLength,
+                          candidates, nCandidates);
+        auto &probabilities = model.candidates[context];
+
+        int segment = -1;
+        for(int i = 0; i < nCandidates && segment < 0; ++i) {
+          if(decoder.decode(probabilities[i]) == 1) {
+            segment = candidates[i];
+          }
+        }
+        if(segment < 0) {
+          segment = 0;
+          for(int i = numberOfBitsPerSegment - 1; i >= 0; --i) {
+            segment |= decoder.decode(model.segmentBits[i]) << i;
+          }
+        }
+        segmentation[p] = segment;
+      }
+    }
+  }
+
+  return decoder.isValid() ? 0 : -1;
+}
+
+int ttk::TopologicalCompression::CompressChunk(
+  const LosslessCodec codec,
+  const std::vector<unsigned char> &source,
+  std::vector<unsigned char> &dest) {
+
+  switch(codec) {
+    case LosslessCodec::None:
+      dest = source;
+      return 0;
+#ifdef TTK_ENABLE_ZLIB
+    case LosslessCodec::Zlib: {
+      uLongf destLen = compressBound(source.size());
+      dest.resize(destLen);
+      const auto status
+        = compress(dest.data(), &destLen, source.data(), source.size());
+      dest.resize(destLen);
+      return status == Z_OK ? 0 : -1;
+    }
+#endif // TTK_ENABLE_ZLIB
+#ifdef TTK_ENABLE_ZSTD
+    case LosslessCodec::Zstd: {
+      dest.resize(ZSTD_compressBound(source.size()));
+      const auto destLen = ZSTD_compress(dest.data(), dest.size(),
+                                         source.data(), source.size(), 3);
+      if(ZSTD_isError(destLen)) {
+        return -1;
+      }
+      dest.resize(destLen);
+      return 0;
+    }
+#endif // TTK_ENABLE_ZSTD
+    default:
+      return -2;
+  }
+}
+
+int ttk::TopologicalCompression::DecompressChunk(
+  const LosslessCodec codec,
+  const std::vector<unsigned char> &source,
+  std::vector<unsigned char> &dest) {
+
+  switch(codec) {
+    case LosslessCodec::None:
+      if(source.size() != dest.size()) {
+        return -1;
+      }
+      std::copy(source.begin(), source.end(), dest.begin());
+      return 0;
+#ifdef TTK_ENABLE_ZLIB
+    case LosslessCodec::Zlib: {
+      uLongf destLen = dest.size();
+      const auto status
+        = uncompress(dest.data(), &destLen, source.data(), source.size());
+      return status == Z_OK && destLen == dest.size() ? 0 : -1;
+    }
+#endif // TTK_ENABLE_ZLIB
+#ifdef TTK_ENABLE_ZSTD
+    case LosslessCodec::Zstd: {
+      const auto destLen = ZSTD_decompress(
+        dest.data(), dest.size(), source.data(), source.size());
+      return !ZSTD_isError(destLen) && destLen == dest.size() ? 0 : -1;
+    }
+#endif // TTK_ENABLE_ZSTD
+    default:
+      return -2;
+  }
+}
+
+#ifdef TTK_ENABLE_ZLIB
+
+int ttk::TopologicalCompression::DeflateStream(FILE *source,
+                                               unsigned long sourceLen,
+                                               FILE *dest,
+                                               unsigned long &destLen) {
+  z_stream stream{};
+  if(deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    return -1;
+  }
+
+  std::vector<unsigned char> in(ChunkSize), out(ChunkSize);
+  destLen = 0;
+  int status = Z_OK;
+  do {
+    const size_t inLen = std::min<unsigned long>(sourceLen, ChunkSize);
+    if(inLen > 0) {
+      ReadByteArray(source, in.data(), inLen);
+    }
+    sourceLen -= inLen;
+    stream.next_in = in.data();
+    stream.avail_in = inLen;
+    const int flush = sourceLen == 0 ? Z_FINISH : Z_NO_FLUSH;
+    do {
+      stream.next_out = out.data();
+      stream.avail_out = ChunkSize;
+      status = deflate(&stream, flush);
+      const size_t outLen = ChunkSize - stream.avail_out;
+      if(outLen > 0) {
+        WriteByteArray(dest, out.data(), outLen);
+      }
+      destLen += outLen;
+    } while(stream.avail_out == 0);
+  } while(status != Z_STREAM_END && status != Z_STREAM_ERROR);
+
+  deflateEnd(&stream);
+  return status == Z_STREAM_END ? 0 : -1;
+}
+
+int ttk::TopologicalCompression::InflateStream(FILE *source,
+                                               unsigned long sourceLen,
+                                               FILE *dest) {
+  z_stream stream{};
+  if(inflateInit(&stream) != Z_OK) {
+    return -1;
+  }
+
+  std::vector<unsigned char> in(ChunkSize), out(ChunkSize);
+  int status = Z_OK;
+  while(status != Z_STREAM_END && sourceLen > 0) {
+    const size_t inLen = std::min<unsigned long>(sourceLen, ChunkSize);
+    ReadByteArray(source, in.data(), inLen);
+    sourceLen -= inLen;
+    stream.next_in = in.data();
+    stream.avail_in = inLen;
+    do {
+      stream.next_out = out.data();
+      stream.avail_out = ChunkSize;
+      status = inflate(&stream, Z_NO_FLUSH);
+      if(status != Z_OK && status != Z_STREAM_END) {
+        inflateEnd(&stream);
+        return -1;
+      }
+      const size_t outLen = ChunkSize - stream.avail_out;
+      if(outLen > 0) {
+        WriteByteArray(dest, out.data(), outLen);
+      }
+    } while(stream.avail_out == 0);
+  }
+
+  inflateEnd(&stream);
+  return status == Z_STREAM_END ? 0 : -1;
+}
+
+#endif // TTK_ENABLE_ZLIB
+
+void ttk::TopologicalCompression::CopyStream(FILE *source,
+                                             unsigned long length,
+                                             FILE *dest) {
+  std::vector<unsigned char> chunk(std::min<unsigned long>(length, ChunkSize));
+  while(length > 0) {
+    const size_t len = std::min<unsigned long>(length, ChunkSize);
+    ReadByteArray(source, chunk.data(), len);
+    WriteByteArray(dest, chunk.data(), len);
+    length -= len;
+  }
+}
+
+int ttk::TopologicalCompression::EncodeBrick(
+  Brick &brick,
+  const int *dimensions,
+  const LosslessCodec codec,
+  bool zfpOnly,
+  double zfpBitBudget,
+  const double *data,
+  const int *gridSegmentation,
+  std::vector<unsigned char> &payload) {
+
+  const auto &e = brick.extent;
+  const int bx = 1 + e[1] - e[0];
+  const int by = 1 + e[3] - e[2];
+  const int bz = 1 + e[5] - e[4];
+  const size_t n = (size_t)bx * by * bz;
+  const int nbSegments = getNbSegments();
+
+  // brick vertex identifiers, in the grid
+  std::vector<size_t> ids(n);
+  size_t l = 0;
+  for(int k = e[4]; k <= e[5]; ++k) {
+    for(int j = e[2]; j <= e[3]; ++j) {
+      for(int i = e[0]; i <= e[1]; ++i) {
+        ids[l++] = i + (size_t)dimensions[0] * (j + (size_t)dimensions[1] * k);
+      }
+    }
+  }
+
+  std::vector<unsigned char> zfpBuffer{};
+#ifdef TTK_ENABLE_ZFP
+  if(zfpBitBudget >= 1 && zfpBitBudget <= 64) {
+    std::vector<double> values(n);
+    for(size_t i = 0; i < n; ++i) {
+      values[i] = data[ids[i]];
+    }
+    if(CompressWithZFP(false, values, bx, by, bz, zfpBitBudget, zfpBuffer)
+       == 0) {
+      return -1;
+    }
+  }
+#else
+  // the values are only stored through ZFP
+  (void)zfpBitBudget;
+  (void)data;
+#endif // TTK_ENABLE_ZFP
+
+  std::vector<int> segmentation{};
+  std::vector<unsigned char> raw{};
+  if(!zfpOnly) {
+    segmentation.resize(n);
+    for(size_t i = 0; i < n; ++i) {
+      segmentation[i] = gridSegmentation[ids[i]];
+    }
+    raw.resize(getPackedSegmentationSize(n, nbSegments));
+    PackSegmentation(segmentation.data(), n, nbSegments, raw.data());
+  }
+  raw.insert(raw.end(), zfpBuffer.begin(), zfpBuffer.end());
+
+  brick.codec = SegmentationCodec::Packed;
+  brick.rawSize = raw.size();
+  if(CompressChunk(codec, raw, payload) != 0) {
+    return -1;
+  }
+
+  if(!zfpOnly) {
+    // range coded segmentation (size, stream), then the ZFP block,
+    // kept if smaller than the compressed bit packing
+    std::vector<unsigned char> coded(sizeof(unsigned int));
+    const int brickDimensions[3] = {bx, by, bz};
+    EncodeSegmentation(
+      segmentation.data(), brickDimensions, nbSegments, coded);
+    const unsigned int codedSize = coded.size() - sizeof(unsigned int);
+    std::memcpy(coded.data(), &codedSize, sizeof(unsigned int));
+    coded.insert(coded.end(), zfpBuffer.begin(), zfpBuffer.end());
+    if(coded.size() < payload.size()) {
+      brick.codec = SegmentationCodec::RangeCoded;
+      brick.rawSize = coded.size();
+      payload = std::move(coded);
+    }
+  }
+
+  brick.compressedSize = payload.size();
+
+  return 0;
+}
+
+std::string ttk::TopologicalCompression::PredictSegmentation(
+  const int *dataExtent, const double *data, std::vector<int> &segmentation) {
+
+  Timer t;
+
+  const std::string file = fileName != nullptr ? fileName : "";
+  const size_t vertexNumber = NbVertices;
+  const int nbSegments = getNbSegments();
+
+  // the previous timestep must have been written to another file, on the
+  // same grid
+  bool isKeyFrame = referenceFile_.empty() || referenceFile_ == file
+                    || referenceData_.size() != vertexNumber
+                    || (KeyFrameInterval > 0
+                        && framesSinceKeyFrame_ + 1 >= KeyFrameInterval);
+  for(int i = 0; i < 6; ++i) {
+    isKeyFrame = isKeyFrame || referenceExtent_[i] != dataExtent[i];
+  }
+
+  // quantized field of the timestep, as decompressed before the
+  // topological reconstruction
+  // (sorted as when read)
+  auto mapping = mapping_;
+  std::sort(mapping.begin(), mapping.end(), cmp);
+  std::vector<double> quantized(vertexNumber);
+  std::vector<char> isMapped(vertexNumber);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < vertexNumber; ++i) {
+    const auto it
+      = std::lower_bound(mapping.begin(), mapping.end(),
+                         std::make_tuple(0.0, segmentation_[i]), cmp);
+    isMapped[i] = it != mapping.end() && std::get<1>(*it) == segmentation_[i];
+    quantized[i] = isMapped[i] ? std::get<0>(*it) : 0.0;
+  }
+
+  std::string reference{};
+  if(!isKeyFrame) {
+    // residual quantization: the vertices whose input value is within the
+    // quantization error of the timestep from the previous quantized value
+    // keep the previous one (encoded as the extra segment nbSegments), so
+    // that the error bound of the quantizer still holds
+    double maxError = 0.0;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(max : maxError)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < vertexNumber; ++i) {
+      if(isMapped[i]) {
+        maxError = std::max(maxError, std::abs(data[i] - quantized[i]));
+      }
+    }
+    segmentation.resize(vertexNumber);
+    size_t nPredicted = 0;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(+ : nPredicted)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < vertexNumber; ++i) {
+      if(isMapped[i] && std::abs(data[i] - referenceData_[i]) <= maxError) {
+        segmentation[i] = nbSegments;
+        quantized[i] = referenceData_[i];
+        nPredicted++;
+      } else {
+        segmentation[i] = segmentation_[i];
+      }
+    }
+
+    const auto sep = referenceFile_.find_last_of("/\\");
+    reference = sep == std::string::npos ? referenceFile_
+                                         : referenceFile_.substr(sep + 1);
+    this->printMsg("Predicted " + std::to_string(nPredicted) + "/"
+                     + std::to_string(vertexNumber)
+                     + " vertices from the previous timestep",
+                   1.0, t.getElapsedTime(), this->threadNumber_);
+  }
+
+  referenceData_ = std::move(quantized);
+  referenceFile_ = file;
+  std::copy(dataExtent, dataExtent + 6, referenceExtent_.begin());
+  framesSinceKeyFrame_ = isKeyFrame ? 0 : framesSinceKeyFrame_ + 1;
+
+  return reference;
+}
+
+int ttk::TopologicalCompression::WriteBricks(FILE *fp,
+                                             const int *dataExtent,
+                                             bool zfpOnly,
+                                             double zfpBitBudget,
+                                             const double *data) {
+  Timer t;
+
+  const bool useZFP = zfpBitBudget >= 1 && zfpBitBudget <= 64;
+#ifndef TTK_ENABLE_ZFP
+  if(useZFP) {
+    this->printErr("Attempted to write with ZFP but ZFP is not installed.");
+    return -5;
+  }
+#endif // TTK_ENABLE_ZFP
+
+  const int nbSegments = zfpOnly ? 0 : getNbSegments();
+  if(!zfpOnly && nbSegments < 1) {
+    this->printErr("Empty segmentation.");
+    return -1;
+  }
+
+  // best lossless compressor available
+#if defined(TTK_ENABLE_ZSTD)
+  const auto codec = LosslessCodec::Zstd;
+#elif defined(TTK_ENABLE_ZLIB)
+  const auto codec = LosslessCodec::Zlib;
+#else
+  const auto codec = LosslessCodec::None;
+#endif
+
+  int dims[3];
+  for(int i = 0; i < 3; ++i) {
+    dims[i] = 1 + dataExtent[2 * i + 1] - dataExtent[2 * i];
+  }
+
+  // temporal prediction, not compatible with the lossy ZFP values
+  std::vector<int> predicted{};
+  std::string reference{};
+  auto frame = TemporalFrame::None;
+  if(TemporalMode && !zfpOnly && !useZFP) {
+    reference = PredictSegmentation(dataExtent, data, predicted);
+    frame = reference.empty() ? TemporalFrame::Key : TemporalFrame::Predicted;
+  }
+  const int *segmentation
+    = reference.empty() ? segmentation_.data() : predicted.data();
+
+  // 1. Global section: brick size, compressor, temporal reference, segment
+  // values and constraints.
+  Write(fp, BrickSize);
+  Write(fp, static_cast<int>(codec));
+  Write(fp, static_cast<int>(frame));
+  if(frame == TemporalFrame::Predicted) {
+    Write<unsigned long>(fp, reference.size());
+    WriteByteArray(fp, reference.c_str(), reference.size());
+  }
+  Write(fp, nbSegments);
+  if(!zfpOnly) {
+    WritePersistenceIndex(fp, mapping_, criticalConstraints_);
+  }
+
+  // 2. Brick index, filled once the bricks are written.
+  std::vector<Brick> bricks{};
+  computeBricks(dims, BrickSize, bricks);
+  const auto nBricks = bricks.size();
+  Write(fp, (int)nBricks);
+  fpos_t indexPosition;
+  fgetpos(fp, &indexPosition);
+  for(const auto &brick : bricks) {
+    Write(fp, brick.compressedSize);
+    Write(fp, brick.rawSize);
+    Write(fp, static_cast<int>(brick.codec));
+  }
+
+  // 3. Compress the bricks independently, by batches to bound the memory
+  // footprint, and write their payloads.
+  const size_t batchSize = std::max(4 * this->threadNumber_, 1);
+  std::vector<std::vector<unsigned char>> payloads(batchSize);
+  unsigned long offset = 0;
+  int nFailures = 0;
+
+  for(size_t begin = 0; begin < nBricks; begin += batchSize) {
+    const size_t end = std::min(begin + batchSize, nBricks);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_) \
+  reduction(+ : nFailures)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t b = begin; b < end; ++b) {
+      if(EncodeBrick(bricks[b], dims, codec, zfpOnly, zfpBitBudget, data,
+                     segmentation, payloads[b - begin])
+         != 0) {
+        nFailures++;
+      }
+    }
+
+    for(size_t b = begin; b < end; ++b) {
+      bricks[b].offset = offset;
+      offset += bricks[b].compressedSize;
+      const auto &payload = payloads[b - begin];
+      WriteByteArray(fp, payload.data(), payload.size());
+    }
+  }
+
+  if(nFailures > 0) {
+    this->printErr("Could not compress " + std::to_string(nFailures)
+                   + " brick(s).");
+    return -1;
+  }
+
+  // 4. Fill the brick index.
+  fsetpos(fp, &indexPosition);
+  size_t nRangeCoded = 0;
+  for(const auto &brick : bricks) {
+    Write(fp, brick.compressedSize);
+    Write(fp, brick.rawSize);
+    Write(fp, static_cast<int>(brick.codec));
+    nRangeCoded += brick.codec == SegmentationCodec::RangeCoded;
+  }
+  fseek(fp, 0, SEEK_END);
+
+  this->printMsg("Compressed " + std::to_string(nBricks) + " bricks ("
+                   + std::to_string(nRangeCoded) + " range coded)",
+                 1.0, t.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+void ttk::TopologicalCompression::initDecompressedExtent() {
+  for(int i = 0; i < 6; ++i) {
+    decompressedExtent_[i] = dataExtent_[i];
+  }
+  if(!hasRegionOfInterest_) {
+    return;
+  }
+
+  std::array<int, 6> roi{};
+  for(int i = 0; i < 3; ++i) {
+    roi[2 * i] = std::max(dataExtent_[2 * i], regionOfInterest_[2 * i]);
+    roi[2 * i + 1]
+      = std::min(dataExtent_[2 * i + 1], regionOfInterest_[2 * i + 1]);
+    if(roi[2 * i] > roi[2 * i + 1]) {
+      this->printWrn("Empty region of interest, decompressing everything.");
+      return;
+    }
+  }
+  decompressedExtent_ = roi;
+}
+
+int ttk::TopologicalCompression::DecodeBrick(
+  const Brick &brick,
+  const int *dimensions,
+  const LosslessCodec codec,
+  const std::array<int, 6> &roi,
+  const std::vector<unsigned char> &payload,
+  const std::vector<std::tuple<double, int>> *valueMapping,
+  int &nMisses) {
+
+  const auto &e = brick.extent;
+  const int bx = 1 + e[1] - e[0];
+  const int by = 1 + e[3] - e[2];
+  const int bz = 1 + e[5] - e[4];
+  const size_t n = (size_t)bx * by * bz;
+  const int nbSegments = getNbSegments();
+
+  // (range coded bricks are not compressed)
+  std::vector<unsigned char> raw(brick.rawSize);
+  if(DecompressChunk(brick.codec == SegmentationCodec::Packed
+                       ? codec
+                       : LosslessCodec::None,
+                     payload, raw)
+     != 0) {
+    return -1;
+  }
+
+  std::vector<int> segmentation{};
+  size_t segmentationSize = 0;
+  if(!ZFPOnly && brick.codec == SegmentationCodec::RangeCoded) {
+    const int brickDimensions[3] = {bx, by, bz};
+    unsigned int codedSize = 0;
+    if(raw.size() >= sizeof(unsigned int)) {
+      std::memcpy(&codedSize, raw.data(), sizeof(unsigned int));
+    }
+    segmentationSize = sizeof(unsigned int) + codedSize;
+    segmentation.resize(n);
+    if(segmentationSize > raw.size()
+       || DecodeSegmentation(raw.data() + sizeof(unsigned int), codedSize,
+                             brickDimensions, nbSegments, segmentation.data())
+            != 0) {
+      return -1;
+    }
+  } else if(!ZFPOnly) {
+    segmentationSize = getPackedSegmentationSize(n, nbSegments);
+    if(segmentationSize > raw.size()) {
+      return -1;
+    }
+    segmentation.resize(n);
+    UnpackSegmentation(raw.data(), n, nbSegments, segmentation.data());
+  }
+
+  std::vector<double> values(n);
+  if(ZFPBitBudget >= 1 && ZFPBitBudget <= 64) {
+#ifdef TTK_ENABLE_ZFP
+    std::vector<unsigned char> zfpBuffer(
+      raw.begin() + segmentationSize, raw.end());
+    if(CompressWithZFP(true, values, bx, by, bz, ZFPBitBudget, zfpBuffer)
+       == 0) {
+      return -1;
+    }
+#endif // TTK_ENABLE_ZFP
+  } else {
+    // Affect values to points thanks to topology indices.
+    for(size_t i = 0; i < n; ++i) {
+      if(valueMapping != nullptr && segmentation[i] == nbSegments) {
+        continue; // predicted from the previous timestep
+      }
+      const auto it
+        = std::lower_bound(mapping_.begin(), mapping_.end(),
+                           std::make_tuple(0.0, segmentation[i]), cmp);
+      if(it != mapping_.end() && std::get<1>(*it) == segmentation[i]) {
+        values[i] = std::get<0>(*it);
+      } else {
+        nMisses++;
+      }
+    }
+  }
+
+  // copy the intersection with the region of interest
+  const int roiDims[2] = {1 + roi[1] - roi[0], 1 + roi[3] - roi[2]};
+  for(int k = std::max(e[4], roi[4]); k <= std::min(e[5], roi[5]); ++k) {
+    for(int j = std::max(e[2], roi[2]); j <= std::min(e[3], roi[3]); ++j) {
+      for(int i = std::max(e[0], roi[0]); i <= std::min(e[1], roi[1]); ++i) {
+        const size_t src
+          = (i - e[0]) + (size_t)bx * ((j - e[2]) + by * (k - e[4]));
+        const size_t dst
+          = (i - roi[0])
+            + (size_t)roiDims[0] * ((j - roi[2]) + roiDims[1] * (k - roi[4]));
+        if(valueMapping != nullptr && segmentation[src] == nbSegments) {
+          // (the reference is stored on the whole grid)
+          const size_t vertexId
+            = i + (size_t)dimensions[0] * (j + (size_t)dimensions[1] * k);
+          decompressedData_[dst] = referenceData_[vertexId];
+          segmentation_[dst]
+            = nearestSegment(*valueMapping, referenceData_[vertexId]);
+          continue;
+        }
+        decompressedData_[dst] = values[src];
+        if(!ZFPOnly) {
+          segmentation_[dst] = segmentation[src];
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+int ttk::TopologicalCompression::ReadBricks(FILE *fp,
+                                            const LosslessCodec codec,
+                                            int brickSize,
+                                            bool predicted) {
+  Timer t;
+
+  std::vector<unsigned char> test{};
+  if(CompressChunk(codec, test, test) == -2) {
+    this->printErr("File compressed with an unavailable library! Aborting.");
+    return -4;
+  }
+
+  const bool useZFP = ZFPBitBudget >= 1 && ZFPBitBudget <= 64;
+#ifndef TTK_ENABLE_ZFP
+  if(useZFP) {
+    this->printErr(
+      "Attempted to read with ZFP a ZFP block but ZFP is not installed.");
+    return -5;
+  }
+#endif // TTK_ENABLE_ZFP
+
+  const int nbSegments = getNbSegments();
+  if(brickSize < 1 || (!ZFPOnly && nbSegments < 1)) {
+    this->printErr("Invalid brick header.");
+    return -1;
+  }
+
+  // region of interest, relative to the data extent
+  initDecompressedExtent();
+  int dims[3], roiDims[3];
+  std::array<int, 6> roi{};
+  for(int i = 0; i < 3; ++i) {
+    dims[i] = 1 + dataExtent_[2 * i + 1] - dataExtent_[2 * i];
+    roi[2 * i] = decompressedExtent_[2 * i] - dataExtent_[2 * i];
+    roi[2 * i + 1] = decompressedExtent_[2 * i + 1] - dataExtent_[2 * i];
+    roiDims[i] = 1 + roi[2 * i + 1] - roi[2 * i];
+  }
+
+  // 1. Brick index.
+  std::vector<Brick> bricks{};
+  computeBricks(dims, brickSize, bricks);
+  const int nBricks = Read<int>(fp);
+  if(nBricks != (int)bricks.size()) {
+    this->printErr("Invalid brick index.");
+    return -1;
+  }
+  unsigned long offset = 0;
+  for(auto &brick : bricks) {
+    brick.offset = offset;
+    brick.compressedSize = Read<unsigned long>(fp);
+    brick.rawSize = Read<unsigned long>(fp);
+    if(fileFormatVersion_ >= 3) {
+      brick.codec = static_cast<SegmentationCodec>(Read<int>(fp));
+    }
+    offset += brick.compressedSize;
+  }
+
+  // 2. Only the bricks intersecting the region are read.
+  std::vector<size_t> selected{};
+  for(int b = 0; b < nBricks; ++b) {
+    const auto &e = bricks[b].extent;
+    bool intersects = true;
+    for(int i = 0; i < 3; ++i) {
+      intersects = intersects && e[2 * i] <= roi[2 * i + 1]
+                   && e[2 * i + 1] >= roi[2 * i];
+    }
+    if(intersects) {
+      selected.emplace_back(b);
+    }
+  }
+
+  const size_t vertexNumber = (size_t)roiDims[0] * roiDims[1] * roiDims[2];
+  decompressedData_.resize(vertexNumber);
+  segmentation_.resize(ZFPOnly ? 0 : vertexNumber);
+
+  // segments of the values predicted from the previous timestep
+  std::vector<std::tuple<double, int>> valueMapping{};
+  if(predicted) {
+    if(referenceData_.size() != (size_t)dims[0] * dims[1] * dims[2]
+       || mapping_.empty()) {
+      this->printErr("Missing previous timestep.");
+      return -1;
+    }
+    valueMapping = mapping_;
+    std::sort(valueMapping.begin(), valueMapping.end());
+  }
+
+  // 3. Read and decompress the selected bricks by batches, to bound the
+  // memory footprint.
+  const size_t batchSize = std::max(4 * this->threadNumber_, 1);
+  std::vector<std::vector<unsigned char>> payloads(batchSize);
+  unsigned long position = 0;
+  int nFailures = 0;
+  int nMisses = 0;
+
+  for(size_t begin = 0; begin < selected.size(); begin += batchSize) {
+    const size_t end = std::min(begin + batchSize, selected.size());
+
+    for(size_t s = begin; s < end; ++s) {
+      const auto &brick = bricks[selected[s]];
+      if(brick.offset != position) {
+        fseek(fp, (long)(brick.offset - position), SEEK_CUR);
+      }
+      payloads[s - begin].resize(brick.compressedSize);
+      ReadByteArray(fp, payloads[s - begin].data(), brick.compressedSize);
+      position = brick.offset + brick.compressedSize;
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(threadNumber_) \
+  reduction(+ : nFailures, nMisses)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t s = begin; s < end; ++s) {
+      if(DecodeBrick(bricks[selected[s]], dims, codec, roi, payloads[s - begin],
+                     predicted ? &valueMapping : nullptr, nMisses)
+         != 0) {
+        nFailures++;
+      }
+    }
+  }
+
+  // leave the file after the last payload
+  fseek(fp, (long)(offset - position), SEEK_CUR);
+
+  if(nMisses > 0) {
+    this->printErr("Could not find the index of " + std::to_string(nMisses)
+                   + " vertices.");
+  }
+  if(nFailures > 0) {
+    this->printErr("Could not decompress " + std::to_string(nFailures)
+                   + " brick(s).");
+    return -1;
+  }
+
+  this->printMsg("Decompressed " + std::to_string(selected.size()) + "/"
+                   + std::to_string(nBricks) + " bricks",
+                 1.0, t.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+void ttk::TopologicalCompression::CropRegionOfInterest() {
+  initDecompressedExtent();
+
+  int dims[3];
+  std::array<int, 6> roi{};
+  bool isWholeGrid = true;
+  for(int i = 0; i < 3; ++i) {
+    dims[i] = 1 + dataExtent_[2 * i + 1] - dataExtent_[2 * i];
+    roi[2 * i] = decompressedExtent_[2 * i] - dataExtent_[2 * i];
+    roi[2 * i + 1] = decompressedExtent_[2 * i + 1] - dataExtent_[2 * i];
+    isWholeGrid
+      = isWholeGrid && roi[2 * i] == 0 && roi[2 * i + 1] == dims[i] - 1;
+  }
+  if(isWholeGrid) {
+    return;
+  }
+
+  const size_t vertexNumber = (size_t)dims[0] * dims[1] * dims[2];
+  if(decompressedData_.size() == vertexNumber) {
+    cropGrid(decompressedData_, dims, roi);
+  }
+  if(decompressedOffsets_.size() == vertexNumber) {
+    cropGrid(decompressedOffsets_, dims, roi);
+  }
+}
@@ -8,6 +8,21 @@
 /// %TopologicalCompression is a TTK processing package that takes a scalar
 /// field on the input and produces a scalar field on the output.
 ///
+/// Since version 2 of the file format, the grid is split into bricks of
+/// BrickSize^3 vertices that are compressed independently and in parallel.
+/// The brick index stored in the file header allows to decompress only the
+/// bricks intersecting a region of interest (see setRegionOfInterest()).
+/// Since version 3, the segmentation of each brick is either bit-packed and
+/// compressed with zlib, or predicted from its neighbors and range coded,
+/// whichever is the smallest.
+/// Since version 4, the lossless compressor of the bricks (zlib or zstd, if
+/// available at build time) is stored in the header. Bricks are compressed
+/// and decompressed by batches, so that the memory footprint is bounded by a
+/// few bricks per thread.
+/// Since version 5, a sequence of timesteps can be compressed in temporal
+/// mode (see setTemporalMode()): each timestep is then encoded relative to
+/// the previous decompressed one, stored in another file.
+///
 /// \sa ttk::Triangulation
 /// \sa vtkTopologicalCompression.cpp %for a usage example.
 
@@ -20,7 +35,9 @@
 
 // std
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -31,6 +48,10 @@
 #include <zlib.h>
 #endif
 
+#ifdef TTK_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
 #ifdef TTK_ENABLE_ZFP
 #ifndef __cplusplus
 #define __cplusplus 201112L
@@ -108,6 +129,45 @@ namespace ttk {
     inline void setFileName(char *fn) {
       fileName = fn;
     }
+    inline void setBrickSize(const int data) {
+      BrickSize = data;
+    }
+    /**
+     * @brief Encode each timestep relative to the previously written one
+     *
+     * The vertices whose value differs from the quantized one of the
+     * previous timestep by less than the quantization error of the
+     * timestep keep the previous value, which is then encoded with a
+     * single symbol. The
+     * persistence pairs above the tolerance are still enforced by the
+     * topological reconstruction of each timestep. Only applies to the
+     * bricked format without ZFP.
+     */
+    inline void setTemporalMode(const bool data) {
+      TemporalMode = data;
+    }
+    /// Number of timesteps between two independently encoded timesteps (0
+    /// only encodes independently the first one)
+    inline void setKeyFrameInterval(const int data) {
+      KeyFrameInterval = data;
+    }
+    /// Encode independently the next timestep
+    inline void resetTemporalReference() {
+      referenceData_.clear();
+      referenceFile_.clear();
+    }
+    /**
+     * @brief Restrict the decompression to a sub-extent of the data extent
+     *
+     * Only the bricks intersecting this extent are decompressed. A nullptr
+     * (the default) decompresses the whole grid.
+     */
+    inline void setRegionOfInterest(const int *extent) {
+      hasRegionOfInterest_ = extent != nullptr;
+      if(extent != nullptr) {
+        std::copy(extent, extent + 6, regionOfInterest_.begin());
+      }
+    }
     inline void
       preconditionTriangulation(AbstractTriangulation *const triangulation) {
       if(triangulation != nullptr) {
@@ -173,6 +233,13 @@ namespace ttk {
     inline std::vector<int> &getCompressedOffsets() {
       return compressedOffsets_;
     }
+    /// Extent of the decompressed data (data extent or region of interest)
+    inline const std::array<int, 6> &getDecompressedExtent() const {
+      return decompressedExtent_;
+    }
+    inline unsigned long getFileFormatVersion() const {
+      return fileFormatVersion_;
+    }
 
     // IO management.
     static unsigned int log2(int val);
@@ -266,7 +333,8 @@ namespace ttk {
                       double *dataOrigin,
                       double tolerance,
                       double zfpBitBudget,
-                      const std::string &dataArrayName);
+                      const std::string &dataArrayName,
+                      unsigned long formatVersion = formatVersion_);
     template <typename T>
     int WriteToFile(FILE *fp,
                     int compressionType,
@@ -291,6 +359,119 @@ namespace ttk {
       double *array,
       std::vector<int> &Seg);
 
+    // Bricked format (version 2).
+
+    /// Encoding of the segmentation of a brick
+    enum class SegmentationCodec {
+      /// fixed-width bit packing, losslessly compressed
+      Packed = 0,
+      /// prediction from the neighbor segments, compressed with an adaptive
+      /// binary range coder
+      RangeCoded = 1
+    };
+
+    /// Lossless compressor of the packed bricks (version 4)
+    enum class LosslessCodec { None = 0, Zlib = 1, Zstd = 2 };
+
+    /// Temporal encoding of a timestep (version 5)
+    enum class TemporalFrame {
+      /// not part of a sequence
+      None = 0,
+      /// first timestep, or encoded independently
+      Key = 1,
+      /// encoded relative to the previous timestep
+      Predicted = 2
+    };
+
+    /// Independently compressed sub-grid
+    struct Brick {
+      /// vertex extent, relative to the data extent
+      std::array<int, 6> extent{};
+      /// offset of the payload from the first brick payload in the file
+      unsigned long offset{};
+      /// size of the payload in the file
+      unsigned long compressedSize{};
+      /// size of the uncompressed payload
+      unsigned long rawSize{};
+      SegmentationCodec codec{SegmentationCodec::Packed};
+    };
+
+    static void computeBricks(const int *dimensions,
+                              int brickSize,
+                              std::vector<Brick> &bricks);
+    static size_t
+      getPackedSegmentationSize(size_t numberOfVertices, int numberOfSegments);
+    static void PackSegmentation(const int *segmentation,
+                                 size_t numberOfVertices,
+                                 int numberOfSegments,
+                                 unsigned char *buffer);
+    static void UnpackSegmentation(const unsigned char *buffer,
+                                   size_t numberOfVertices,
+                                   int numberOfSegments,
+                                   int *segmentation);
+    /**
+     * @brief Range code the segmentation of a grid
+     *
+     * The segment of each vertex is predicted from its left, above and front
+     * neighbors, with adaptive probabilities conditioned by their
+     * configuration: long runs inside the segments cost a small fraction of
+     * a bit per vertex.
+     */
+    static void EncodeSegmentation(const int *segmentation,
+                                   const int *dimensions,
+                                   int numberOfSegments,
+                                   std::vector<unsigned char> &buffer);
+    /// Decode a segmentation encoded by EncodeSegmentation(), returns 0 on
+    /// success
+    static int DecodeSegmentation(const unsigned char *buffer,
+                                  size_t size,
+                                  const int *dimensions,
+                                  int numberOfSegments,
+                                  int *segmentation);
+
+    /**
+     * @brief Losslessly compress a chunk of memory
+     *
+     * @return 0 on success, -2 if the compressor is not available
+     */
+    static int CompressChunk(LosslessCodec codec,
+                             const std::vector<unsigned char> &source,
+                             std::vector<unsigned char> &dest);
+    /**
+     * @brief Decompress a chunk compressed by CompressChunk()
+     *
+     * @param[out] dest Buffer of the size of the uncompressed chunk
+     * @return 0 on success, -2 if the compressor is not available
+     */
+    static int DecompressChunk(LosslessCodec codec,
+                               const std::vector<unsigned char> &source,
+                               std::vector<unsigned char> &dest);
+
+    int EncodeBrick(Brick &brick,
+                    const int *dimensions,
+                    LosslessCodec codec,
+                    bool zfpOnly,
+                    double zfpBitBudget,
+                    const double *data,
+                    const int *gridSegmentation,
+                    std::vector<unsigned char> &payload);
+    int DecodeBrick(const Brick &brick,
+                    const int *dimensions,
+                    LosslessCodec codec,
+                    const std::array<int, 6> &roi,
+                    const std::vector<unsigned char> &payload,
+                    const std::vector<std::tuple<double, int>> *valueMapping,
+                    int &nMisses);
+    int WriteBricks(FILE *fp,
+                    const int *dataExtent,
+                    bool zfpOnly,
+                    double zfpBitBudget,
+                    const double *data);
+    int ReadBricks(FILE *fp,
+                   LosslessCodec codec,
+                   int brickSize,
+                   bool predicted = false);
+
     // API management.
 
 #ifdef TTK_ENABLE_ZFP
@@ -301,6 +482,13 @@ namespace ttk {
                         int ny,
                         int nz,
                         double rate);
+    int CompressWithZFP(bool decompress,
+                        std::vector<double> &array,
+                        int nx,
+                        int ny,
+                        int nz,
+                        double rate,
+                        std::vector<unsigned char> &buffer);
 #endif
 
 #ifdef TTK_ENABLE_ZLIB
@@ -309,7 +497,18 @@ namespace ttk {
                           uLongf *destLen,
                           const Bytef *source,
                           uLong sourceLen);
+    /// Stream sourceLen bytes of source to dest through a zlib deflate
+    /// stream, chunk by chunk
+    static int DeflateStream(FILE *source,
+                             unsigned long sourceLen,
+                             FILE *dest,
+                             unsigned long &destLen);
+    /// Inflate a zlib stream of sourceLen bytes of source to dest, chunk by
+    /// chunk
+    static int InflateStream(FILE *source, unsigned long sourceLen, FILE *dest);
 #endif
+    /// Copy length bytes of source to dest, chunk by chunk
+    static void CopyStream(FILE *source, unsigned long length, FILE *dest);
 
   private:
     // Internal read/write.
@@ -332,6 +531,10 @@ namespace ttk {
     template <typename dataType, typename triangulationType>
     int ReadPersistenceGeometry(FILE *fm,
                                 const triangulationType &triangulation);
+    template <typename dataType, typename triangulationType>
+    int ReadPersistenceBricks(FILE *fm,
+                              bool useZlib,
+                              const triangulationType &triangulation);
     template <typename dataType>
     int ReadOtherGeometry(FILE *fm);
 
@@ -348,6 +551,26 @@ namespace ttk {
     template <typename dataType>
     int WriteOtherGeometry(FILE *fm);
 
+    void initDecompressedExtent();
+    void CropRegionOfInterest();
+
+    /**
+     * @brief Residual quantization of the segmentation against the previous
+     * timestep
+     *
+     * @param[out] segmentation Segmentation where the predicted vertices
+     * are set to the extra segment getNbSegments()
+     * @return Name of the file of the previous timestep, empty for a key
+     * frame
+     */
+    std::string PredictSegmentation(const int *dataExtent,
+                                    const double *data,
+                                    std::vector<int> &segmentation);
+    /// Decompress the quantized field of the previous timestep
+    template <typename triangulationType>
+    int ReadReference(const std::string &name,
+                      const triangulationType &triangulation);
+
     template <typename dataType, typename triangulationType>
     int PerformSimplification(
       const std::vector<std::tuple<int, double, int>> &constraints,
@@ -385,6 +608,12 @@ namespace ttk {
     std::string SQMethod{};
     bool Subdivide{false};
     bool UseTopologicalSimplification{true};
+    // Bricked format: number of vertices per brick side (0 writes the
+    // monolithic version 1 format)
+    int BrickSize{64};
+    // Temporal mode: encode each timestep relative to the previous one
+    bool TemporalMode{false};
+    int KeyFrameInterval{16};
 
     int dataScalarType_{};
     int dataExtent_[6];
@@ -407,12 +636,27 @@ namespace ttk {
     std::vector<int> compressedOffsets_{};
     int vertexNumberRead_{};
     char *fileName{};
+    unsigned long fileFormatVersion_{};
+    bool hasRegionOfInterest_{false};
+    std::array<int, 6> regionOfInterest_{};
+    std::array<int, 6> decompressedExtent_{};
+
+    // Temporal mode: quantized field of the previous timestep (on the whole
+    // grid, only valid in referenceExtent_), and its file.
+    std::vector<double> referenceData_{};
+    std::array<int, 6> referenceExtent_{};
+    std::string referenceFile_{};
+    int framesSinceKeyFrame_{};
+    // only decompress the quantized field
+    bool referenceOnly_{false};
 
     // Char array that identifies the file format.
     static const char *magicBytes_;
     // Current version of the file format. To be incremented at every
     // breaking change to keep backward compatibility.
     static const unsigned long formatVersion_;
+    // Size of the chunks of the zlib streams.
+    static const size_t ChunkSize{1 << 20};
   };
 
 } // namespace ttk
@@ -461,10 +705,18 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
                                              double tolerance,
                                              double zfpBitBudget,
                                              const std::string &dataArrayName) {
+  bool usePersistence
+    = compressionType == (int)ttk::CompressionType::PersistenceDiagram;
+  bool useOther = compressionType == (int)ttk::CompressionType::Other;
+
+  // the bricked format is only implemented for the persistence compression
+  const bool useBricks = usePersistence && BrickSize > 0;
+
   // [->fp] Write metadata.
   WriteMetaData<double>(fp, compressionType, zfpOnly, sqMethod, dataType,
                         dataExtent, dataSpacing, dataOrigin, tolerance,
-                        zfpBitBudget, dataArrayName);
+                        zfpBitBudget, dataArrayName,
+                        useBricks ? formatVersion_ : 1);
 
 #ifdef TTK_ENABLE_ZLIB
   Write(fp, true);
@@ -472,25 +724,25 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
   Write(fp, false);
 #endif
 
-  bool usePersistence
-    = compressionType == (int)ttk::CompressionType::PersistenceDiagram;
-  bool useOther = compressionType == (int)ttk::CompressionType::Other;
-
   int numberOfVertices = 1;
   for(int i = 0; i < 3; ++i)
     numberOfVertices *= (1 + dataExtent[2 * i + 1] - dataExtent[2 * i]);
   NbVertices = numberOfVertices;
 
+  if(useBricks) {
+    const auto status
+      = WriteBricks(fp, dataExtent, zfpOnly, zfpBitBudget, data);
+    fflush(fp);
+    fclose(fp);
+    return status;
+  }
+
   int totalSize = usePersistence
                     ? ComputeTotalSizeForPersistenceDiagram<double>(
                       getMapping(), getCriticalConstraints(), zfpOnly,
                       getNbSegments(), getNbVertices(), zfpBitBudget)
                     : useOther ? ComputeTotalSizeForOther<double>() : 0;
 
-  std::vector<char> bbuf(totalSize);
-  char *buf = bbuf.data();
-  size_t len = (size_t)totalSize;
-
   // #ifndef _MSC_VER
   // FILE *fm = fmemopen(buf, len, "r+");
   // #else
@@ -518,17 +770,12 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
     status = WriteOtherGeometry<double>(fm);
 
   fclose(fm); // !Close stream to write changes!
-  // #ifdef _MSC_VER
-  fm = fopen(ffn, "rb");
-  int ret = fread(buf, len, sizeof(char), fm);
-  fclose(fm);
-  remove(ffn);
-  // #endif
 
   if(status == 0) {
     this->printMsg("Geometry successfully written to buffer.");
   } else {
     this->printErr("Geometry was not successfully written to buffer.");
+    remove(ffn);
     fflush(fp);
     fclose(fp);
     return -1;
@@ -540,37 +787,42 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
                    + std::to_string(rawFileLength) + ").");
   }
 
-#ifdef TTK_ENABLE_ZLIB
-  // [fm->ff] Compress fm.
-  uLong sourceLen = (uLong)rawFileLength;
-  Bytef *source = reinterpret_cast<unsigned char *>(buf);
-  uLongf destLen = compressBound(sourceLen);
-  std::vector<Bytef> ddest(destLen);
-  Bytef *dest = ddest.data();
-  CompressWithZlib(false, dest, &destLen, source, sourceLen);
-  this->printMsg("Data successfully compressed.");
-
-  // [fm->fp] Copy fm to fp.
+  // [fm->fp] Stream fm to fp, chunk by chunk.
+  fm = fopen(ffn, "rb");
+  unsigned long sourceLen = (unsigned long)rawFileLength;
+  unsigned long destLen = sourceLen;
+  fpos_t sizePosition;
+  fgetpos(fp, &sizePosition);
   Write(fp, destLen); // Compressed size...
   Write(fp, sourceLen);
-  WriteByteArray(fp, dest, destLen);
-  this->printMsg("Data successfully written to filesystem.");
 
+#ifdef TTK_ENABLE_ZLIB
+  status = DeflateStream(fm, sourceLen, fp, destLen);
+  // the compressed size is only known at the end of the stream
+  fsetpos(fp, &sizePosition);
+  Write(fp, destLen);
+  fseek(fp, 0, SEEK_END);
+  if(status == 0) {
+    this->printMsg("Data successfully compressed.");
+  } else {
+    this->printErr("Data was not successfully compressed.");
+  }
 #else
   this->printMsg("ZLIB not found, writing raw file.");
-  unsigned char *source = reinterpret_cast<unsigned char *>(buf);
-  unsigned long sourceLen = (unsigned long)rawFileLength;
-  unsigned long destLen = (unsigned long)rawFileLength;
-
-  Write(fp, destLen); // Compressed size...
-  Write(fp, sourceLen);
-  WriteByteArray(fp, source, destLen);
+  CopyStream(fm, sourceLen, fp);
 #endif
 
+  fclose(fm);
+  remove(ffn);
+
+  if(status == 0) {
+    this->printMsg("Data successfully written to filesystem.");
+  }
+
   fflush(fp);
   fclose(fp);
 
-  return ret;
+  return status;
 }
 
 template <typename T>
@@ -585,13 +837,14 @@ int ttk::TopologicalCompression::WriteMetaData(
   double *dataOrigin,
   double tolerance,
   double zfpBitBudget,
-  const std::string &dataArrayName) {
+  const std::string &dataArrayName,
+  unsigned long formatVersion) {
 
   // -4. Magic bytes
   WriteByteArray(fp, magicBytes_, std::strlen(magicBytes_));
 
   // -3. File format version
-  Write(fp, formatVersion_);
+  Write(fp, formatVersion);
 
   // -2. Persistence, or Other
   Write(fp, compressionType);
@@ -647,77 +900,71 @@ int ttk::TopologicalCompression::ReadFromFile(
 
   this->printMsg("Successfully read metadata.");
 
+  std::copy(dataExtent_, dataExtent_ + 6, decompressedExtent_.begin());
+
   if(ZFPOnly && (ZFPBitBudget > 64 || ZFPBitBudget < 1)) {
     this->printMsg("Wrong ZFP bit budget for ZFP-only use.");
     return -4;
   }
 
   bool useZlib = Read<bool>(fp);
-  unsigned char *dest;
-  std::vector<unsigned char> ddest;
-  unsigned long destLen;
+
+  if(fileFormatVersion_ >= 2) {
+    // Bricked format: only decompress the region of interest.
+    const auto status
+      = ReadPersistenceBricks<double>(fp, useZlib, triangulation);
+    fclose(fp);
+    if(status == 0) {
+      this->printMsg("Successfully read file.");
+    } else {
+      this->printErr("File may be corrupted!");
+    }
+    return status;
+  }
+
+  //#ifndef _MSC_VER
+  // FILE *fm = fmemopen(buf, destLen, "r+");
+  //#else
+  const std::string s = fileName + std::string(".temp");
+  const char *ffn = s.c_str();
+  FILE *ftemp = fopen(ffn, "wb");
+  //#endif
+
+  // [fp->fm] Stream the data to fm, chunk by chunk.
+  const unsigned long sl = Read<unsigned long>(fp); // Compressed size...
+  const unsigned long dl = Read<unsigned long>(fp); // Uncompressed size...
 
 #ifdef TTK_ENABLE_ZLIB
   if(useZlib) {
-    // [fp->ff] Read compressed data.
-    uLongf sl = Read<unsigned long>(fp); // Compressed size...
-    uLongf dl = Read<unsigned long>(fp); // Uncompressed size...
-
-    unsigned long sourceLen = (uLongf)sl;
-    destLen = dl;
-    std::vector<Bytef> ssource(sl);
-    Bytef *source = ssource.data();
-    ReadByteArray(fp, source, sl);
-    this->printMsg("Successfully read compressed data.");
-
-    // [ff->fm] Decompress data.
-    ddest.resize(destLen);
-    dest = ddest.data();
-    CompressWithZlib(true, dest, &destLen, source, sourceLen);
+    const int inflateStatus = InflateStream(fp, sl, ftemp);
+    if(inflateStatus != 0) {
+      this->printErr("Could not uncompress data! Aborting.");
+      fclose(ftemp);
+      remove(ffn);
+      fclose(fp);
+      return -4;
+    }
     this->printMsg("Successfully uncompressed data.");
 
   } else {
     this->printMsg("File was not compressed with ZLIB.");
-
-    Read<unsigned long>(fp); // Compressed size...
-    unsigned long dl = Read<unsigned long>(fp); // Uncompressed size...
-
-    destLen = dl;
-    ddest.resize(destLen);
-    dest = ddest.data();
-    ReadByteArray(fp, dest, destLen);
+    CopyStream(fp, dl, ftemp);
   }
 #else
   if(useZlib) {
     this->printMsg(" File compressed but ZLIB not installed! Aborting.");
+    fclose(ftemp);
+    remove(ffn);
     return -4;
 
   } else {
     this->printMsg(" ZLIB not installed, but file was not compressed anyways.");
-
-    Read<unsigned long>(fp); // Compressed size...
-    unsigned long dl = Read<unsigned long>(fp); // Uncompressed size...
-
-    destLen = dl;
-    ddest.resize(destLen);
-    dest = ddest.data();
-    ReadByteArray(fp, dest, destLen);
+    CopyStream(fp, dl, ftemp);
   }
 #endif
 
-  // [fm->] Read data.
-  char *buf = reinterpret_cast<char *>(dest);
-
-  //#ifndef _MSC_VER
-  // FILE *fm = fmemopen(buf, destLen, "r+");
-  //#else
-  const std::string s = fileName + std::string(".temp");
-  const char *ffn = s.c_str();
-  FILE *ftemp = fopen(ffn, "wb");
-  fwrite(buf, destLen, sizeof(char), ftemp);
   fclose(ftemp);
   FILE *fm = fopen(ffn, "rb");
-  //#endif
 
   // Do read topology.
   if(!(ZFPOnly)) {
@@ -744,6 +991,8 @@ int ttk::TopologicalCompression::ReadFromFile(
   fclose(fp);
 
   if(status == 0) {
+    // The monolithic format is decompressed as a whole.
+    CropRegionOfInterest();
     this->printMsg("Successfully read geometry.");
     this->printMsg("Successfully read file.");
   } else {
@@ -779,6 +1028,11 @@ int ttk::TopologicalCompression::ReadMetaData(FILE *fm) {
   if(hasMagicBytes) {
     version = Read<unsigned long>(fm);
   }
+  fileFormatVersion_ = version;
+  if(version > formatVersion_) {
+    this->printWrn("Unsupported file format version "
+                   + std::to_string(version) + "!");
+  }
 
   // -2. Compression type.
   compressionType_ = Read<int>(fm);
@@ -10,6 +10,9 @@
 #include <vtkTable.h>
 #include <vtkXMLGenericDataObjectReader.h>
 
+#include <algorithm>
+#include <fstream>
+
 vtkStandardNewMacro(ttkCinemaProductReader);
 
 ttkCinemaProductReader::ttkCinemaProductReader() {
@@ -52,15 +55,43 @@ vtkSmartPointer<vtkDataObject> readFileLocal_(std::string pathToFile,
   return result;
 }
 
+// shallow copy of a product whose leaves own their field data (the leaves of
+// a shallow copied multi-block dataset are shared with the source)
+vtkSmartPointer<vtkDataObject> copyProduct_(vtkDataObject *product) {
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(product->NewInstance());
+  copy->ShallowCopy(product);
+  auto copyAsMB = vtkMultiBlockDataSet::SafeDownCast(copy);
+  if(copyAsMB) {
+    for(size_t i = 0, j = copyAsMB->GetNumberOfBlocks(); i < j; i++) {
+      auto block = copyAsMB->GetBlock(i);
+      if(block)
+        copyAsMB->SetBlock(i, copyProduct_(block));
+    }
+  }
+  return copy;
+}
+
+// products read by a ttkAlgorithm-based reader: those readers go through the
+// triangulation registry of ttkAlgorithm, which is not thread-safe
+bool isTTKProduct_(const std::string &pathToFile) {
+  return pathToFile.size() >= 4
+         && (pathToFile.substr(pathToFile.size() - 4) == ".ttk"
+             || pathToFile.substr(pathToFile.size() - 4) == ".tpd");
+}
+
 vtkSmartPointer<vtkDataObject>
-  ttkCinemaProductReader::readFileLocal(std::string pathToFile) {
+  ttkCinemaProductReader::readFileLocal(std::string pathToFile,
+                                        ProductReaders &readers) const {
 
   if(pathToFile.substr(pathToFile.length() - 4, 4).compare(".ttk") == 0) {
-    this->topologicalCompressionReader->SetDebugLevel(this->debugLevel_);
-    return readFileLocal_(pathToFile, this->topologicalCompressionReader);
+    readers.topologicalCompressionReader->SetDebugLevel(this->debugLevel_);
+    return readFileLocal_(pathToFile, readers.topologicalCompressionReader);
+  } else if(pathToFile.substr(pathToFile.length() - 4, 4) == ".tpd") {
+    readers.persistenceDiagramReader->SetDebugLevel(this->debugLevel_);
+    return readFileLocal_(pathToFile, readers.persistenceDiagramReader);
   } else if(pathToFile.substr(pathToFile.size() - 4) == ".tif"
             || pathToFile.substr(pathToFile.size() - 5) == ".tiff") {
-    return readFileLocal_(pathToFile, this->tiffReader);
+    return readFileLocal_(pathToFile, readers.tiffReader);
   } else {
     // Check if dataset is XML encoded
     std::ifstream is(pathToFile.data());
@@ -71,10 +102,10 @@ vtkSmartPointer<vtkDataObject>
 
     if(isXML)
       // If isXML use vtkXMLGenericDataObjectReader
-      return readFileLocal_(pathToFile, this->xmlGenericDataObjectReader);
+      return readFileLocal_(pathToFile, readers.xmlGenericDataObjectReader);
     else
       // Otherwise use vtkGenericDataObjectReader
-      return readFileLocal_(pathToFile, this->genericDataObjectReader);
+      return readFileLocal_(pathToFile, readers.genericDataObjectReader);
   }
 
   return nullptr;
@@ -95,6 +126,55 @@ int ttkCinemaProductReader::addFieldDataRecursively(vtkDataObject *object,
   return 1;
 }
 
+vtkSmartPointer<vtkDataObject>
+  ttkCinemaProductReader::findInCache(const std::string &path,
+                                      const long long timestamp) {
+  const auto it = this->CacheEntries.find(path);
+  if(it == this->CacheEntries.end()) {
+    return nullptr;
+  }
+  if(it->second->timestamp != timestamp) {
+    // the file has been modified since
+    this->CacheMemorySize -= it->second->memorySize;
+    this->Cache.erase(it->second);
+    this->CacheEntries.erase(it);
+    return nullptr;
+  }
+  // move to the front (most recently used)
+  this->Cache.splice(this->Cache.begin(), this->Cache, it->second);
+  return it->second->product;
+}
+
+void ttkCinemaProductReader::insertInCache(const std::string &path,
+                                           const long long timestamp,
+                                           vtkDataObject *product) {
+  const unsigned long capacity
+    = static_cast<unsigned long>(std::max(this->CacheSize, 0)) * 1024;
+  const unsigned long memorySize = product->GetActualMemorySize();
+  if(timestamp < 0 || memorySize > capacity
+     || this->CacheEntries.count(path) > 0) {
+    return;
+  }
+
+  // evict the least recently used products
+  while(!this->Cache.empty()
+        && this->CacheMemorySize + memorySize > capacity) {
+    this->CacheMemorySize -= this->Cache.back().memorySize;
+    this->CacheEntries.erase(this->Cache.back().path);
+    this->Cache.pop_back();
+  }
+
+  // keep a copy, the output product field data is modified afterwards
+  this->Cache.emplace_front();
+  auto &entry = this->Cache.front();
+  entry.path = path;
+  entry.timestamp = timestamp;
+  entry.memorySize = memorySize;
+  entry.product = copyProduct_(product);
+  this->CacheEntries[path] = this->Cache.begin();
+  this->CacheMemorySize += memorySize;
+}
+
 int ttkCinemaProductReader::RequestData(vtkInformation *request,
                                         vtkInformationVector **inputVector,
                                         vtkInformationVector *outputVector) {
@@ -122,6 +202,88 @@ int ttkCinemaProductReader::RequestData(vtkInformation *request,
       return 0;
     }
 
+    // look for the products in the cache, the others are read (once)
+    std::vector<std::string> filePaths(n);
+    std::vector<long long> timestamps(n);
+    std::vector<vtkSmartPointer<vtkDataObject>> products(n);
+    std::vector<size_t> toRead{};
+    std::unordered_map<std::string, size_t> firstRows{};
+    for(size_t i = 0; i < n; i++) {
+      filePaths[i] = paths->GetVariantValue(i).ToString();
+      timestamps[i] = ttk::OsCall::getFileModificationTime(filePaths[i]);
+      if(this->CacheSize > 0) {
+        products[i] = this->findInCache(filePaths[i], timestamps[i]);
+      }
+      if(!products[i] && firstRows.emplace(filePaths[i], i).second) {
+        toRead.emplace_back(i);
+      }
+    }
+
+    if(!toRead.empty()) {
+      ttk::Timer readTimer;
+
+      // TTK products are read one at a time, the others in parallel
+      std::vector<size_t> toReadTTK{}, toReadVTK{};
+      for(const auto i : toRead) {
+        if(isTTKProduct_(filePaths[i]))
+          toReadTTK.emplace_back(i);
+        else
+          toReadVTK.emplace_back(i);
+      }
+
+      const int nReaders = std::max(
+        1, std::min(this->NumberOfReaders > 0 ? this->NumberOfReaders
+                                              : this->threadNumber_,
+                    static_cast<int>(toReadVTK.size())));
+      while(this->Readers.size() < static_cast<size_t>(nReaders)) {
+        this->Readers.emplace_back(new ProductReaders{});
+      }
+
+      const std::string msg = "Reading " + std::to_string(toRead.size())
+                              + " file(s) (" + std::to_string(n - toRead.size())
+                              + " cached)";
+      this->printMsg(msg, 0, 0, nReaders, ttk::debug::LineMode::REPLACE);
+
+      for(const auto i : toReadTTK) {
+        std::ifstream infile(filePaths[i].data());
+        if(infile.good()) {
+          products[i] = this->readFileLocal(filePaths[i], *this->Readers[0]);
+        }
+      }
+
+      // each thread uses its own readers
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nReaders)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t k = 0; k < toReadVTK.size(); k++) {
+        int threadId = 0;
+#ifdef TTK_ENABLE_OPENMP
+        threadId = omp_get_thread_num();
+#endif // TTK_ENABLE_OPENMP
+        const auto &path = filePaths[toReadVTK[k]];
+        std::ifstream infile(path.data());
+        if(infile.good()) {
+          products[toReadVTK[k]]
+            = this->readFileLocal(path, *this->Readers[threadId]);
+        }
+      }
+
+      for(const auto i : toRead) {
+        if(!products[i]) {
+          std::ifstream infile(filePaths[i].data());
+          this->printErr(infile.good() ? "Unable to read file."
+                                       : "File does not exist.");
+          this->printErr("  " + filePaths[i]);
+          return 0;
+        }
+        if(this->CacheSize > 0) {
+          this->insertInCache(filePaths[i], timestamps[i], products[i]);
+        }
+      }
+
+      this->printMsg(msg, 1, readTimer.getElapsedTime(), nReaders);
+    }
+
     // For each row
     for(size_t i = 0; i < n; i++) {
 
@@ -129,7 +291,7 @@ int ttkCinemaProductReader::RequestData(vtkInformation *request,
       ttk::Timer fileTimer;
 
       // get filepath
-      auto path = paths->GetVariantValue(i).ToString();
+      const auto &path = filePaths[i];
       auto file = path.substr(path.find_last_of("/") + 1);
 
       // print progress
@@ -137,22 +299,12 @@ int ttkCinemaProductReader::RequestData(vtkInformation *request,
                        + std::to_string(n) + "): \"" + file + "\"",
                      0, ttk::debug::LineMode::REPLACE);
 
-      // read local file
+      // products shared by several rows (or cached) are shallow copies, down
+      // to the leaves that receive the row data
       {
-        std::ifstream infile(path.data());
-        bool exists = infile.good();
-        if(!exists) {
-          this->printErr("File does not exist.");
-          return 0;
-        }
-
-        auto readerOutput = this->readFileLocal(path);
-        if(!readerOutput) {
-          this->printErr("Unable to read file.");
-          return 0;
-        }
-
-        outputMB->SetBlock(i, readerOutput);
+        const auto &product
+          = products[i] ? products[i] : products[firstRows[path]];
+        outputMB->SetBlock(i, copyProduct_(product));
       }
 
       // augment data products with row data
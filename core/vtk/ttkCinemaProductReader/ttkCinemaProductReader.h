@@ -10,6 +10,13 @@
 /// results are stored in a vtkMultiBlockDataSet where each block corresponds to
 /// a row of the table with consistent ordering.
 ///
+/// The products are read in parallel by NumberOfReaders threads (all the
+/// available threads by default), except for the TTK products (.ttk, .tpd)
+/// which are read one at a time. The most recently read products are
+/// kept in a least-recently-used cache of CacheSize MB, keyed by file path
+/// and modification time, so that repeated executions (e.g. in a ttkForEach
+/// loop) do not read the same files again.
+///
 /// \param Input vtkTable that contains data product references (vtkTable)
 /// \param Output vtkMultiBlockDataSet where each block is a referenced product
 /// of an input table row (vtkMultiBlockDataSet)
@@ -22,6 +29,7 @@
 // VTK includes
 #include <ttkAlgorithm.h>
 
+#include <ttkPersistenceDiagramReader.h>
 #include <ttkTopologicalCompressionReader.h>
 #include <vtkGenericDataObjectReader.h>
 #include <vtkNew.h>
@@ -29,6 +37,11 @@
 #include <vtkTIFFReader.h>
 #include <vtkXMLGenericDataObjectReader.h>
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 class TTKCINEMAPRODUCTREADER_EXPORT ttkCinemaProductReader
   : public ttkAlgorithm {
 
@@ -40,14 +53,51 @@ public:
   vtkGetMacro(FilepathColumnName, std::string);
   vtkSetMacro(AddFieldDataRecursively, bool);
   vtkGetMacro(AddFieldDataRecursively, bool);
+  vtkSetMacro(NumberOfReaders, int);
+  vtkGetMacro(NumberOfReaders, int);
+  vtkSetMacro(CacheSize, int);
+  vtkGetMacro(CacheSize, int);
 
 protected:
   ttkCinemaProductReader();
   ~ttkCinemaProductReader();
 
-  vtkSmartPointer<vtkDataObject> readFileLocal(std::string pathToFile);
+  /// Readers used by one reading thread
+  struct ProductReaders {
+    // TTK READER
+    vtkNew<ttkTopologicalCompressionReader> topologicalCompressionReader{};
+
+    // PERSISTENCE DIAGRAM READER
+    vtkNew<ttkPersistenceDiagramReader> persistenceDiagramReader{};
+
+    // TIFF READER
+    vtkNew<vtkTIFFReader> tiffReader{};
+
+    // LOCAL-LEGACY && REMOTE-LEGACY
+    vtkNew<vtkGenericDataObjectReader> genericDataObjectReader{};
+
+    // LOCAL-XML
+    vtkNew<vtkXMLGenericDataObjectReader> xmlGenericDataObjectReader{};
+  };
+
+  /// Product cached with the modification time of its file
+  struct CacheEntry {
+    std::string path{};
+    long long timestamp{};
+    unsigned long memorySize{}; // in KiB
+    vtkSmartPointer<vtkDataObject> product{};
+  };
+
+  vtkSmartPointer<vtkDataObject> readFileLocal(std::string pathToFile,
+                                               ProductReaders &readers) const;
   int addFieldDataRecursively(vtkDataObject *object, vtkFieldData *fd);
 
+  vtkSmartPointer<vtkDataObject> findInCache(const std::string &path,
+                                             const long long timestamp);
+  void insertInCache(const std::string &path,
+                     const long long timestamp,
+                     vtkDataObject *product);
+
   int FillInputPortInformation(int port, vtkInformation *info) override;
   int FillOutputPortInformation(int port, vtkInformation *info) override;
 
@@ -58,16 +108,15 @@ protected:
 private:
   std::string FilepathColumnName{"FILE"};
   bool AddFieldDataRecursively{true};
+  int NumberOfReaders{0};
+  int CacheSize{1024};
 
-  // TTK READER
-  vtkNew<ttkTopologicalCompressionReader> topologicalCompressionReader{};
-
-  // TIFF READER
-  vtkNew<vtkTIFFReader> tiffReader{};
-
-  // LOCAL-LEGACY && REMOTE-LEGACY
-  vtkNew<vtkGenericDataObjectReader> genericDataObjectReader{};
+  // one set of readers per reading thread, re-used between executions
+  std::vector<std::unique_ptr<ProductReaders>> Readers{};
 
-  // LOCAL-XML
-  vtkNew<vtkXMLGenericDataObjectReader> xmlGenericDataObjectReader{};
+  // least recently used products at the back
+  std::list<CacheEntry> Cache{};
+  std::unordered_map<std::string, std::list<CacheEntry>::iterator>
+    CacheEntries{};
+  unsigned long CacheMemorySize{}; // in KiB
 };
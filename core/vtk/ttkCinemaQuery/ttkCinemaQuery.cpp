@@ -6,11 +6,13 @@
 #include <vtkFieldData.h>
 #include <vtkInformationVector.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
 #include <vtkTable.h>
 #include <vtkVersionMacros.h>
 
 #include <ttkUtils.h>
 
+#include <fstream>
 #include <numeric>
 #include <regex>
 
@@ -61,78 +63,83 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
 
   auto firstTable = inTables[0];
 
-  std::vector<std::string> sqlTableDefinitions;
-  std::vector<std::string> sqlInsertStatements;
+  // a single table read by a CinemaReader is indexed next to its data.csv
+  std::string indexFile{}, indexKey{};
+  if(this->UseIndex && nTables == 1 && firstTable != nullptr) {
+    const auto dbPath = vtkStringArray::SafeDownCast(
+      firstTable->GetFieldData()->GetAbstractArray("_ttk_CinemaDatabase"));
+    if(dbPath != nullptr && dbPath->GetNumberOfValues() > 0) {
+      const std::string csvPath = dbPath->GetValue(0) + "/data.csv";
+      std::ifstream csvFile(csvPath, std::ios::binary | std::ios::ate);
+      if(csvFile.is_open()) {
+        indexFile = csvPath + ".sqlite";
+        indexKey
+          = csvPath + ";"
+            + std::to_string(ttk::OsCall::getFileModificationTime(csvPath))
+            + ";" + std::to_string(csvFile.tellg()) + ";"
+            + std::to_string(firstTable->GetNumberOfRows()) + ";";
+      }
+    }
+  }
+
+  std::vector<ttk::CinemaQuery::Table> sqlTables(nTables);
   {
     ttk::Timer conversionTimer;
     this->printMsg("Converting input VTK tables to SQL tables", 0,
                    ttk::debug::LineMode::REPLACE);
 
+    std::vector<std::vector<size_t>> includeColumns(nTables);
     for(int i = 0; i < nTables; i++) {
       auto inTable = inTables[i];
-
       size_t nc = inTable->GetNumberOfColumns();
-      size_t nr = inTable->GetNumberOfRows();
-      std::vector<bool> isNumeric(nc);
 
       // select all input columns whose name is NOT matching the regexp
-      std::vector<size_t> includeColumns{};
       if(this->ExcludeColumnsWithRegexp) {
         for(size_t j = 0; j < nc; ++j) {
           const auto &name = inTable->GetColumnName(j);
           if(!std::regex_match(name, std::regex(RegexpString))) {
-            includeColumns.emplace_back(j);
+            includeColumns[i].emplace_back(j);
           }
         }
       } else {
-        includeColumns.resize(nc);
-        std::iota(includeColumns.begin(), includeColumns.end(), 0);
+        includeColumns[i].resize(nc);
+        std::iota(includeColumns[i].begin(), includeColumns[i].end(), 0);
       }
 
       // -----------------------------------------------------------------------
       // Table Definition
-      std::string sqlTableDefinition
-        = "CREATE TABLE InputTable" + std::to_string(i) + " (";
+      auto &sqlTable = sqlTables[i];
+      sqlTable.name = "InputTable" + std::to_string(i);
+      sqlTable.nColumns = includeColumns[i].size();
+      sqlTable.definition = "CREATE TABLE " + sqlTable.name + " (";
       bool firstCol{true};
-      for(const auto j : includeColumns) {
+      for(const auto j : includeColumns[i]) {
         auto c = inTable->GetColumn(j);
-        isNumeric[j] = c->IsNumeric();
-        sqlTableDefinition += (firstCol ? "" : ",") + std::string(c->GetName())
-                              + " " + (isNumeric[j] ? "REAL" : "TEXT");
+        sqlTable.definition += (firstCol ? "" : ",")
+                               + std::string(c->GetName()) + " "
+                               + (c->IsNumeric() ? "REAL" : "TEXT");
         if(firstCol) {
           firstCol = false;
         }
       }
-      sqlTableDefinition += ")";
-      sqlTableDefinitions.emplace_back(sqlTableDefinition);
+      sqlTable.definition += ")";
+    }
 
-      // -----------------------------------------------------------------------
-      // Insert Statements
-      size_t q = 0;
-      while(q < nr) {
-        std::string sqlInsertStatement
-          = "INSERT INTO InputTable" + std::to_string(i) + " VALUES ";
-        for(size_t j = 0; j < 500 && q < nr; j++) {
-          if(j > 0)
-            sqlInsertStatement += ",";
-
-          sqlInsertStatement += "(";
-          firstCol = true;
-          for(const auto k : includeColumns) {
-            sqlInsertStatement += (firstCol ? "" : ",");
-            if(firstCol) {
-              firstCol = false;
-            }
-            if(isNumeric[k])
-              sqlInsertStatement += inTable->GetValue(q, k).ToString();
-            else
-              sqlInsertStatement
-                += "'" + inTable->GetValue(q, k).ToString() + "'";
-          }
-          sqlInsertStatement += ")";
-          q++;
+    if(!indexFile.empty()) {
+      indexKey += sqlTables[0].definition;
+    }
+
+    // -------------------------------------------------------------------------
+    // Table Values (always needed: the index is keyed on the table contents)
+    for(int i = 0; i < nTables; i++) {
+      auto inTable = inTables[i];
+      size_t nr = inTable->GetNumberOfRows();
+      auto &values = sqlTables[i].values;
+      values.reserve(nr * includeColumns[i].size());
+      for(size_t q = 0; q < nr; q++) {
+        for(const auto k : includeColumns[i]) {
+          values.emplace_back(inTable->GetValue(q, k).ToString());
         }
-        sqlInsertStatements.emplace_back(sqlInsertStatement);
       }
     }
 
@@ -159,9 +166,8 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
   int csvNColumns = 0;
   int csvNRows = 0;
 
-  int status
-    = this->execute(sqlTableDefinitions, sqlInsertStatements, finalQueryString,
-                    csvResult, csvNColumns, csvNRows);
+  int status = this->execute(sqlTables, finalQueryString, csvResult,
+                             csvNColumns, csvNRows, indexFile, indexKey);
 
   // ===========================================================================
   // Process Result
@@ -200,6 +206,9 @@ int ttkCinemaQuery::RequestData(vtkInformation *request,
       size_t n = inFD->GetNumberOfArrays();
       for(size_t i = 0; i < n; i++) {
         auto iArray = inFD->GetAbstractArray(i);
+        if(std::string(iArray->GetName()) == "_ttk_CinemaDatabase") {
+          continue;
+        }
         if(!outFD->GetAbstractArray(iArray->GetName())) {
           outFD->AddArray(iArray);
         }
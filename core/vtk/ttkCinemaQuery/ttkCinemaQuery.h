@@ -9,6 +9,12 @@
 /// This filter creates a temporary SQLite3 database from the input table,
 /// performs a SQL query, and then returns the result as a vtkTable.
 ///
+/// If the input table was read by ttkCinemaReader and UseIndex is enabled,
+/// the database is stored next to the data.csv file of the Cinema database
+/// (data.csv.sqlite) and re-used by the next queries, until data.csv or the
+/// table values are modified. If the index cannot be written (e.g. read-only
+/// database), a temporary in-memory database is used.
+///
 /// VTK wrapping code for the @CinemaQuery package.
 ///
 /// \param Input Input table (vtkTable)
@@ -42,6 +48,9 @@ public:
   vtkSetMacro(RegexpString, std::string);
   vtkGetMacro(RegexpString, std::string);
 
+  vtkSetMacro(UseIndex, bool);
+  vtkGetMacro(UseIndex, bool);
+
 protected:
   ttkCinemaQuery();
   ~ttkCinemaQuery() override;
@@ -57,4 +66,5 @@ private:
   std::string SQLStatement{"SELECT * FROM InputTable0"};
   bool ExcludeColumnsWithRegexp{false};
   std::string RegexpString{".*"};
+  bool UseIndex{true};
 };
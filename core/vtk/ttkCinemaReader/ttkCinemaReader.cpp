@@ -57,6 +57,10 @@ int ttkCinemaReader::RequestData(vtkInformation *request,
   if(!this->validateDatabasePath())
     return 0;
 
+  // merge the rows appended by concurrent writers
+  if(!this->compactJournals(this->GetDatabasePath()))
+    return 0;
+
   this->printMsg("Reading CSV file", 0, ttk::debug::LineMode::REPLACE);
 
   // get output
@@ -98,6 +102,12 @@ int ttkCinemaReader::RequestData(vtkInformation *request,
       }
     }
 
+    // record the database path (used by ttkCinemaQuery to index the table)
+    auto databasePath = vtkSmartPointer<vtkStringArray>::New();
+    databasePath->SetName("_ttk_CinemaDatabase");
+    databasePath->InsertNextValue(this->GetDatabasePath());
+    outTable->GetFieldData()->AddArray(databasePath);
+
     this->printMsg("Reading CSV file", 1, timer.getElapsedTime());
   }
 
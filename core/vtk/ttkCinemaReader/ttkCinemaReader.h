@@ -8,6 +8,9 @@
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
+/// The rows appended to the journals of the database by ttkCinemaWriter
+/// (journal mode) are merged into the data.csv file before it is read.
+///
 /// \param Output content of the data.csv file of the database in form of a
 /// vtkTable
 
@@ -20,7 +23,11 @@
 #include <ttkAlgorithm.h>
 #include <vtkInformation.h>
 
-class TTKCINEMAREADER_EXPORT ttkCinemaReader : public ttkAlgorithm {
+// TTK includes
+#include <CinemaJournal.h>
+
+class TTKCINEMAREADER_EXPORT ttkCinemaReader : public ttkAlgorithm,
+                                              protected ttk::CinemaJournal {
 
 public:
   static ttkCinemaReader *New();
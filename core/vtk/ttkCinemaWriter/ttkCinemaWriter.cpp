@@ -88,6 +88,13 @@ int ttkCinemaWriter::DeleteDatabase() {
   return vtkDirectory::DeleteDirectory(this->DatabasePath.data());
 }
 
+int ttkCinemaWriter::CompactDatabase() {
+  if(this->validateDatabasePath() == 0)
+    return 0;
+
+  return this->compactJournals(this->DatabasePath);
+}
+
 // =============================================================================
 // Process Request
 // =============================================================================
@@ -109,9 +116,11 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
   vtkZLibDataCompressor::SafeDownCast(xmlWriter->GetCompressor())
     ->SetCompressionLevel(this->CompressionLevel);
 
-  std::string productExtension = this->Mode == 0
-                                   ? xmlWriter->GetDefaultFileExtension()
-                                   : this->Mode == 1 ? "png" : "ttk";
+  std::string productExtension
+    = this->Mode == 0   ? xmlWriter->GetDefaultFileExtension()
+      : this->Mode == 1 ? "png"
+      : this->Mode == 3 ? "tpd"
+                        : "ttk";
 
   // -------------------------------------------------------------------------
   // Prepare Field Data
@@ -196,12 +205,29 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
   }
 
   // ===========================================================================
-  // Update database
+  // Update database (journal mode: once the product is written)
   // ===========================================================================
-  {
+  if(!this->UseJournal) {
     std::string csvPath = this->DatabasePath + "/data.csv";
     struct stat info;
 
+    // merge the rows appended by the writers in journal mode
+    if(!this->compactJournals(this->DatabasePath))
+      return 0;
+
+    // lock the database for the remaining operations (the lock file is not
+    // rewritten, unlike data.csv)
+    const auto lockPath = ttk::CinemaJournal::getLockFile(this->DatabasePath);
+    std::ofstream(lockPath.data(), std::ios::app).close();
+    boost::interprocess::file_lock flock{};
+    try {
+      flock = boost::interprocess::file_lock(lockPath.data());
+      flock.lock();
+    } catch(boost::interprocess::interprocess_exception &e) {
+      this->printErr("Unable to initialize write lock.");
+      return 0;
+    }
+
     // -------------------------------------------------------------------------
     // If data.csv file does not exsist create it
     // -------------------------------------------------------------------------
@@ -239,15 +265,6 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
     // Update data.csv file
     // -----------------------------------------------------------------
 
-    // Initilize file lock for remaining operations
-    boost::interprocess::file_lock flock(csvPath.data());
-    try {
-      // flock.lock();
-    } catch(boost::interprocess::interprocess_exception &e) {
-      this->printErr("Unable to initialize write lock.");
-      return 0;
-    }
-
     // read data.csv file
     auto csvTable = vtkSmartPointer<vtkTable>::New();
     {
@@ -437,6 +454,21 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
         (this->DatabasePath + "/" + rDataProductPath).data());
       imageWriter->SetInputData(inputAsID);
       imageWriter->Write();
+    } else if(this->Mode == 3) {
+      // Persistence diagram
+      if(!input->IsA("vtkUnstructuredGrid")) {
+        this->printErr(
+          "TPD format requires a persistence diagram (vtkUnstructuredGrid).");
+        return 0;
+      }
+
+      vtkNew<ttkPersistenceDiagramWriter> diagramWriter{};
+      diagramWriter->SetDebugLevel(this->debugLevel_);
+      diagramWriter->SetFileName(
+        (this->DatabasePath + "/" + rDataProductPath).data());
+      diagramWriter->SetInputData(input);
+      if(!diagramWriter->Write())
+        return 0;
     } else {
       // Topological Compression
       if(!input->IsA("vtkImageData")) {
@@ -461,6 +493,7 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
       topologicalCompressionWriter->SetSubdivide(this->Subdivide);
       topologicalCompressionWriter->SetUseTopologicalSimplification(
         this->UseTopologicalSimplification);
+      topologicalCompressionWriter->SetBrickSize(this->BrickSize);
 
       // Check that input scalar field is indeed scalar
       if(sf->GetNumberOfComponents() != 1) {
@@ -477,6 +510,12 @@ int ttkCinemaWriter::ProcessDataProduct(vtkDataObject *input) {
     this->printMsg("Writing data product to disk", 1, t.getElapsedTime(),
                    ttk::debug::LineMode::NEW, ttk::debug::Priority::DETAIL);
   }
+
+  // append the row of the product to the journal
+  if(this->UseJournal
+     && !this->appendRow(this->DatabasePath, fields, values, rDataProductPath))
+    return 0;
+
   this->printMsg("Wrote " + productId + "." + productExtension);
   this->printMsg(ttk::debug::Separator::L2, ttk::debug::Priority::DETAIL);
   return 1;
@@ -489,11 +528,14 @@ int ttkCinemaWriter::RequestData(vtkInformation *request,
 
   // Print Status
   {
-    std::string modeS
-      = this->Mode == 0 ? "VTK" : this->Mode == 1 ? "PNG" : "TTK";
+    std::string modeS = this->Mode == 0   ? "VTK"
+                        : this->Mode == 1 ? "PNG"
+                        : this->Mode == 3 ? "TPD"
+                                          : "TTK";
     this->printMsg({{"Database", this->DatabasePath},
                     {"C. Level", std::to_string(this->CompressionLevel)},
                     {"Format", modeS},
+                    {"Journal", this->UseJournal ? "Yes" : "No"},
                     {"Iterate", this->IterateMultiBlock ? "Yes" : "No"}});
     this->printMsg(ttk::debug::Separator::L1);
   }
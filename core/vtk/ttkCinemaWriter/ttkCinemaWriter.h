@@ -8,6 +8,12 @@
 /// This filter stores the input as a VTK dataset to disk and updates the
 /// data.csv file of a Cinema Spec D database.
 ///
+/// In journal mode (UseJournal), data.csv is not rewritten: the row of the
+/// product is appended to the journal of the current process, so that many
+/// concurrent writers (e.g. simulation ranks) scale. The journals are
+/// compacted into data.csv by CompactDatabase(), by the next writer not in
+/// journal mode, or when the database is read by ttkCinemaReader.
+///
 /// \param Input vtkDataSet to be stored (vtkDataSet)
 
 #pragma once
@@ -20,9 +26,14 @@
 #include <ttkCinemaWriterModule.h>
 
 // TTK Writer
+#include <ttkPersistenceDiagramWriter.h>
 #include <ttkTopologicalCompressionWriter.h>
 
-class TTKCINEMAWRITER_EXPORT ttkCinemaWriter : public ttkAlgorithm {
+// TTK includes
+#include <CinemaJournal.h>
+
+class TTKCINEMAWRITER_EXPORT ttkCinemaWriter : public ttkAlgorithm,
+                                              protected ttk::CinemaJournal {
 
 public:
   static ttkCinemaWriter *New();
@@ -43,7 +54,11 @@ public:
   vtkSetMacro(ForwardInput, bool);
   vtkGetMacro(ForwardInput, bool);
 
+  vtkSetMacro(UseJournal, bool);
+  vtkGetMacro(UseJournal, bool);
+
   int DeleteDatabase();
+  int CompactDatabase();
 
   vtkGetMacro(Tolerance, double);
   vtkSetMacro(Tolerance, double);
@@ -60,6 +75,8 @@ public:
   vtkGetMacro(UseTopologicalSimplification, bool);
   vtkSetMacro(UseTopologicalSimplification, bool);
   vtkSetMacro(SQMethodPV, int);
+  vtkGetMacro(BrickSize, int);
+  vtkSetMacro(BrickSize, int);
 
 protected:
   ttkCinemaWriter();
@@ -80,6 +97,7 @@ private:
   int CompressionLevel{5};
   bool IterateMultiBlock{true};
   bool ForwardInput{true};
+  bool UseJournal{false};
   int Mode{0};
 
   // topological compression
@@ -92,4 +110,5 @@ private:
   bool ZFPOnly{false};
   bool Subdivide{false};
   bool UseTopologicalSimplification{true};
+  int BrickSize{64};
 };
@@ -88,12 +88,16 @@ int ttkContinuousScatterPlot::RequestData(vtkInformation *request,
   }
 #endif
 
-  std::vector<std::vector<double>> density(ScatterplotResolution[0]);
-  std::vector<std::vector<char>> validPointMask(ScatterplotResolution[0]);
-  for(SimplexId k = 0; k < ScatterplotResolution[0]; ++k) {
-    density[k].resize(ScatterplotResolution[1], 0.0);
-    validPointMask[k].resize(ScatterplotResolution[1], 0);
-  }
+  // filled by the base code (index i * ScatterplotResolution[1] + j)
+  vtkNew<vtkCharArray> maskScalars;
+  maskScalars->SetNumberOfComponents(1);
+  maskScalars->SetNumberOfTuples(numberOfPixels);
+  maskScalars->SetName("ValidPointMask");
+
+  vtkNew<vtkDoubleArray> densityScalars;
+  densityScalars->SetNumberOfComponents(1);
+  densityScalars->SetNumberOfTuples(numberOfPixels);
+  densityScalars->SetName("Density");
 
   SimplexId numberOfPoints = input->GetNumberOfPoints();
 #ifndef TTK_ENABLE_KAMIKAZE
@@ -133,8 +137,10 @@ int ttkContinuousScatterPlot::RequestData(vtkInformation *request,
   this->setResolutions(ScatterplotResolution[0], ScatterplotResolution[1]);
   this->setScalarMin(scalarMin);
   this->setScalarMax(scalarMax);
-  this->setOutputDensity(&density);
-  this->setOutputMask(&validPointMask);
+  this->setOutputDensity(static_cast<double *>(
+    ttkUtils::GetVoidPointer(densityScalars.GetPointer())));
+  this->setOutputMask(
+    static_cast<char *>(ttkUtils::GetVoidPointer(maskScalars.GetPointer())));
 
   int status = 0;
   ttkVtkTemplateMacro(inputScalars1->GetDataType(), triangulation->getType(),
@@ -150,16 +156,6 @@ int ttkContinuousScatterPlot::RequestData(vtkInformation *request,
     return -6;
   }
 
-  vtkNew<vtkCharArray> maskScalars;
-  maskScalars->SetNumberOfComponents(1);
-  maskScalars->SetNumberOfTuples(numberOfPixels);
-  maskScalars->SetName("ValidPointMask");
-
-  vtkNew<vtkDoubleArray> densityScalars;
-  densityScalars->SetNumberOfComponents(1);
-  densityScalars->SetNumberOfTuples(numberOfPixels);
-  densityScalars->SetName("Density");
-
   vtkNew<vtkDoubleArray> scalars1;
   scalars1->SetNumberOfComponents(1);
   scalars1->SetNumberOfTuples(numberOfPixels);
@@ -200,10 +196,6 @@ int ttkContinuousScatterPlot::RequestData(vtkInformation *request,
       pts->SetPoint(id, x, y, 0);
 
       // scalars:
-      // valid mask
-      maskScalars->SetTuple1(id, validPointMask[i][j]);
-      // density
-      densityScalars->SetTuple1(id, density[i][j]);
       // original scalar fields
       double d1 = scalarMin[0] + i * delta[0];
       double d2 = scalarMin[1] + j * delta[1];
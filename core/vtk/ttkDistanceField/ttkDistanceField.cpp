@@ -116,6 +116,8 @@ int ttkDistanceField::RequestData(vtkInformation *request,
     ttkUtils::GetVoidPointer(identifiers));
   this->setOutputIdentifiers(ttkUtils::GetVoidPointer(origin));
   this->setOutputSegmentation(ttkUtils::GetVoidPointer(seg));
+  this->setMethod(static_cast<ttk::DistanceField::Method>(Method));
+  this->setDelta(Delta);
 
   vtkDataArray *distanceScalars{};
   switch(OutputScalarFieldType) {
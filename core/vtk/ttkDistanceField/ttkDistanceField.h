@@ -9,6 +9,11 @@
 /// identifiers attached to them) and produces a distance field to the closest
 /// source.
 ///
+/// The distances are computed in a single pass for all the sources, either
+/// with a multi-source Dijkstra propagation (Method 0) or with its parallel
+/// delta-stepping variant (Method 1, for large meshes), whose bucket width is
+/// given by Delta (0 for the mean edge length).
+///
 /// \param Input0 Input geometry, either 2D or 3D, either regular grid or
 /// triangulation (vtkDataSet)
 /// \param Input1 Input sources (vtkPointSet)
@@ -60,6 +65,12 @@ public:
   vtkSetMacro(ForceInputVertexScalarField, bool);
   vtkGetMacro(ForceInputVertexScalarField, bool);
 
+  vtkSetMacro(Method, int);
+  vtkGetMacro(Method, int);
+
+  vtkSetMacro(Delta, double);
+  vtkGetMacro(Delta, double);
+
 protected:
   ttkDistanceField();
   ~ttkDistanceField() override;
@@ -74,4 +85,6 @@ private:
   bool ForceInputVertexScalarField{false};
   int OutputScalarFieldType{DistanceType::Float};
   std::string OutputScalarFieldName{"DistanceFieldValues"};
+  int Method{0};
+  double Delta{0.0};
 };
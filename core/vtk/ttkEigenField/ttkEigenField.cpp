@@ -47,6 +47,13 @@ int ttkEigenField::RequestData(vtkInformation *request,
 
   this->preconditionTriangulation(*triangulation);
 
+  // the cached eigenfunctions are only valid for the same domain (vertex
+  // coordinates)
+  if(domain->GetMTime() != DomainMTime) {
+    this->clearEigenCache();
+    DomainMTime = domain->GetMTime();
+  }
+
   int res = 0;
 
   // array of eigenfunctions
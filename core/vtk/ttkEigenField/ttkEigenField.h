@@ -13,6 +13,9 @@
 /// triangulation (vtkDataSet)
 /// \param Output Output eigenfunctions (vtkDataSet)
 ///
+/// The eigenfunctions are kept between executions on the same domain, so
+/// that changing the output options does not trigger a new decomposition.
+///
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
@@ -72,6 +75,8 @@ private:
   unsigned int EigenNumber{500};
   // if statistics are to be computed
   bool ComputeStatistics{false};
+  // modification time of the domain of the cached eigenfunctions
+  vtkMTimeType DomainMTime{};
 
   // enum: float or double
   enum class FieldType { FLOAT, DOUBLE };
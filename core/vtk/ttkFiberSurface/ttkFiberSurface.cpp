@@ -101,9 +101,11 @@ int ttkFiberSurface::RequestData(vtkInformation *request,
   this->setPointMerging(PointMerge);
   this->setPointMergingThreshold(PointMergeDistanceThreshold);
 
+  const bool fieldModified = (dataUfield->GetMTime() > GetMTime())
+                             || (dataVfield->GetMTime() > GetMTime());
+
 #ifdef TTK_ENABLE_FIBER_SURFACE_WITH_RANGE_OCTREE
-  if((!RangeOctree) || (dataUfield->GetMTime() > GetMTime())
-     || (dataVfield->GetMTime() > GetMTime())) {
+  if((!RangeOctree) || fieldModified) {
 
     this->printMsg("Resetting octree...");
 
@@ -112,6 +114,15 @@ int ttkFiberSurface::RequestData(vtkInformation *request,
   }
 #endif
 
+  // only the moved polygon edges are extracted again in incremental mode,
+  // the cached surfaces are only valid for the same domain and fields
+  this->setIncrementalMode(IncrementalMode);
+  if(IncrementalMode && (fieldModified || input->GetMTime() != DomainMTime)) {
+    this->flushEdgeCache();
+    Modified();
+  }
+  DomainMTime = input->GetMTime();
+
   inputPolygon_.clear();
 
 #if !defined(_WIN32) || defined(_WIN32) && defined(VTK_USE_64BIT_IDS)
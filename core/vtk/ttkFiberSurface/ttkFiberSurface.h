@@ -75,6 +75,9 @@ public:
   vtkGetMacro(RangeOctree, bool);
   vtkSetMacro(RangeOctree, bool);
 
+  vtkGetMacro(IncrementalMode, bool);
+  vtkSetMacro(IncrementalMode, bool);
+
   vtkGetMacro(PointMergeDistanceThreshold, double);
   vtkSetMacro(PointMergeDistanceThreshold, double);
 
@@ -92,9 +95,12 @@ protected:
 
 private:
   bool RangeCoordinates{true}, EdgeParameterization{true}, EdgeIds{true},
-    TetIds{true}, CaseIds{true}, RangeOctree{true}, PointMerge{false};
+    TetIds{true}, CaseIds{true}, RangeOctree{true}, PointMerge{false},
+    IncrementalMode{false};
 
   double PointMergeDistanceThreshold{0.000001};
+  // modification time of the domain of the cached edge surfaces
+  vtkMTimeType DomainMTime{};
 
   // NOTE: we assume here that this guy is small and that making a copy from
   // VTK is not an issue.
@@ -47,6 +47,52 @@ int addRecursivelyToFieldData(vtkDataObject *object,
   return 1;
 }
 
+int ttkForEach::prefetchRows(vtkTable *table, const int iteration) {
+  if(this->LookAhead < 1) {
+    return 1;
+  }
+  auto paths = table->GetColumnByName(this->FilepathColumnName.data());
+  if(paths == nullptr) {
+    return 1;
+  }
+
+  // a new loop starts
+  if(iteration == 0 || iteration > this->LastPrefetchedRow + 1) {
+    this->LastPrefetchedRow = iteration;
+  }
+
+  // rows not prefetched yet, the files of one row are prefetched while the
+  // LookAhead previous ones are processed
+  const int last
+    = std::min(iteration + this->LookAhead, (int)table->GetNumberOfRows() - 1);
+  int nFiles = 0;
+  for(int i = this->LastPrefetchedRow + 1; i <= last; i++) {
+    const auto path = paths->GetVariantValue(i).ToString();
+    if(ttk::OsCall::prefetchFile(path) == 0)
+      nFiles++;
+
+    // multiblock products store their blocks in a folder
+    const auto dot = path.find_last_of('.');
+    if(dot != std::string::npos && path.substr(dot) == ".vtm") {
+      const auto folder = path.substr(0, dot);
+      if(ttk::OsCall::getFileModificationTime(folder) >= 0) {
+        for(const auto &file : ttk::OsCall::listFilesInDirectory(folder, ""))
+          if(ttk::OsCall::prefetchFile(file) == 0)
+            nFiles++;
+      }
+    }
+  }
+  if(last > this->LastPrefetchedRow) {
+    this->printMsg("Prefetching " + std::to_string(nFiles) + " file(s) of rows "
+                     + std::to_string(this->LastPrefetchedRow + 1) + "-"
+                     + std::to_string(last),
+                   ttk::debug::Priority::DETAIL);
+    this->LastPrefetchedRow = last;
+  }
+
+  return 1;
+}
+
 int ttkForEach::RequestData(vtkInformation *request,
                             vtkInformationVector **inputVector,
                             vtkInformationVector *outputVector) {
@@ -94,6 +140,9 @@ int ttkForEach::RequestData(vtkInformation *request,
       return 0;
     }
     iterationInformation->SetValue(1, ((vtkTable *)input)->GetNumberOfRows());
+
+    // read-ahead of the next iterations
+    this->prefetchRows((vtkTable *)input, (int)iterationIndex);
   } else if(mode == 3) {
     auto inputArray = this->GetInputArrayToProcess(0, inputVector);
     if(!inputArray) {
@@ -9,6 +9,12 @@
 /// This filter works in conjunction with the ttkEndFor filter to iterate over
 /// blocks, rows, array values, and arrays.
 ///
+/// When iterating over the rows of a table referencing files (e.g. a Cinema
+/// database), the files of the next LookAhead rows are prefetched in the
+/// background (asynchronous read-ahead in the page cache of the system)
+/// while the current iteration is processed, which hides the read latency of
+/// the readers of the loop body.
+///
 /// \param Input vktObject either a vtkMultiBlockDataSet, vtkTable, or
 /// vtkDataSet \param Output vktObject one element of the input
 
@@ -20,12 +26,20 @@
 // TTK includes
 #include <ttkExtract.h>
 
+class vtkTable;
+
 class TTKFOREACH_EXPORT ttkForEach : public ttkExtract {
 
 public:
   static ttkForEach *New();
   vtkTypeMacro(ttkForEach, ttkExtract);
 
+  vtkSetMacro(LookAhead, int);
+  vtkGetMacro(LookAhead, int);
+
+  vtkSetMacro(FilepathColumnName, std::string);
+  vtkGetMacro(FilepathColumnName, std::string);
+
 protected:
   ttkForEach();
   ~ttkForEach();
@@ -36,4 +50,14 @@ protected:
   int RequestData(vtkInformation *request,
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
+
+  /// Prefetch the files of the rows following the current iteration
+  int prefetchRows(vtkTable *table, const int iteration);
+
+private:
+  int LookAhead{0};
+  std::string FilepathColumnName{"FILE"};
+
+  // last row whose files have been prefetched
+  int LastPrefetchedRow{-1};
 };
\ No newline at end of file
@@ -52,6 +52,13 @@ int ttkHarmonicField::RequestData(vtkInformation *request,
   }
   this->preconditionTriangulation(*triangulation, UseCotanWeights);
 
+  // the cached Laplacian and factorization are only valid for the same
+  // domain (vertex coordinates)
+  if(domain->GetMTime() != DomainMTime) {
+    this->clearSolverCache();
+    DomainMTime = domain->GetMTime();
+  }
+
   vtkDataArray *inputField = this->GetInputArrayToProcess(0, identifiers);
   vtkDataArray *vertsid
     = this->GetInputArrayInformation(1) && this->ForceConstraintIdentifiers
@@ -73,6 +80,8 @@ int ttkHarmonicField::RequestData(vtkInformation *request,
 
   const auto nVerts = domain->GetNumberOfPoints();
   const auto nSources = identifiers->GetNumberOfPoints();
+  // one harmonic field per constraint component, solved at once
+  const auto nFields = inputField->GetNumberOfComponents();
 
   vtkSmartPointer<vtkDataArray> outputField{};
 
@@ -94,25 +103,25 @@ int ttkHarmonicField::RequestData(vtkInformation *request,
     return 0;
   }
 
-  outputField->SetNumberOfComponents(1);
+  outputField->SetNumberOfComponents(nFields);
   outputField->SetNumberOfTuples(nVerts);
   outputField->SetName(OutputScalarFieldName.data());
   int res{};
 
   switch(OutputScalarFieldType) {
     case FieldType::FLOAT:
-      res = this->execute<float>(
+      res = this->executeMultiple<float>(
         *triangulation, nSources,
         static_cast<ttk::SimplexId *>(ttkUtils::GetVoidPointer(vertsid)),
-        static_cast<float *>(ttkUtils::GetVoidPointer(inputField)),
+        static_cast<float *>(ttkUtils::GetVoidPointer(inputField)), nFields,
         static_cast<float *>(ttkUtils::GetVoidPointer(outputField)),
         UseCotanWeights, SolvingMethod, LogAlpha);
       break;
     case FieldType::DOUBLE:
-      res = this->execute<double>(
+      res = this->executeMultiple<double>(
         *triangulation, nSources,
         static_cast<ttk::SimplexId *>(ttkUtils::GetVoidPointer(vertsid)),
-        static_cast<double *>(ttkUtils::GetVoidPointer(inputField)),
+        static_cast<double *>(ttkUtils::GetVoidPointer(inputField)), nFields,
         static_cast<double *>(ttkUtils::GetVoidPointer(outputField)),
         UseCotanWeights, SolvingMethod, LogAlpha);
       break;
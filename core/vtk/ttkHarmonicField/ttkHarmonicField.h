@@ -14,6 +14,11 @@
 /// \param Input1 List of critical point constraints (vtkPointSet)
 /// \param Output Output harmonic scalar field (vtkDataSet)
 ///
+/// A multi-component constraint array produces one harmonic field per
+/// component, computed with a single factorization. The factorization is
+/// kept between executions on the same domain, so that updating the
+/// constraint values only triggers a new solve.
+///
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
@@ -106,6 +111,8 @@ private:
   SolvingMethodUserType SolvingMethod{SolvingMethodUserType::AUTO};
   // penalty value
   double LogAlpha{5.0};
+  // modification time of the domain of the cached solver
+  vtkMTimeType DomainMTime{};
 
   // enum: float or double
   enum class FieldType { FLOAT, DOUBLE };
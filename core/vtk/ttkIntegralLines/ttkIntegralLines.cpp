@@ -116,15 +116,83 @@ int ttkIntegralLines::getTrajectories(vtkDataSet *input,
   return 0;
 }
 
+int ttkIntegralLines::getSharedTrajectories(
+  vtkDataSet *input,
+  ttk::Triangulation *triangulation,
+  const SharedTrajectories &trajectories,
+  vtkUnstructuredGrid *output) {
+  const SimplexId pointNumber = trajectories.vertices.size();
+
+  vtkSmartPointer<vtkUnstructuredGrid> ug
+    = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+  pts->SetNumberOfPoints(pointNumber);
+  vtkSmartPointer<vtkFloatArray> dist = vtkSmartPointer<vtkFloatArray>::New();
+  dist->SetNumberOfComponents(1);
+  dist->SetNumberOfTuples(pointNumber);
+  dist->SetName("DistanceToExtremum");
+  vtkSmartPointer<ttkSimplexIdTypeArray> extremum
+    = vtkSmartPointer<ttkSimplexIdTypeArray>::New();
+  extremum->SetNumberOfComponents(1);
+  extremum->SetNumberOfTuples(pointNumber);
+  extremum->SetName("ExtremumId");
+
+  float p[3];
+  for(SimplexId i = 0; i < pointNumber; ++i) {
+    triangulation->getVertexPoint(trajectories.vertices[i], p[0], p[1], p[2]);
+    pts->SetPoint(i, p);
+    dist->SetTuple1(i, trajectories.distanceToExtremum[i]);
+    extremum->SetTuple1(i, trajectories.extremum[i]);
+  }
+
+  // one segment per point, to its successor
+  vtkIdType ids[2];
+  for(SimplexId i = 0; i < pointNumber; ++i) {
+    if(trajectories.next[i] != -1) {
+      ids[0] = i;
+      ids[1] = trajectories.next[i];
+      ug->InsertNextCell(VTK_LINE, 2, ids);
+    }
+  }
+
+  // here, copy the original scalars
+  vtkPointData *inputPointData = input->GetPointData();
+  for(int k = 0; k < inputPointData->GetNumberOfArrays(); ++k) {
+    vtkDataArray *a = inputPointData->GetArray(k);
+    if(a == nullptr || a->GetNumberOfComponents() != 1)
+      continue;
+    vtkSmartPointer<vtkDataArray> scalars
+      = vtkSmartPointer<vtkDataArray>::Take(a->NewInstance());
+    scalars->SetName(a->GetName());
+    scalars->SetNumberOfComponents(1);
+    scalars->SetNumberOfTuples(pointNumber);
+    for(SimplexId i = 0; i < pointNumber; ++i)
+      scalars->SetTuple(i, trajectories.vertices[i], a);
+    ug->GetPointData()->AddArray(scalars);
+  }
+
+  ug->SetPoints(pts);
+  ug->GetPointData()->AddArray(dist);
+  ug->GetPointData()->AddArray(extremum);
+
+  output->ShallowCopy(ug);
+
+  return 0;
+}
+
 template <typename VTK_TT, typename TTK_TT>
 int ttkIntegralLines::dispatch(int inputOffsetsDataType,
                                const TTK_TT *triangulation) {
   int ret = 0;
   if(inputOffsetsDataType == VTK_INT) {
-    ret = this->execute<VTK_TT, int, TTK_TT>(triangulation);
+    ret = SharedPaths
+            ? this->executeShared<VTK_TT, int, TTK_TT>(triangulation)
+            : this->execute<VTK_TT, int, TTK_TT>(triangulation);
   }
   if(inputOffsetsDataType == VTK_ID_TYPE) {
-    ret = this->execute<VTK_TT, vtkIdType, TTK_TT>(triangulation);
+    ret = SharedPaths
+            ? this->executeShared<VTK_TT, vtkIdType, TTK_TT>(triangulation)
+            : this->execute<VTK_TT, vtkIdType, TTK_TT>(triangulation);
   }
   return ret;
 }
@@ -192,6 +260,7 @@ int ttkIntegralLines::RequestData(vtkInformation *request,
 #endif
 
   vector<vector<SimplexId>> trajectories;
+  SharedTrajectories sharedTrajectories;
 
   this->setVertexNumber(numberOfPointsInDomain);
   this->setSeedNumber(numberOfPointsInSeeds);
@@ -201,6 +270,7 @@ int ttkIntegralLines::RequestData(vtkInformation *request,
 
   this->setVertexIdentifierScalarField(inputIdentifiers->GetVoidPointer(0));
   this->setOutputTrajectories(&trajectories);
+  this->setOutputSharedTrajectories(&sharedTrajectories);
 
   this->preconditionTriangulation(triangulation);
 
@@ -220,7 +290,10 @@ int ttkIntegralLines::RequestData(vtkInformation *request,
 #endif
 
   // make the vtk trajectories
-  getTrajectories(domain, triangulation, trajectories, output);
+  if(SharedPaths)
+    getSharedTrajectories(domain, triangulation, sharedTrajectories, output);
+  else
+    getTrajectories(domain, triangulation, trajectories, output);
 
   return (int)(status == 0);
 }
@@ -47,6 +47,12 @@
 /// \note: To use this optional array, `ForceInputVertexScalarField` needs to be
 /// enabled with the setter `setForceInputVertexScalarField()'.
 ///
+/// With the SharedPaths option, the lines are traced with shared suffixes:
+/// each vertex reached by the lines is emitted only once, with a segment to
+/// its successor, and the output stores the extremum reached from each point
+/// ("ExtremumId") and the distance to it ("DistanceToExtremum") instead of the
+/// distance from the seed.
+///
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
@@ -84,11 +90,19 @@ public:
   vtkSetMacro(ForceInputOffsetScalarField, bool);
   vtkGetMacro(ForceInputOffsetScalarField, bool);
 
+  vtkSetMacro(SharedPaths, bool);
+  vtkGetMacro(SharedPaths, bool);
+
   int getTrajectories(vtkDataSet *input,
                       ttk::Triangulation *triangulation,
                       std::vector<std::vector<ttk::SimplexId>> &trajectories,
                       vtkUnstructuredGrid *output);
 
+  int getSharedTrajectories(vtkDataSet *input,
+                            ttk::Triangulation *triangulation,
+                            const SharedTrajectories &trajectories,
+                            vtkUnstructuredGrid *output);
+
   template <typename VTK_TT, typename TTK_TT>
   int dispatch(int, const TTK_TT *);
 
@@ -106,4 +120,5 @@ private:
   int Direction{0};
   bool ForceInputVertexScalarField{false};
   bool ForceInputOffsetScalarField{false};
+  bool SharedPaths{false};
 };
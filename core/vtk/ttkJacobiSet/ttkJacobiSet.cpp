@@ -43,10 +43,19 @@ template <class dataTypeU, class dataTypeV>
 int ttkJacobiSet::dispatch(const dataTypeU *const uField,
                            const dataTypeV *const vField,
                            ttk::Triangulation *const triangulation) {
-  ttkTemplateMacro(
-    triangulation->getType(),
-    this->execute(jacobiSet_, uField, vField,
-                  *static_cast<TTK_TT *>(triangulation->getData())));
+  if(EdgeTypes) {
+    jacobiEdges_.clear();
+    ttkTemplateMacro(
+      triangulation->getType(),
+      this->execute(jacobiSet_, uField, vField,
+                    *static_cast<TTK_TT *>(triangulation->getData())));
+  } else {
+    jacobiSet_.clear();
+    ttkTemplateMacro(
+      triangulation->getType(),
+      this->execute(jacobiEdges_, uField, vField,
+                    *static_cast<TTK_TT *>(triangulation->getData())));
+  }
   return 0;
 }
 
@@ -118,14 +127,21 @@ int ttkJacobiSet::RequestData(vtkInformation *request,
   }
 #endif // TTK_ENABLE_DOUBLE_TEMPLATING
 
+  const size_t nEdges = EdgeTypes ? jacobiSet_.size() : jacobiEdges_.size();
+  const auto edgeId = [this](const size_t i) {
+    return EdgeTypes ? jacobiSet_[i].first : jacobiEdges_[i];
+  };
+
   vtkNew<vtkSignedCharArray> edgeTypes{};
 
-  edgeTypes->SetNumberOfComponents(1);
-  edgeTypes->SetNumberOfTuples(2 * jacobiSet_.size());
-  edgeTypes->SetName("Critical Type");
+  if(EdgeTypes) {
+    edgeTypes->SetNumberOfComponents(1);
+    edgeTypes->SetNumberOfTuples(2 * nEdges);
+    edgeTypes->SetName("Critical Type");
+  }
 
   vtkNew<vtkPoints> pointSet{};
-  pointSet->SetNumberOfPoints(2 * jacobiSet_.size());
+  pointSet->SetNumberOfPoints(2 * nEdges);
 
   vtkNew<vtkCellArray> cellArray{};
   vtkNew<vtkIdList> idList{};
@@ -133,22 +149,23 @@ int ttkJacobiSet::RequestData(vtkInformation *request,
 
   size_t pointCount = 0;
   std::array<double, 3> p{};
-  for(size_t i = 0; i < jacobiSet_.size(); i++) {
+  for(size_t i = 0; i < nEdges; i++) {
 
-    int edgeId = jacobiSet_[i].first;
     int vertexId0 = -1, vertexId1 = -1;
-    triangulation->getEdgeVertex(edgeId, 0, vertexId0);
-    triangulation->getEdgeVertex(edgeId, 1, vertexId1);
+    triangulation->getEdgeVertex(edgeId(i), 0, vertexId0);
+    triangulation->getEdgeVertex(edgeId(i), 1, vertexId1);
 
     input->GetPoint(vertexId0, p.data());
     pointSet->SetPoint(pointCount, p.data());
-    edgeTypes->SetTuple1(pointCount, (float)jacobiSet_[i].second);
+    if(EdgeTypes)
+      edgeTypes->SetTuple1(pointCount, (float)jacobiSet_[i].second);
     idList->SetId(0, pointCount);
     pointCount++;
 
     input->GetPoint(vertexId1, p.data());
     pointSet->SetPoint(pointCount, p.data());
-    edgeTypes->SetTuple1(pointCount, (float)jacobiSet_[i].second);
+    if(EdgeTypes)
+      edgeTypes->SetTuple1(pointCount, (float)jacobiSet_[i].second);
     idList->SetId(1, pointCount);
     pointCount++;
 
@@ -156,17 +173,21 @@ int ttkJacobiSet::RequestData(vtkInformation *request,
   }
   output->SetPoints(pointSet);
   output->SetCells(VTK_LINE, cellArray);
-  output->GetPointData()->AddArray(edgeTypes);
+  if(EdgeTypes) {
+    output->GetPointData()->AddArray(edgeTypes);
+  } else {
+    output->GetPointData()->RemoveArray("Critical Type");
+  }
 
   if(EdgeIds) {
     vtkNew<ttkSimplexIdTypeArray> edgeIdArray{};
     edgeIdArray->SetNumberOfComponents(1);
-    edgeIdArray->SetNumberOfTuples(jacobiSet_.size());
+    edgeIdArray->SetNumberOfTuples(nEdges);
     edgeIdArray->SetName("EdgeIds");
 
     pointCount = 0;
-    for(size_t i = 0; i < jacobiSet_.size(); i++) {
-      edgeIdArray->SetTuple1(pointCount, (float)jacobiSet_[i].first);
+    for(size_t i = 0; i < nEdges; i++) {
+      edgeIdArray->SetTuple1(pointCount, (float)edgeId(i));
       pointCount++;
     }
 
@@ -183,15 +204,14 @@ int ttkJacobiSet::RequestData(vtkInformation *request,
       vtkSmartPointer<vtkDataArray> scalarArray{scalarField->NewInstance()};
 
       scalarArray->SetNumberOfComponents(scalarField->GetNumberOfComponents());
-      scalarArray->SetNumberOfTuples(2 * jacobiSet_.size());
+      scalarArray->SetNumberOfTuples(2 * nEdges);
       scalarArray->SetName(scalarField->GetName());
       std::vector<double> value(scalarField->GetNumberOfComponents());
 
-      for(size_t j = 0; j < jacobiSet_.size(); j++) {
-        int edgeId = jacobiSet_[j].first;
+      for(size_t j = 0; j < nEdges; j++) {
         int vertexId0 = -1, vertexId1 = -1;
-        triangulation->getEdgeVertex(edgeId, 0, vertexId0);
-        triangulation->getEdgeVertex(edgeId, 1, vertexId1);
+        triangulation->getEdgeVertex(edgeId(j), 0, vertexId0);
+        triangulation->getEdgeVertex(edgeId(j), 1, vertexId1);
 
         scalarField->GetTuple(vertexId0, value.data());
         scalarArray->SetTuple(2 * j, value.data());
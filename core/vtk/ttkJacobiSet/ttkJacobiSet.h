@@ -8,7 +8,9 @@
 ///
 /// Given a bivariate scalar field defined on a PL 3-manifold, this filter
 /// produces the list of Jacobi edges (each entry is a pair given by the edge
-/// identifier and the Jacobi edge type).
+/// identifier and the Jacobi edge type). When EdgeTypes is disabled, only the
+/// edge identifiers are computed (smaller memory footprint) and the output
+/// has no "Critical Type" array.
 ///
 /// The input bivariate data must be provided as two independent scalar fields
 /// attached as point data to the input geometry.
@@ -66,6 +68,9 @@ public:
   vtkGetMacro(ForceInputOffsetScalarField, bool);
   vtkSetMacro(ForceInputOffsetScalarField, bool);
 
+  vtkSetMacro(EdgeTypes, bool);
+  vtkGetMacro(EdgeTypes, bool);
+
   vtkSetMacro(EdgeIds, bool);
   vtkGetMacro(EdgeIds, bool);
 
@@ -88,7 +93,7 @@ protected:
 
 private:
   bool ForceInputOffsetScalarField{false};
-  bool EdgeIds{false}, VertexScalars{false};
+  bool EdgeTypes{true}, EdgeIds{false}, VertexScalars{false};
   std::vector<std::pair<ttk::SimplexId, ttk::SimplexId>> edgeList_{};
   // for each edge, one skeleton of its triangle fan
   std::vector<std::vector<std::pair<ttk::SimplexId, ttk::SimplexId>>>
@@ -96,5 +101,7 @@ private:
   // for each edge, the one skeleton of its triangle fan
   std::vector<std::vector<ttk::SimplexId>> edgeFans_{};
   std::vector<std::pair<ttk::SimplexId, char>> jacobiSet_{};
+  // Jacobi edge identifiers only (when EdgeTypes is disabled)
+  std::vector<ttk::SimplexId> jacobiEdges_{};
   std::vector<ttk::SimplexId> sosOffsetsU_{}, sosOffsetsV_{};
 };
@@ -9,7 +9,7 @@ using namespace ttk;
 vtkStandardNewMacro(ttkPersistenceDiagramClustering)
 
   ttkPersistenceDiagramClustering::ttkPersistenceDiagramClustering() {
-  SetNumberOfInputPorts(1);
+  SetNumberOfInputPorts(2);
   SetNumberOfOutputPorts(3);
 }
 
@@ -17,7 +17,11 @@ int ttkPersistenceDiagramClustering::FillInputPortInformation(
   int port, vtkInformation *info) {
   if(port == 0)
     info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkMultiBlockDataSet");
-  else
+  else if(port == 1) {
+    // optional centroids of a previous run, to warm-start the clustering
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+    info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+  } else
     return 0;
   return 1;
 }
@@ -57,6 +61,12 @@ int ttkPersistenceDiagramClustering::RequestData(
     }
   }
 
+  auto initialCentroids = vtkUnstructuredGrid::GetData(inputVector[1], 0);
+  if(initialCentroids != nullptr
+     && this->GetMTime() < initialCentroids->GetMTime()) {
+    needUpdate_ = true;
+  }
+
   // Set outputs
   auto output_clusters = vtkUnstructuredGrid::SafeDownCast(
     outputVector->GetInformationObject(0)->Get(vtkDataObject::DATA_OBJECT()));
@@ -92,6 +102,13 @@ int ttkPersistenceDiagramClustering::RequestData(
         TimeLimit = 999999999;
       }
 
+      if(initialCentroids != nullptr
+         && this->getInitialCentroids(initialCentroids) == 0) {
+        this->setInitialCentroids(&initial_centroids_, &initial_prices_);
+      } else {
+        this->setInitialCentroids(nullptr);
+      }
+
       inv_clustering_ = this->execute<double>(
         intermediateDiagrams_, final_centroids_, all_matchings_);
 
@@ -100,6 +117,7 @@ int ttkPersistenceDiagramClustering::RequestData(
 
     else {
       // AUCTION APPROACH
+      CentroidPrices.clear();
       final_centroids_.resize(1);
       inv_clustering_.resize(numInputs);
       for(int i_input = 0; i_input < numInputs; i_input++) {
@@ -309,6 +327,78 @@ double ttkPersistenceDiagramClustering::getPersistenceDiagram(
   return max_dimension;
 }
 
+int ttkPersistenceDiagramClustering::getInitialCentroids(
+  vtkUnstructuredGrid *centroids) {
+
+  initial_centroids_.clear();
+  initial_prices_.clear();
+
+  const auto points = centroids->GetPoints();
+  const auto nodeType = vtkIntArray::SafeDownCast(
+    centroids->GetPointData()->GetArray("CriticalType"));
+  const auto clusterId = vtkIntArray::SafeDownCast(
+    centroids->GetPointData()->GetArray("ClusterID"));
+  const auto coordinates = vtkFloatArray::SafeDownCast(
+    centroids->GetPointData()->GetArray("Coordinates"));
+  const auto pairType = vtkIntArray::SafeDownCast(
+    centroids->GetCellData()->GetArray("PairType"));
+  // prices are optional
+  const auto price = vtkDoubleArray::SafeDownCast(
+    centroids->GetCellData()->GetArray("Price"));
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(points == nullptr || nodeType == nullptr || clusterId == nullptr
+     || pairType == nullptr) {
+    this->printWrn("Initial centroids are not a centroids output, ignoring");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  const auto nPairs = centroids->GetNumberOfCells();
+  for(vtkIdType i = 0; i < nPairs; ++i) {
+    const auto i0 = 2 * i;
+    const auto i1 = 2 * i + 1;
+    const int c = clusterId->GetValue(i0);
+    if(c < 0) {
+      continue;
+    }
+    if(c >= (int)initial_centroids_.size()) {
+      initial_centroids_.resize(c + 1);
+      initial_prices_.resize(c + 1);
+    }
+
+    // the birth is stored as the ordinate of the first point, which is not
+    // shifted by the display options
+    const double birth = points->GetPoint(i0)[1];
+    const double death = points->GetPoint(i1)[1];
+    std::array<float, 3> coords{};
+    if(coordinates != nullptr) {
+      coordinates->GetTypedTuple(i0, coords.data());
+    }
+
+    const auto type = [](const int t) {
+      switch(t) {
+        case 0:
+          return CriticalType::Local_minimum;
+        case 1:
+          return CriticalType::Saddle1;
+        case 2:
+          return CriticalType::Saddle2;
+        default:
+          return CriticalType::Local_maximum;
+      }
+    };
+
+    initial_centroids_[c].emplace_back(
+      -1, type(nodeType->GetValue(i0)), -1, type(nodeType->GetValue(i1)),
+      death - birth, pairType->GetValue(i), birth, coords[0], coords[1],
+      coords[2], death, coords[0], coords[1], coords[2]);
+    initial_prices_[c].push_back(price != nullptr ? price->GetValue(i) : 0.0);
+  }
+
+  return 0;
+}
+
 vtkSmartPointer<vtkUnstructuredGrid>
   ttkPersistenceDiagramClustering::createOutputCentroids() {
   this->printMsg("Creating vtk diagrams", debug::Priority::VERBOSE);
@@ -338,6 +428,12 @@ vtkSmartPointer<vtkUnstructuredGrid>
   coordsScalars->SetNumberOfComponents(3);
   coordsScalars->SetName("Coordinates");
 
+  // auction prices of the centroid pairs, to warm-start another clustering
+  vtkNew<vtkDoubleArray> priceScalars{};
+  priceScalars->SetName("Price");
+
+  const auto &prices = this->getCentroidPrices();
+
   int count = 0;
   for(unsigned int j = 0; j < final_centroids_.size(); ++j) {
     const std::vector<diagramType> &diagram = final_centroids_[j];
@@ -446,6 +542,8 @@ vtkSmartPointer<vtkUnstructuredGrid>
         default:
           pairType->InsertTuple1(count, 0);
       }
+      const bool hasPrice = j < prices.size() && i < prices[j].size();
+      priceScalars->InsertTuple1(count, hasPrice ? prices[j][i] : 0.0);
       count++;
     }
   }
@@ -454,6 +552,7 @@ vtkSmartPointer<vtkUnstructuredGrid>
   persistenceDiagram->GetCellData()->AddArray(persistenceScalars);
   persistenceDiagram->GetCellData()->AddArray(pairType);
   persistenceDiagram->GetCellData()->AddArray(idOfPair);
+  persistenceDiagram->GetCellData()->AddArray(priceScalars);
   persistenceDiagram->GetPointData()->AddArray(nodeType);
   persistenceDiagram->GetPointData()->AddArray(coordsScalars);
   persistenceDiagram->GetPointData()->AddArray(idOfDiagramPoint);
@@ -209,6 +209,41 @@ public:
   }
   vtkGetMacro(PairTypeClustering, int);
 
+  void SetMiniBatchSize(int data) {
+    MiniBatchSize = data;
+    Modified();
+    needUpdate_ = true;
+  }
+  vtkGetMacro(MiniBatchSize, int);
+
+  void SetDistanceBackend(int data) {
+    DistanceBackend = data;
+    Modified();
+    needUpdate_ = true;
+  }
+  vtkGetMacro(DistanceBackend, int);
+
+  void SetNumberOfDirections(int data) {
+    NumberOfDirections = data;
+    Modified();
+    needUpdate_ = true;
+  }
+  vtkGetMacro(NumberOfDirections, int);
+
+  void SetImageResolution(int data) {
+    ImageResolution = data;
+    Modified();
+    needUpdate_ = true;
+  }
+  vtkGetMacro(ImageResolution, int);
+
+  void SetImageSigma(double data) {
+    ImageSigma = data;
+    Modified();
+    needUpdate_ = true;
+  }
+  vtkGetMacro(ImageSigma, double);
+
   void SetSpacing(double spacing) {
     Spacing = spacing;
     oldSpacing = spacing;
@@ -259,25 +294,11 @@ public:
 protected:
   ttkPersistenceDiagramClustering();
 
-  using diagramType = std::tuple<ttk::SimplexId,
-                                 ttk::CriticalType,
-                                 ttk::SimplexId,
-                                 ttk::CriticalType,
-                                 double,
-                                 ttk::SimplexId,
-                                 double,
-                                 float,
-                                 float,
-                                 float,
-                                 double,
-                                 float,
-                                 float,
-                                 float>;
-
   using matchingType = std::tuple<ttk::SimplexId, ttk::SimplexId, double>;
 
   double getPersistenceDiagram(std::vector<diagramType> &diagram,
                                vtkUnstructuredGrid *CTPersistenceDiagram_);
+  int getInitialCentroids(vtkUnstructuredGrid *centroids);
 
   int FillInputPortInformation(int port, vtkInformation *info) override;
   int FillOutputPortInformation(int port, vtkInformation *info) override;
@@ -294,6 +315,8 @@ private:
   std::vector<std::vector<diagramType>> intermediateDiagrams_{};
   std::vector<std::vector<std::vector<matchingType>>> all_matchings_{};
   std::vector<std::vector<diagramType>> final_centroids_{};
+  std::vector<std::vector<diagramType>> initial_centroids_{};
+  std::vector<std::vector<double>> initial_prices_{};
   std::vector<int> inv_clustering_{};
 
   // vtkUnstructuredGrid* output_clusters_;
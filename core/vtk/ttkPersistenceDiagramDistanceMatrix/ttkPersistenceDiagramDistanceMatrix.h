@@ -116,6 +116,31 @@ public:
     return -1;
   }
 
+  void SetDistanceBackend(const int arg_) {
+    this->setDistanceBackend(arg_);
+    this->Modified();
+  }
+  int GetDistanceBackend() {
+    switch(this->Backend) {
+      case DistanceBackend::AUCTION:
+        return 0;
+      case DistanceBackend::SLICED_WASSERSTEIN:
+        return 1;
+      case DistanceBackend::PERSISTENCE_IMAGES:
+        return 2;
+    }
+    return -1;
+  }
+
+  vtkSetMacro(NumberOfDirections, int);
+  vtkGetMacro(NumberOfDirections, int);
+
+  vtkSetMacro(ImageResolution, int);
+  vtkGetMacro(ImageResolution, int);
+
+  vtkSetMacro(ImageSigma, double);
+  vtkGetMacro(ImageSigma, double);
+
   vtkSetMacro(MaxNumberOfPairs, unsigned int);
   vtkGetMacro(MaxNumberOfPairs, unsigned int);
 
@@ -0,0 +1,319 @@
+#include <ttkPersistenceDiagramIndex.h>
+
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkInformation.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkTable.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXMLGenericDataObjectReader.h>
+
+#include <unordered_map>
+
+vtkStandardNewMacro(ttkPersistenceDiagramIndex);
+
+ttkPersistenceDiagramIndex::ttkPersistenceDiagramIndex() {
+  this->SetNumberOfInputPorts(2);
+  this->SetNumberOfOutputPorts(1);
+}
+
+int ttkPersistenceDiagramIndex::FillInputPortInformation(int port,
+                                                         vtkInformation *info) {
+  if(port == 0) {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+    return 1;
+  } else if(port == 1) {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
+    return 1;
+  }
+  return 0;
+}
+
+int ttkPersistenceDiagramIndex::FillOutputPortInformation(
+  int port, vtkInformation *info) {
+  if(port == 0) {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkTable");
+    return 1;
+  }
+  return 0;
+}
+
+int ttkPersistenceDiagramIndex::getPairDiagram(vtkUnstructuredGrid *vtu,
+                                               PairDiagram &diagram) const {
+
+  const auto pd = vtu->GetPointData();
+  const auto cd = vtu->GetCellData();
+  const auto points = vtu->GetPoints();
+
+  const auto nodeTypeScalars
+    = vtkIntArray::SafeDownCast(pd->GetArray("CriticalType"));
+  const auto pairTypeScalars
+    = vtkIntArray::SafeDownCast(cd->GetArray("PairType"));
+  const auto birthScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Birth"));
+  const auto deathScalars = vtkDoubleArray::SafeDownCast(pd->GetArray("Death"));
+
+  const bool embed = birthScalars != nullptr && deathScalars != nullptr;
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(points == nullptr || nodeTypeScalars == nullptr
+     || pairTypeScalars == nullptr) {
+    this->printErr("Input is not a persistence diagram");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  for(auto &pairs : diagram) {
+    pairs.clear();
+  }
+
+  const auto nPairs = pairTypeScalars->GetNumberOfTuples();
+  for(vtkIdType i = 0; i < nPairs; ++i) {
+    // skip the diagonal
+    if(pairTypeScalars->GetValue(i) == -1) {
+      continue;
+    }
+
+    double birth, death;
+    if(embed) {
+      birth = birthScalars->GetValue(2 * i);
+      death = deathScalars->GetValue(2 * i + 1);
+    } else {
+      birth = points->GetPoint(2 * i)[0];
+      death = points->GetPoint(2 * i + 1)[1];
+    }
+    if(death <= birth) {
+      continue;
+    }
+
+    const auto nt1
+      = static_cast<ttk::CriticalType>(nodeTypeScalars->GetValue(2 * i));
+    const auto nt2
+      = static_cast<ttk::CriticalType>(nodeTypeScalars->GetValue(2 * i + 1));
+
+    // the global min-max pair belongs to both the min-saddle and the
+    // saddle-max diagrams
+    if(nt1 == ttk::CriticalType::Local_minimum) {
+      diagram[0].emplace_back(birth, death);
+    }
+    if(nt2 == ttk::CriticalType::Local_maximum) {
+      diagram[2].emplace_back(birth, death);
+    }
+    if(nt1 != ttk::CriticalType::Local_minimum
+       && nt2 != ttk::CriticalType::Local_maximum) {
+      diagram[1].emplace_back(birth, death);
+    }
+  }
+
+  return 0;
+}
+
+int ttkPersistenceDiagramIndex::getPairDiagram(
+  const ttk::PersistenceDiagramFile &file, PairDiagram &diagram) const {
+
+  for(auto &pairs : diagram) {
+    pairs.clear();
+  }
+
+  // columns read in the mapped file
+  const auto birth = file.getBirth();
+  const auto death = file.getDeath();
+  const auto pairType = file.getPairType();
+  const auto nodeType1 = file.getCriticalType1();
+  const auto nodeType2 = file.getCriticalType2();
+
+  for(size_t i = 0; i < file.getNumberOfPairs(); ++i) {
+    // same pairs as with the vtkUnstructuredGrid diagrams
+    if(pairType[i] == -1 || death[i] <= birth[i]) {
+      continue;
+    }
+    const auto nt1 = static_cast<ttk::CriticalType>(nodeType1[i]);
+    const auto nt2 = static_cast<ttk::CriticalType>(nodeType2[i]);
+    if(nt1 == ttk::CriticalType::Local_minimum) {
+      diagram[0].emplace_back(birth[i], death[i]);
+    }
+    if(nt2 == ttk::CriticalType::Local_maximum) {
+      diagram[2].emplace_back(birth[i], death[i]);
+    }
+    if(nt1 != ttk::CriticalType::Local_minimum
+       && nt2 != ttk::CriticalType::Local_maximum) {
+      diagram[1].emplace_back(birth[i], death[i]);
+    }
+  }
+
+  return 0;
+}
+
+int ttkPersistenceDiagramIndex::RequestData(
+  vtkInformation * /*request*/,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector) {
+
+  ttk::Timer tm{};
+
+  const auto queryDiagram = vtkUnstructuredGrid::GetData(inputVector[0]);
+  const auto inputTable = vtkTable::GetData(inputVector[1]);
+  auto outputTable = vtkTable::GetData(outputVector);
+
+  if(queryDiagram == nullptr || inputTable == nullptr) {
+    this->printErr("Missing input");
+    return 0;
+  }
+
+  const auto paths
+    = inputTable->GetColumnByName(this->FilepathColumnName.data());
+  if(paths == nullptr) {
+    this->printErr("Table does not have column '" + this->FilepathColumnName
+                   + "'.");
+    return 0;
+  }
+
+  PairDiagram query{};
+  if(this->getPairDiagram(queryDiagram, query) != 0) {
+    return 0;
+  }
+
+  // load the index file (once)
+  if(this->ForceRebuild || this->LoadedIndexFile != this->IndexFile) {
+    this->clear();
+    if(!this->ForceRebuild && !this->IndexFile.empty()) {
+      this->read(this->IndexFile);
+    }
+    this->LoadedIndexFile = this->IndexFile;
+  }
+  if(this->size() > 0
+     && (this->getResolution() != this->SignatureResolution
+         || this->getSigma() != this->SignatureSigma)) {
+    this->printMsg("Signature parameters changed, rebuilding the index");
+    this->clear();
+  }
+  this->setResolution(this->SignatureResolution);
+  this->setSigma(this->SignatureSigma);
+
+  // look for the diagrams that are not indexed yet or out of date
+  const size_t nRows = inputTable->GetNumberOfRows();
+  std::vector<size_t> rowEntries(nRows);
+  std::vector<size_t> toRead{};
+  std::vector<long long> timestamps(nRows);
+
+  for(size_t i = 0; i < nRows; ++i) {
+    const auto path = paths->GetVariantValue(i).ToString();
+    timestamps[i] = ttk::OsCall::getFileModificationTime(path);
+    const auto id = this->find(path);
+    if(id >= 0 && this->getEntry(id).timestamp == timestamps[i]) {
+      rowEntries[i] = id;
+    } else {
+      toRead.emplace_back(i);
+    }
+  }
+
+  if(!toRead.empty()) {
+    ttk::Timer tmRead{};
+
+    std::vector<PairDiagram> diagrams(toRead.size());
+    vtkNew<vtkXMLGenericDataObjectReader> reader{};
+    this->DiagramFile.setDebugLevel(this->debugLevel_);
+
+    for(size_t i = 0; i < toRead.size(); ++i) {
+      const auto path = paths->GetVariantValue(toRead[i]).ToString();
+      this->printMsg("Indexing (" + std::to_string(i + 1) + "/"
+                       + std::to_string(toRead.size()) + ")",
+                     static_cast<double>(i) / toRead.size(),
+                     tmRead.getElapsedTime(), ttk::debug::LineMode::REPLACE);
+
+      // binary diagrams are read without VTK
+      if(path.size() > 4 && path.substr(path.size() - 4) == ".tpd") {
+        if(this->DiagramFile.openDiagram(path) != 0
+           || this->getPairDiagram(this->DiagramFile, diagrams[i]) != 0) {
+          this->printErr("Unable to read diagram " + path);
+          return 0;
+        }
+        this->DiagramFile.closeDiagram();
+        continue;
+      }
+
+      reader->SetFileName(path.data());
+      reader->Update();
+      const auto vtu = vtkUnstructuredGrid::SafeDownCast(reader->GetOutput());
+      if(reader->GetErrorCode() != 0 || vtu == nullptr) {
+        this->printErr("Unable to read diagram " + path);
+        return 0;
+      }
+      if(this->getPairDiagram(vtu, diagrams[i]) != 0) {
+        this->printErr("Invalid diagram " + path);
+        return 0;
+      }
+    }
+
+    // signatures are only comparable with shared image bounds
+    if(!this->hasBounds()) {
+      this->computeBounds(diagrams);
+    }
+    for(size_t i = 0; i < toRead.size(); ++i) {
+      const auto row = toRead[i];
+      rowEntries[row]
+        = this->insert(paths->GetVariantValue(row).ToString(), timestamps[row],
+                       std::move(diagrams[i]));
+    }
+
+    this->printMsg("Indexed " + std::to_string(toRead.size()) + " diagrams",
+                   1.0, tmRead.getElapsedTime());
+
+    if(!this->IndexFile.empty()) {
+      this->write(this->IndexFile);
+    }
+  }
+
+  // search among the diagrams of the input table only
+  this->buildTree(rowEntries);
+  std::vector<Neighbor> neighbors{};
+  if(this->query(query, this->NumberOfNeighbors, neighbors) != 0) {
+    return 0;
+  }
+
+  std::unordered_map<size_t, size_t> entryRows{};
+  for(size_t i = 0; i < nRows; ++i) {
+    entryRows.emplace(rowEntries[i], i);
+  }
+
+  // copy the rows of the nearest diagrams
+  const size_t nOut = neighbors.size();
+  for(vtkIdType j = 0; j < inputTable->GetNumberOfColumns(); ++j) {
+    const auto col = inputTable->GetColumn(j);
+    const auto outCol
+      = vtkSmartPointer<vtkAbstractArray>::Take(col->NewInstance());
+    outCol->SetName(col->GetName());
+    outCol->SetNumberOfComponents(col->GetNumberOfComponents());
+    outCol->SetNumberOfTuples(nOut);
+    for(size_t i = 0; i < nOut; ++i) {
+      outCol->SetTuple(i, entryRows[neighbors[i].entry], col);
+    }
+    outputTable->AddColumn(outCol);
+  }
+
+  vtkNew<vtkIntArray> rank{};
+  rank->SetName("Rank");
+  rank->SetNumberOfTuples(nOut);
+  vtkNew<vtkDoubleArray> distance{};
+  distance->SetName("Distance");
+  distance->SetNumberOfTuples(nOut);
+  vtkNew<vtkDoubleArray> sigDistance{};
+  sigDistance->SetName("SignatureDistance");
+  sigDistance->SetNumberOfTuples(nOut);
+  for(size_t i = 0; i < nOut; ++i) {
+    rank->SetValue(i, i);
+    distance->SetValue(i, neighbors[i].distance);
+    sigDistance->SetValue(i, neighbors[i].signatureDistance);
+  }
+  outputTable->AddColumn(rank);
+  outputTable->AddColumn(distance);
+  outputTable->AddColumn(sigDistance);
+
+  this->printMsg("Complete (#diagrams: " + std::to_string(nRows) + ")", 1.0,
+                 tm.getElapsedTime(), this->threadNumber_);
+
+  return 1;
+}
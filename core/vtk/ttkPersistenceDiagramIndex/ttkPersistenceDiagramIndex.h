@@ -0,0 +1,112 @@
+/// \ingroup vtk
+/// \class ttkPersistenceDiagramIndex
+///
+/// \brief TTK VTK-filter that retrieves the members of a Cinema database
+/// whose persistence diagrams are the most similar to a query diagram.
+///
+/// The persistence diagrams referenced by the input table (typically the
+/// output of ttkCinemaReader or ttkCinemaQuery) are indexed by
+/// ttk::PersistenceDiagramIndex. The index is saved to IndexFile and re-used
+/// by the next executions: only the diagrams that are not indexed yet, or
+/// whose file has been modified since, are read again.
+///
+/// \param Input0 Query persistence diagram (vtkUnstructuredGrid)
+/// \param Input1 Table of diagram references (vtkTable)
+/// \param Output Table rows of the k nearest diagrams, with their rank and
+/// distance to the query (vtkTable)
+///
+/// \sa ttk::PersistenceDiagramIndex
+/// \sa ttkCinemaReader
+/// \sa ttkPersistenceDiagramDistanceMatrix
+
+#pragma once
+
+// VTK Module
+#include <ttkPersistenceDiagramIndexModule.h>
+
+// VTK includes
+#include <ttkAlgorithm.h>
+
+// TTK includes
+#include <PersistenceDiagramFile.h>
+#include <PersistenceDiagramIndex.h>
+
+class vtkUnstructuredGrid;
+
+class TTKPERSISTENCEDIAGRAMINDEX_EXPORT ttkPersistenceDiagramIndex
+  : public ttkAlgorithm,
+    protected ttk::PersistenceDiagramIndex {
+
+public:
+  static ttkPersistenceDiagramIndex *New();
+  vtkTypeMacro(ttkPersistenceDiagramIndex, ttkAlgorithm);
+
+  vtkSetMacro(FilepathColumnName, std::string);
+  vtkGetMacro(FilepathColumnName, std::string);
+
+  vtkSetMacro(IndexFile, std::string);
+  vtkGetMacro(IndexFile, std::string);
+
+  vtkSetMacro(ForceRebuild, bool);
+  vtkGetMacro(ForceRebuild, bool);
+
+  vtkSetMacro(NumberOfNeighbors, int);
+  vtkGetMacro(NumberOfNeighbors, int);
+
+  vtkSetMacro(CandidateFactor, int);
+  vtkGetMacro(CandidateFactor, int);
+
+  vtkSetMacro(SignatureResolution, int);
+  vtkGetMacro(SignatureResolution, int);
+
+  vtkSetMacro(SignatureSigma, double);
+  vtkGetMacro(SignatureSigma, double);
+
+  vtkSetMacro(DeltaLim, double);
+  vtkGetMacro(DeltaLim, double);
+
+  void SetWassersteinMetric(const std::string &data) {
+    Wasserstein = (data == "inf") ? -1 : stoi(data);
+    Modified();
+  }
+  std::string GetWassersteinMetric() {
+    return Wasserstein == -1 ? "inf" : std::to_string(Wasserstein);
+  }
+
+  void SetPairType(const int data) {
+    this->PairType = data;
+    this->setDos(data < 0 || data == 0, data < 0 || data == 1,
+                 data < 0 || data == 2);
+    Modified();
+  }
+  vtkGetMacro(PairType, int);
+
+protected:
+  ttkPersistenceDiagramIndex();
+  ~ttkPersistenceDiagramIndex() override = default;
+
+  int getPairDiagram(vtkUnstructuredGrid *vtu, PairDiagram &diagram) const;
+  int getPairDiagram(const ttk::PersistenceDiagramFile &file,
+                     PairDiagram &diagram) const;
+
+  int FillInputPortInformation(int port, vtkInformation *info) override;
+  int FillOutputPortInformation(int port, vtkInformation *info) override;
+
+  int RequestData(vtkInformation *request,
+                  vtkInformationVector **inputVector,
+                  vtkInformationVector *outputVector) override;
+
+private:
+  std::string FilepathColumnName{"FILE"};
+  std::string IndexFile{};
+  bool ForceRebuild{false};
+  int NumberOfNeighbors{5};
+  int SignatureResolution{8};
+  double SignatureSigma{0.1};
+  int PairType{-1};
+
+  // index file currently loaded in memory
+  std::string LoadedIndexFile{};
+  // reader of the .tpd diagrams
+  ttk::PersistenceDiagramFile DiagramFile{};
+};
@@ -0,0 +1,179 @@
+#include <ttkMacros.h>
+#include <ttkPersistenceDiagramReader.h>
+#include <ttkUtils.h>
+
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkInformation.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkUnstructuredGrid.h>
+
+vtkStandardNewMacro(ttkPersistenceDiagramReader);
+
+ttkPersistenceDiagramReader::ttkPersistenceDiagramReader() {
+  SetNumberOfInputPorts(0);
+  SetNumberOfOutputPorts(1);
+  this->setDebugMsgPrefix("PersistenceDiagramReader");
+}
+
+int ttkPersistenceDiagramReader::FillOutputPortInformation(
+  int port, vtkInformation *info) {
+  if(port == 0) {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkUnstructuredGrid");
+    return 1;
+  }
+  return 0;
+}
+
+int ttkPersistenceDiagramReader::RequestData(
+  vtkInformation * /*request*/,
+  vtkInformationVector ** /*inputVector*/,
+  vtkInformationVector *outputVector) {
+
+  ttk::Timer t;
+
+  if(FileName == nullptr) {
+    return 1;
+  }
+
+  if(this->openDiagram(FileName) != 0) {
+    return 0;
+  }
+
+  const auto nPairs = static_cast<vtkIdType>(this->getNumberOfPairs());
+  const bool embed = (this->getFlags() & EMBEDDED_IN_DOMAIN) != 0;
+  // the standard diagram has the diagonal as last cell
+  const auto nCells = nPairs + (!embed && nPairs > 0 ? 1 : 0);
+
+  const auto birth = this->getBirth();
+  const auto death = this->getDeath();
+  const auto vertexId1 = this->getVertexId1();
+  const auto vertexId2 = this->getVertexId2();
+  const auto coords1 = this->getCoords1();
+  const auto coords2 = this->getCoords2();
+  const auto pairType = this->getPairType();
+  const auto criticalType1 = this->getCriticalType1();
+  const auto criticalType2 = this->getCriticalType2();
+
+  vtkNew<vtkPoints> points{};
+  points->SetNumberOfPoints(2 * nPairs);
+
+  vtkNew<ttkSimplexIdTypeArray> vertexIdentifierScalars{};
+  vertexIdentifierScalars->SetName(ttk::VertexScalarFieldName);
+  vertexIdentifierScalars->SetNumberOfTuples(2 * nPairs);
+
+  vtkNew<vtkIntArray> nodeTypeScalars{};
+  nodeTypeScalars->SetName("CriticalType");
+  nodeTypeScalars->SetNumberOfTuples(2 * nPairs);
+
+  vtkNew<ttkSimplexIdTypeArray> pairIdentifierScalars{};
+  pairIdentifierScalars->SetName("PairIdentifier");
+  pairIdentifierScalars->SetNumberOfTuples(nCells);
+
+  vtkNew<vtkIntArray> extremumIndexScalars{};
+  extremumIndexScalars->SetName("PairType");
+  extremumIndexScalars->SetNumberOfTuples(nCells);
+
+  vtkNew<vtkDoubleArray> persistenceScalars{};
+  persistenceScalars->SetName("Persistence");
+  persistenceScalars->SetNumberOfTuples(nCells);
+
+  vtkNew<vtkFloatArray> coordsScalars{};
+  coordsScalars->SetName("Coordinates");
+  coordsScalars->SetNumberOfComponents(3);
+
+  vtkNew<vtkDoubleArray> birthScalars{};
+  birthScalars->SetName("Birth");
+  vtkNew<vtkDoubleArray> deathScalars{};
+  deathScalars->SetName("Death");
+
+  if(embed) {
+    birthScalars->SetNumberOfTuples(2 * nPairs);
+    deathScalars->SetNumberOfTuples(2 * nPairs);
+  } else {
+    coordsScalars->SetNumberOfTuples(2 * nPairs);
+  }
+
+  vtkNew<vtkUnstructuredGrid> diagram{};
+  diagram->Allocate(nCells);
+
+  double maxPersistence{};
+
+  for(vtkIdType i = 0; i < nPairs; ++i) {
+    const auto i0 = 2 * i;
+    const auto i1 = 2 * i + 1;
+
+    vertexIdentifierScalars->SetValue(i0, vertexId1[i]);
+    vertexIdentifierScalars->SetValue(i1, vertexId2[i]);
+    nodeTypeScalars->SetValue(i0, criticalType1[i]);
+    nodeTypeScalars->SetValue(i1, criticalType2[i]);
+
+    if(embed) {
+      points->SetPoint(i0, coords1[3 * i], coords1[3 * i + 1],
+                       coords1[3 * i + 2]);
+      points->SetPoint(i1, coords2[3 * i], coords2[3 * i + 1],
+                       coords2[3 * i + 2]);
+      birthScalars->SetValue(i0, birth[i]);
+      birthScalars->SetValue(i1, birth[i]);
+      deathScalars->SetValue(i0, birth[i]);
+      deathScalars->SetValue(i1, death[i]);
+    } else {
+      points->SetPoint(i0, birth[i], birth[i], 0);
+      points->SetPoint(i1, birth[i], death[i], 0);
+      coordsScalars->SetTuple3(
+        i0, coords1[3 * i], coords1[3 * i + 1], coords1[3 * i + 2]);
+      coordsScalars->SetTuple3(
+        i1, coords2[3 * i], coords2[3 * i + 1], coords2[3 * i + 2]);
+    }
+
+    const vtkIdType ids[2] = {i0, i1};
+    diagram->InsertNextCell(VTK_LINE, 2, ids);
+
+    const double persistence = death[i] - birth[i];
+    maxPersistence = std::max(maxPersistence, persistence);
+    pairIdentifierScalars->SetValue(i, i);
+    extremumIndexScalars->SetValue(i, pairType[i]);
+    persistenceScalars->SetValue(i, persistence);
+  }
+
+  if(nCells > nPairs) {
+    // diagonal
+    const vtkIdType ids[2] = {0, 2 * (nPairs - 1)};
+    diagram->InsertNextCell(VTK_LINE, 2, ids);
+    pairIdentifierScalars->SetValue(nPairs, -1);
+    extremumIndexScalars->SetValue(nPairs, -1);
+    persistenceScalars->SetValue(nPairs, 2 * maxPersistence);
+  }
+
+  this->closeDiagram();
+
+  diagram->SetPoints(points);
+  diagram->GetPointData()->AddArray(vertexIdentifierScalars);
+  diagram->GetPointData()->AddArray(nodeTypeScalars);
+  if(embed) {
+    diagram->GetPointData()->AddArray(birthScalars);
+    diagram->GetPointData()->AddArray(deathScalars);
+  } else {
+    diagram->GetPointData()->AddArray(coordsScalars);
+  }
+  diagram->GetCellData()->AddArray(pairIdentifierScalars);
+  diagram->GetCellData()->AddArray(extremumIndexScalars);
+  diagram->GetCellData()->AddArray(persistenceScalars);
+
+  auto output = vtkUnstructuredGrid::GetData(outputVector);
+  output->ShallowCopy(diagram);
+
+  this->printMsg("Read " + std::to_string(nPairs) + " pairs", 1,
+                 t.getElapsedTime());
+
+  return 1;
+}
+
+vtkUnstructuredGrid *ttkPersistenceDiagramReader::GetOutput() {
+  // copied from ParaView's vtkUnstructuredGridAlgorithm::GetOutput(int port)
+  return vtkUnstructuredGrid::SafeDownCast(this->GetOutputDataObject(0));
+}
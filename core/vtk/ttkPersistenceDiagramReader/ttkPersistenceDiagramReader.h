@@ -0,0 +1,50 @@
+/// \ingroup vtkWrappers
+/// \class ttkPersistenceDiagramReader
+///
+/// \brief VTK-filter that reads persistence diagrams stored in the binary
+/// format of ttk::PersistenceDiagramFile (.tpd).
+///
+/// The output has the layout of the diagrams produced by
+/// ttkPersistenceDiagram (two points and a line cell per pair, with the
+/// diagonal in the birth-death plane, or the critical points inside the
+/// domain).
+///
+/// \sa ttk::PersistenceDiagramFile
+/// \sa ttkPersistenceDiagramWriter
+
+#pragma once
+
+// TTK
+#include <PersistenceDiagramFile.h>
+#include <ttkAlgorithm.h>
+
+// VTK Module
+#include <ttkPersistenceDiagramReaderModule.h>
+
+class vtkUnstructuredGrid;
+
+class TTKPERSISTENCEDIAGRAMREADER_EXPORT ttkPersistenceDiagramReader
+  : public ttkAlgorithm,
+    protected ttk::PersistenceDiagramFile {
+
+public:
+  static ttkPersistenceDiagramReader *New();
+
+  vtkTypeMacro(ttkPersistenceDiagramReader, ttkAlgorithm);
+
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  // need this method to align with the vtkUnstructuredGridAlgorithm API
+  vtkUnstructuredGrid *GetOutput();
+
+protected:
+  ttkPersistenceDiagramReader();
+  int FillOutputPortInformation(int, vtkInformation *) override;
+  int RequestData(vtkInformation *,
+                  vtkInformationVector **,
+                  vtkInformationVector *) override;
+
+private:
+  char *FileName{};
+};
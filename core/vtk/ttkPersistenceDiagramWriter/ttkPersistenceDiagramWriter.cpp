@@ -0,0 +1,139 @@
+#include <ttkMacros.h>
+#include <ttkPersistenceDiagramWriter.h>
+#include <ttkUtils.h>
+
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkExecutive.h>
+#include <vtkIdList.h>
+#include <vtkInformation.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkUnstructuredGrid.h>
+
+vtkStandardNewMacro(ttkPersistenceDiagramWriter);
+
+ttkPersistenceDiagramWriter::ttkPersistenceDiagramWriter() {
+  SetNumberOfInputPorts(1);
+  this->setDebugMsgPrefix("PersistenceDiagramWriter");
+}
+
+int ttkPersistenceDiagramWriter::FillInputPortInformation(
+  int port, vtkInformation *info) {
+  if(port == 0) {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+    return 1;
+  }
+  return 0;
+}
+
+int ttkPersistenceDiagramWriter::getColumns(vtkUnstructuredGrid *vtu,
+                                            Columns &diagram) const {
+
+  const auto pd = vtu->GetPointData();
+  const auto cd = vtu->GetCellData();
+
+  const auto vertexIdentifierScalars
+    = pd->GetArray(ttk::VertexScalarFieldName);
+  const auto nodeTypeScalars = pd->GetArray("CriticalType");
+  const auto coordsScalars = pd->GetArray("Coordinates");
+  const auto birthScalars = pd->GetArray("Birth");
+  const auto deathScalars = pd->GetArray("Death");
+  const auto pairIdentifierScalars = cd->GetArray("PairIdentifier");
+  const auto extremumIndexScalars = cd->GetArray("PairType");
+
+  const bool embed = birthScalars != nullptr && deathScalars != nullptr;
+
+  if(vtu->GetPoints() == nullptr || vertexIdentifierScalars == nullptr
+     || nodeTypeScalars == nullptr || pairIdentifierScalars == nullptr
+     || extremumIndexScalars == nullptr
+     || (!embed && coordsScalars == nullptr)) {
+    this->printErr("Input is not a persistence diagram");
+    return -1;
+  }
+
+  // skip the diagonal
+  std::vector<vtkIdType> cells{};
+  for(vtkIdType i = 0; i < vtu->GetNumberOfCells(); ++i) {
+    if(pairIdentifierScalars->GetTuple1(i) != -1
+       && vtu->GetCellSize(i) == 2) {
+      cells.emplace_back(i);
+    }
+  }
+
+  diagram.resize(cells.size());
+  diagram.flags = embed ? EMBEDDED_IN_DOMAIN : 0;
+
+  vtkNew<vtkIdList> pointIds{};
+  std::array<double, 3> p0{}, p1{};
+
+  for(size_t i = 0; i < cells.size(); ++i) {
+    vtu->GetCellPoints(cells[i], pointIds);
+    const auto i0 = pointIds->GetId(0);
+    const auto i1 = pointIds->GetId(1);
+
+    diagram.vertexId1[i] = vertexIdentifierScalars->GetTuple1(i0);
+    diagram.vertexId2[i] = vertexIdentifierScalars->GetTuple1(i1);
+    diagram.criticalType1[i] = nodeTypeScalars->GetTuple1(i0);
+    diagram.criticalType2[i] = nodeTypeScalars->GetTuple1(i1);
+    diagram.pairType[i] = extremumIndexScalars->GetTuple1(cells[i]);
+
+    if(embed) {
+      vtu->GetPoint(i0, p0.data());
+      vtu->GetPoint(i1, p1.data());
+      diagram.birth[i] = birthScalars->GetTuple1(i0);
+      diagram.death[i] = deathScalars->GetTuple1(i1);
+    } else {
+      diagram.birth[i] = vtu->GetPoint(i0)[0];
+      diagram.death[i] = vtu->GetPoint(i1)[1];
+      coordsScalars->GetTuple(i0, p0.data());
+      coordsScalars->GetTuple(i1, p1.data());
+    }
+    for(size_t j = 0; j < 3; ++j) {
+      diagram.coords1[3 * i + j] = p0[j];
+      diagram.coords2[3 * i + j] = p1[j];
+    }
+  }
+
+  return 0;
+}
+
+int ttkPersistenceDiagramWriter::Write() {
+
+  ttk::Timer t;
+
+  const auto vtu = vtkUnstructuredGrid::SafeDownCast(this->GetInput());
+  if(vtu == nullptr) {
+    this->printErr("Missing input diagram");
+    return 0;
+  }
+  if(FileName == nullptr) {
+    this->printErr("Missing file name");
+    return 0;
+  }
+
+  Columns diagram{};
+  if(this->getColumns(vtu, diagram) != 0) {
+    return 0;
+  }
+  if(this->writeDiagram(FileName, diagram) != 0) {
+    return 0;
+  }
+
+  this->printMsg("Wrote to " + std::string{FileName} + ".", 1,
+                 t.getElapsedTime());
+  return 1;
+}
+
+vtkDataObject *ttkPersistenceDiagramWriter::GetInput() {
+  // copied from ParaView's vtkWriter::GetInput()
+  if(this->GetNumberOfInputConnections(0) < 1) {
+    return nullptr;
+  }
+  return this->GetExecutive()->GetInputData(0, 0);
+}
+
+void ttkPersistenceDiagramWriter::SetInputData(vtkDataObject *input) {
+  // copied from ParaView's vtkWriter::SetInputData()
+  this->SetInputDataInternal(0, input);
+}
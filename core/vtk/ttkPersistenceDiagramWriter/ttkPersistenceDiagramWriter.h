@@ -0,0 +1,50 @@
+/// \ingroup vtkWrappers
+/// \class ttkPersistenceDiagramWriter
+///
+/// \brief VTK-filter that writes persistence diagrams in the binary format
+/// of ttk::PersistenceDiagramFile (.tpd).
+///
+/// The input is a diagram produced by ttkPersistenceDiagram, either in the
+/// birth-death plane or embedded in the domain (Birth and Death arrays).
+/// The diagonal cell is not stored.
+///
+/// \sa ttk::PersistenceDiagramFile
+/// \sa ttkPersistenceDiagramReader
+
+#pragma once
+
+// TTK
+#include <PersistenceDiagramFile.h>
+#include <ttkAlgorithm.h>
+
+// VTK Module
+#include <ttkPersistenceDiagramWriterModule.h>
+
+class vtkUnstructuredGrid;
+
+class TTKPERSISTENCEDIAGRAMWRITER_EXPORT ttkPersistenceDiagramWriter
+  : public ttkAlgorithm,
+    protected ttk::PersistenceDiagramFile {
+
+public:
+  static ttkPersistenceDiagramWriter *New();
+
+  vtkTypeMacro(ttkPersistenceDiagramWriter, ttkAlgorithm);
+
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  // expose vtkWriter methods (duck-typing)
+  int Write();
+  vtkDataObject *GetInput();
+  void SetInputData(vtkDataObject *input);
+
+protected:
+  ttkPersistenceDiagramWriter();
+  int FillInputPortInformation(int port, vtkInformation *info) override;
+
+  int getColumns(vtkUnstructuredGrid *vtu, Columns &diagram) const;
+
+private:
+  char *FileName{};
+};
@@ -0,0 +1,219 @@
+#include <ttkMacros.h>
+#include <ttkRawVolumeReader.h>
+#include <ttkUtils.h>
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+vtkStandardNewMacro(ttkRawVolumeReader);
+
+namespace {
+  using ScalarType = ttk::RawVolume::ScalarType;
+
+  int getVtkType(const ScalarType type) {
+    switch(type) {
+      case ScalarType::INT8:
+        return VTK_SIGNED_CHAR;
+      case ScalarType::UINT8:
+        return VTK_UNSIGNED_CHAR;
+      case ScalarType::INT16:
+        return VTK_SHORT;
+      case ScalarType::UINT16:
+        return VTK_UNSIGNED_SHORT;
+      case ScalarType::INT32:
+        return VTK_INT;
+      case ScalarType::UINT32:
+        return VTK_UNSIGNED_INT;
+      case ScalarType::INT64:
+        return VTK_LONG_LONG;
+      case ScalarType::UINT64:
+        return VTK_UNSIGNED_LONG_LONG;
+      case ScalarType::FLOAT:
+        return VTK_FLOAT;
+      case ScalarType::DOUBLE:
+        return VTK_DOUBLE;
+      default:
+        return VTK_VOID;
+    }
+  }
+
+  ScalarType getScalarType(const int vtkType) {
+    switch(vtkType) {
+      case VTK_CHAR:
+      case VTK_SIGNED_CHAR:
+        return ScalarType::INT8;
+      case VTK_UNSIGNED_CHAR:
+        return ScalarType::UINT8;
+      case VTK_SHORT:
+        return ScalarType::INT16;
+      case VTK_UNSIGNED_SHORT:
+        return ScalarType::UINT16;
+      case VTK_INT:
+        return ScalarType::INT32;
+      case VTK_UNSIGNED_INT:
+        return ScalarType::UINT32;
+      case VTK_LONG_LONG:
+      case VTK_ID_TYPE:
+        return ScalarType::INT64;
+      case VTK_UNSIGNED_LONG_LONG:
+        return ScalarType::UINT64;
+      case VTK_FLOAT:
+        return ScalarType::FLOAT;
+      case VTK_DOUBLE:
+        return ScalarType::DOUBLE;
+      default:
+        return ScalarType::UNKNOWN;
+    }
+  }
+
+  // mappings used by the output arrays, released with the arrays
+  std::mutex mappingsMutex{};
+  std::unordered_map<void *, std::unique_ptr<ttk::MappedFile>> mappings{};
+
+  void releaseMapping(void *data) {
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    mappings.erase(data);
+  }
+} // namespace
+
+ttkRawVolumeReader::ttkRawVolumeReader() {
+  SetNumberOfInputPorts(0);
+  SetNumberOfOutputPorts(1);
+  this->setDebugMsgPrefix("RawVolumeReader");
+}
+
+int ttkRawVolumeReader::FillOutputPortInformation(int port,
+                                                  vtkInformation *info) {
+  if(port == 0) {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkImageData");
+    return 1;
+  }
+  return 0;
+}
+
+int ttkRawVolumeReader::getHeader(Header &header) const {
+  if(isNrrdFile(FileName)) {
+    return this->readNrrdHeader(FileName, header);
+  }
+
+  header = Header{};
+  header.dataFile = FileName;
+  header.dataOffset = HeaderSize;
+  header.littleEndian = !BigEndian;
+  header.scalarType = getScalarType(DataScalarType);
+  header.nComponents = NumberOfScalarComponents;
+  for(int i = 0; i < 3; ++i) {
+    header.dimensions[i] = DataDimensions[i];
+    header.spacing[i] = DataSpacing[i];
+    header.origin[i] = DataOrigin[i];
+  }
+  if(header.scalarType == ScalarType::UNKNOWN) {
+    this->printErr("Unsupported data scalar type");
+    return -1;
+  }
+  return 0;
+}
+
+int ttkRawVolumeReader::RequestInformation(
+  vtkInformation * /*request*/,
+  vtkInformationVector ** /*inputVector*/,
+  vtkInformationVector *outputVector) {
+
+  if(FileName == nullptr) {
+    return 1;
+  }
+
+  Header header{};
+  if(this->getHeader(header) != 0) {
+    return 0;
+  }
+
+  const std::array<int, 6> extent{0, header.dimensions[0] - 1,
+                                  0, header.dimensions[1] - 1,
+                                  0, header.dimensions[2] - 1};
+
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkDataObject::SPACING(), header.spacing.data(), 3);
+  outInfo->Set(vtkDataObject::ORIGIN(), header.origin.data(), 3);
+  outInfo->Set(
+    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent.data(), 6);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    outInfo, getVtkType(header.scalarType), header.nComponents);
+
+  return 1;
+}
+
+int ttkRawVolumeReader::RequestData(vtkInformation * /*request*/,
+                                    vtkInformationVector ** /*inputVector*/,
+                                    vtkInformationVector *outputVector) {
+
+  ttk::Timer t;
+
+  if(FileName == nullptr) {
+    return 1;
+  }
+
+  Header header{};
+  if(this->getHeader(header) != 0) {
+    return 0;
+  }
+
+  auto file = std::unique_ptr<ttk::MappedFile>(new ttk::MappedFile{});
+  char *data{};
+  bool inPlace{};
+  if(this->mapVolume(header, *file, data, inPlace) != 0) {
+    return 0;
+  }
+
+  const auto nTuples = static_cast<vtkIdType>(header.dimensions[0])
+                       * header.dimensions[1] * header.dimensions[2];
+  const auto nValues = nTuples * header.nComponents;
+
+  auto array = vtkSmartPointer<vtkDataArray>::Take(
+    vtkDataArray::CreateDataArray(getVtkType(header.scalarType)));
+  array->SetName(DataArrayName.data());
+  array->SetNumberOfComponents(header.nComponents);
+
+  if(inPlace) {
+    // the array uses the mapping, unmapped when the array is deleted
+    {
+      std::lock_guard<std::mutex> lock(mappingsMutex);
+      mappings[data] = std::move(file);
+    }
+    array->SetArrayFreeFunction(releaseMapping);
+    array->SetVoidArray(data, nValues, 0, VTK_DATA_ARRAY_USER_DEFINED);
+  } else {
+    // byte swapping or unaligned values
+    array->SetNumberOfTuples(nTuples);
+    this->copyValues(
+      header, data, static_cast<char *>(ttkUtils::GetVoidPointer(array)));
+    file->close();
+  }
+
+  auto output = vtkImageData::GetData(outputVector);
+  output->SetExtent(0, header.dimensions[0] - 1, 0, header.dimensions[1] - 1,
+                    0, header.dimensions[2] - 1);
+  output->SetSpacing(header.spacing.data());
+  output->SetOrigin(header.origin.data());
+  output->GetPointData()->SetScalars(array);
+
+  this->printMsg(std::string{inPlace ? "Mapped " : "Read "}
+                   + std::to_string(nTuples) + " vertices",
+                 1, t.getElapsedTime());
+
+  return 1;
+}
+
+vtkImageData *ttkRawVolumeReader::GetOutput() {
+  // copied from ParaView's vtkImageAlgorithm::GetOutput(int port)
+  return vtkImageData::SafeDownCast(this->GetOutputDataObject(0));
+}
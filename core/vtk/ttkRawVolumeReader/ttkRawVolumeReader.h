@@ -0,0 +1,93 @@
+/// \ingroup vtkWrappers
+/// \class ttkRawVolumeReader
+///
+/// \brief VTK-filter that memory-maps raw volumes into vtkImageData.
+///
+/// The reader supports NRRD files with raw encoding (attached .nrrd or
+/// detached .nhdr headers) and raw files with a fixed-size header, whose
+/// layout is given by the DataDimensions, DataScalarType, HeaderSize and
+/// BigEndian properties.
+///
+/// The file is mapped in memory (copy-on-write) and, when the byte order
+/// matches the host and the values are aligned, the point data array of the
+/// output directly uses the mapping: no value is copied and the pages are
+/// only loaded from disk when the downstream filters access them. The
+/// mapping is released with the array.
+///
+/// \sa ttk::RawVolume
+
+#pragma once
+
+// TTK
+#include <RawVolume.h>
+#include <ttkAlgorithm.h>
+
+// VTK Module
+#include <ttkRawVolumeReaderModule.h>
+
+class vtkImageData;
+
+class TTKRAWVOLUMEREADER_EXPORT ttkRawVolumeReader
+  : public ttkAlgorithm,
+    protected ttk::RawVolume {
+
+public:
+  static ttkRawVolumeReader *New();
+
+  vtkTypeMacro(ttkRawVolumeReader, ttkAlgorithm);
+
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+
+  vtkSetMacro(DataArrayName, std::string);
+  vtkGetMacro(DataArrayName, std::string);
+
+  // raw files only (NRRD files describe their layout)
+  vtkSetMacro(DataScalarType, int);
+  vtkGetMacro(DataScalarType, int);
+
+  vtkSetMacro(NumberOfScalarComponents, int);
+  vtkGetMacro(NumberOfScalarComponents, int);
+
+  vtkSetVector3Macro(DataDimensions, int);
+  vtkGetVector3Macro(DataDimensions, int);
+
+  vtkSetVector3Macro(DataSpacing, double);
+  vtkGetVector3Macro(DataSpacing, double);
+
+  vtkSetVector3Macro(DataOrigin, double);
+  vtkGetVector3Macro(DataOrigin, double);
+
+  vtkSetMacro(HeaderSize, vtkIdType);
+  vtkGetMacro(HeaderSize, vtkIdType);
+
+  vtkSetMacro(BigEndian, bool);
+  vtkGetMacro(BigEndian, bool);
+
+  // need this method to align with the vtkImageAlgorithm API
+  vtkImageData *GetOutput();
+
+protected:
+  ttkRawVolumeReader();
+  int FillOutputPortInformation(int, vtkInformation *) override;
+  int RequestInformation(vtkInformation *request,
+                         vtkInformationVector **inputVector,
+                         vtkInformationVector *outputVector) override;
+  int RequestData(vtkInformation *,
+                  vtkInformationVector **,
+                  vtkInformationVector *) override;
+
+  /// Description of the volume (NRRD header or reader properties)
+  int getHeader(Header &header) const;
+
+private:
+  char *FileName{};
+  std::string DataArrayName{"ImageFile"};
+  int DataScalarType{VTK_FLOAT};
+  int NumberOfScalarComponents{1};
+  int DataDimensions[3]{1, 1, 1};
+  double DataSpacing[3]{1.0, 1.0, 1.0};
+  double DataOrigin[3]{0.0, 0.0, 0.0};
+  vtkIdType HeaderSize{0};
+  bool BigEndian{false};
+};
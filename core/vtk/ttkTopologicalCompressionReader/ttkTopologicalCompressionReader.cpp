@@ -55,15 +55,32 @@ int ttkTopologicalCompressionReader::RequestInformation(
 
   //  ReadMetaData(fp);
 
+  // The output is restricted to the region of interest.
+  RegionExtent = DataExtent;
+  if(UseRegionOfInterest) {
+    for(int i = 0; i < 3; ++i) {
+      RegionExtent[2 * i]
+        = std::max(DataExtent[2 * i], RegionOfInterest[2 * i]);
+      RegionExtent[2 * i + 1]
+        = std::min(DataExtent[2 * i + 1], RegionOfInterest[2 * i + 1]);
+      if(RegionExtent[2 * i] > RegionExtent[2 * i + 1]) {
+        this->printWrn("Empty region of interest, reading the whole extent.");
+        RegionExtent = DataExtent;
+        break;
+      }
+    }
+  }
+
   vtkInformation *outInfo = outputVector->GetInformationObject(0);
   outInfo->Set(vtkDataObject::SPACING(), DataSpacing.data(), 3);
   outInfo->Set(vtkDataObject::ORIGIN(), DataOrigin.data(), 3);
   outInfo->Set(
-    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), DataExtent.data(), 6);
+    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), RegionExtent.data(), 6);
+  outInfo->Set(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(), 1);
 
   int numberOfVertices = 1;
   for(int i = 0; i < 3; ++i)
-    numberOfVertices *= (1 + DataExtent[2 * i + 1] - DataExtent[2 * i]);
+    numberOfVertices *= (1 + RegionExtent[2 * i + 1] - RegionExtent[2 * i]);
   outInfo->Set(vtkDataObject::FIELD_NUMBER_OF_TUPLES(), numberOfVertices);
 
   vtkDataObject::SetPointDataActiveScalarInfo(outInfo, DataScalarType, 1);
@@ -99,16 +116,23 @@ int ttkTopologicalCompressionReader::RequestData(
     DataExtent[i] = this->getDataExtent()[i];
     DataExtent[3 + i] = this->getDataExtent()[3 + i];
   }
-  int nx = 1 + DataExtent[1] - DataExtent[0];
-  int ny = 1 + DataExtent[3] - DataExtent[2];
-  int nz = 1 + DataExtent[5] - DataExtent[4];
-  int vertexNumber = nx * ny * nz;
   ZFPOnly = this->getZFPOnly();
 
-  vtkNew<vtkImageData> mesh{};
-  BuildMesh(mesh);
+  // Only decompress the requested extent.
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  std::array<int, 6> updateExtent = RegionExtent;
+  if(outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT())) {
+    outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), updateExtent.data());
+  }
+  this->setRegionOfInterest(
+    updateExtent == DataExtent ? nullptr : updateExtent.data());
 
-  auto triangulation = ttkAlgorithm::GetTriangulation(mesh);
+  // (the topological reconstruction is performed on the whole grid)
+  vtkNew<vtkImageData> grid{};
+  BuildMesh(grid, DataExtent.data());
+
+  auto triangulation = ttkAlgorithm::GetTriangulation(grid);
   this->preconditionTriangulation(triangulation);
 
   int status{0};
@@ -133,8 +157,13 @@ int ttkTopologicalCompressionReader::RequestData(
     vtkWarningMacro("Failure when reading compressed TTK file");
   }
 
-  mesh->GetPointData()->RemoveArray(0);
-  mesh->GetPointData()->SetNumberOfTuples(vertexNumber);
+  vtkNew<vtkImageData> mesh{};
+  BuildMesh(mesh, this->getDecompressedExtent().data());
+  const auto vertexNumber = mesh->GetNumberOfPoints();
+  if(this->getDecompressedData().size() < (size_t)vertexNumber) {
+    this->printErr("Could not decompress the requested extent.");
+    return 0;
+  }
 
   vtkNew<vtkDoubleArray> decompressed{};
   decompressed->SetNumberOfTuples(vertexNumber);
@@ -145,12 +174,14 @@ int ttkTopologicalCompressionReader::RequestData(
     decompressed->SetName("Decompressed");
   }
   const auto &decompressdeData = this->getDecompressedData();
-  for(int i = 0; i < vertexNumber; ++i)
+  for(vtkIdType i = 0; i < vertexNumber; ++i)
     decompressed->SetTuple1(i, decompressdeData[i]);
   // decompressed->SetVoidArray(, vertexNumber, 0);
   mesh->GetPointData()->AddArray(decompressed);
 
-  if(SQMethodInt != 1 && SQMethodInt != 2 && !ZFPOnly) {
+  // (no offsets when the simplification is skipped for a region)
+  if(SQMethodInt != 1 && SQMethodInt != 2 && !ZFPOnly
+     && this->getDecompressedOffsets().size() == (size_t)vertexNumber) {
     vtkNew<vtkIntArray> vertexOffset{};
     vertexOffset->SetNumberOfTuples(vertexNumber);
     vertexOffset->SetName(ttk::OffsetScalarFieldName);
@@ -166,8 +197,6 @@ int ttkTopologicalCompressionReader::RequestData(
                  + " vertice(s), " + std::to_string(mesh->GetNumberOfCells())
                  + " cell(s).");
 
-  // get the info object
-  vtkInformation *outInfo = outputVector->GetInformationObject(0);
   outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
 
   // Set the output
@@ -182,13 +211,10 @@ vtkImageData *ttkTopologicalCompressionReader::GetOutput() {
   return vtkImageData::SafeDownCast(this->GetOutputDataObject(0));
 }
 
-void ttkTopologicalCompressionReader::BuildMesh(vtkImageData *mesh) const {
-  int nx = 1 + DataExtent[1] - DataExtent[0];
-  int ny = 1 + DataExtent[3] - DataExtent[2];
-  int nz = 1 + DataExtent[5] - DataExtent[4];
-  mesh->SetDimensions(nx, ny, nz);
+void ttkTopologicalCompressionReader::BuildMesh(vtkImageData *mesh,
+                                                const int *extent) const {
+  mesh->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4],
+                  extent[5]);
   mesh->SetSpacing(DataSpacing[0], DataSpacing[1], DataSpacing[2]);
   mesh->SetOrigin(DataOrigin[0], DataOrigin[1], DataOrigin[2]);
-  mesh->AllocateScalars(DataScalarType, 2);
-  mesh->GetPointData()->SetNumberOfTuples(nx * ny * nz);
 }
@@ -5,6 +5,10 @@
 ///
 /// \brief VTK-filter that wraps the topologicalCompressionWriter processing
 /// package.
+///
+/// With files using the bricked format (version 2), only the bricks
+/// intersecting the region of interest (or the requested update extent) are
+/// decompressed.
 
 #pragma once
 
@@ -32,6 +36,12 @@ public:
   vtkSetMacro(DataScalarType, int);
   vtkGetMacro(DataScalarType, int);
 
+  vtkSetMacro(UseRegionOfInterest, bool);
+  vtkGetMacro(UseRegionOfInterest, bool);
+
+  vtkSetVector6Macro(RegionOfInterest, int);
+  vtkGetVector6Macro(RegionOfInterest, int);
+
   // need this method to align with the vtkImageAlgorithm API
   vtkImageData *GetOutput();
 
@@ -47,15 +57,19 @@ protected:
                                  vtkInformationVector *outputVector) override;
 
   // TTK management.
-  void BuildMesh(vtkImageData *mesh) const;
+  void BuildMesh(vtkImageData *mesh, const int *extent) const;
 
 private:
   // General properties.
   char *FileName{};
+  bool UseRegionOfInterest{false};
+  int RegionOfInterest[6]{0, 0, 0, 0, 0, 0};
 
   // Data properties.
   int DataScalarType;
   std::array<int, 6> DataExtent{0, 0, 0, 0, 0, 0};
+  // data extent restricted to the region of interest
+  std::array<int, 6> RegionExtent{0, 0, 0, 0, 0, 0};
   std::array<double, 3> DataSpacing{1.0, 1.0, 1.0};
   std::array<double, 3> DataOrigin{0.0, 0.0, 0.0};
 };
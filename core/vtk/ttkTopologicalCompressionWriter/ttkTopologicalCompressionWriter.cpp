@@ -97,6 +97,20 @@ int ttkTopologicalCompressionWriter::Write() {
   int dt = inputScalarField->GetDataType();
   auto vp = static_cast<double *>(ttkUtils::GetVoidPointer(inputScalarField));
 
+  // the geometry (and the temporal prediction) reads the field as doubles
+  std::vector<double> inputAsDouble{};
+  if(dt != VTK_DOUBLE) {
+    inputAsDouble.resize(inputScalarField->GetNumberOfTuples());
+    switch(dt) {
+      vtkTemplateMacro(std::copy(
+        static_cast<VTK_TT *>(ttkUtils::GetVoidPointer(inputScalarField)),
+        static_cast<VTK_TT *>(ttkUtils::GetVoidPointer(inputScalarField))
+          + inputAsDouble.size(),
+        inputAsDouble.begin()));
+    }
+    vp = inputAsDouble.data();
+  }
+
   this->setFileName(FileName);
   this->WriteToFile<double>(fp, CompressionType, ZFPOnly, SQMethod.c_str(), dt,
                             vti->GetExtent(), vti->GetSpacing(),
@@ -5,6 +5,10 @@
 ///
 /// \brief VTK-filter that wraps the topologicalCompressionWriter processing
 /// package.
+///
+/// In temporal mode, the successive calls to Write() compress a sequence of
+/// timesteps (one file each), each timestep being encoded relative to the
+/// previous one.
 
 #pragma once
 
@@ -59,6 +63,15 @@ public:
   vtkSetMacro(UseTopologicalSimplification, bool);
   vtkGetMacro(UseTopologicalSimplification, bool);
 
+  vtkSetMacro(BrickSize, int);
+  vtkGetMacro(BrickSize, int);
+
+  vtkSetMacro(TemporalMode, bool);
+  vtkGetMacro(TemporalMode, bool);
+
+  vtkSetMacro(KeyFrameInterval, int);
+  vtkGetMacro(KeyFrameInterval, int);
+
   inline void SetSQMethodPV(int c) {
     if(c == 1) {
       SetSQMethod("r");
@@ -0,0 +1 @@
+ttk_register_pv_filter(ttkPersistenceDiagramWriter PersistenceDiagramWriter.xml)